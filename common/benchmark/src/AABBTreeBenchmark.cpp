@@ -68,4 +68,33 @@ namespace TrenchBroom {
             }
         }, "Add objects to AABB tree");
     }
+
+    TEST_CASE("AABBTreeBenchmark.benchClearAndBuildTree", "[AABBTreeBenchmark]") {
+        const auto mapPath = IO::Disk::getCurrentWorkingDir() + IO::Path("fixture/benchmark/AABBTree/ne_ruins.map");
+        const auto file = IO::Disk::openFile(mapPath);
+        auto fileReader = file->reader().buffer();
+
+        IO::TestParserStatus status;
+        IO::WorldReader worldReader(fileReader.stringView(), Model::MapFormat::Standard);
+
+        const vm::bbox3 worldBounds(8192.0);
+        auto world = worldReader.read(worldBounds, status);
+
+        std::vector<Model::Node*> nodes;
+        world->accept(kdl::overload(
+            [] (auto&& thisLambda, Model::WorldNode* world_)  { world_->visitChildren(thisLambda); },
+            [] (auto&& thisLambda, Model::LayerNode* layer)   { layer->visitChildren(thisLambda); },
+            [] (auto&& thisLambda, Model::GroupNode* group)   { group->visitChildren(thisLambda); },
+            [&](auto&& thisLambda, Model::EntityNode* entity) { entity->visitChildren(thisLambda); nodes.push_back(entity); },
+            [&](Model::BrushNode* brush)                      { nodes.push_back(brush); },
+            [&](Model::PatchNode* patch)                      { nodes.push_back(patch); }
+        ));
+
+        std::vector<AABB> trees(100);
+        timeLambda([&nodes, &trees]() {
+            for (auto& tree : trees) {
+                tree.clearAndBuild(nodes, [](const Model::Node* node) { return node->physicalBounds(); });
+            }
+        }, "Build AABB tree from objects");
+    }
 }
@@ -46,7 +46,7 @@ namespace TrenchBroom {
         /**
          * Both returned vectors need to be freed with VecUtils::clearAndDelete
          */
-        static std::pair<std::vector<Model::BrushNode*>, std::vector<Assets::Texture*>> makeBrushes() {
+        static std::pair<std::vector<Model::BrushNode*>, std::vector<Assets::Texture*>> makeBrushes(const bool cacheVertices = true) {
             // make textures
             std::vector<Assets::Texture*> textures;
             for (size_t i = 0; i < NumTextures; ++i) {
@@ -74,10 +74,12 @@ namespace TrenchBroom {
             // we're not benchmarking that, so we don't
             // want it mixed into the timing
 
-            BrushRenderer tempRenderer;
-            tempRenderer.addBrushes(result);
-            tempRenderer.validate();
-            tempRenderer.clear();
+            if (cacheVertices) {
+                BrushRenderer tempRenderer;
+                tempRenderer.addBrushes(result);
+                tempRenderer.validate();
+                tempRenderer.clear();
+            }
 
             return {result, textures};
         }
@@ -129,6 +131,55 @@ namespace TrenchBroom {
             kdl::vec_clear_and_delete(brushes);
             kdl::vec_clear_and_delete(textures);
         }
+
+        TEST_CASE("BrushRendererBenchmark.benchFirstFrame", "[BrushRendererBenchmark]") {
+            // after loading a map, no brush has its vertices cached yet
+            auto brushesTextures = makeBrushes(false);
+            std::vector<Model::BrushNode*> brushes = brushesTextures.first;
+            std::vector<Assets::Texture*> textures = brushesTextures.second;
+
+            BrushRenderer r;
+            timeLambda([&](){
+                r.addBrushes(brushes);
+                r.validate();
+            }, "first frame with " + std::to_string(brushes.size()) + " uncached brushes");
+
+            kdl::vec_clear_and_delete(brushes);
+            kdl::vec_clear_and_delete(textures);
+        }
+
+        TEST_CASE("BrushRendererBenchmark.benchSelectionToggle", "[BrushRendererBenchmark]") {
+            auto brushesTextures = makeBrushes();
+            std::vector<Model::BrushNode*> brushes = brushesTextures.first;
+            std::vector<Assets::Texture*> textures = brushesTextures.second;
+
+            BrushRenderer r;
+            r.addBrushes(brushes);
+            r.validate();
+
+            // Selecting or deselecting brushes invalidates them in the brush renderers
+            const auto toggle = [&](const std::vector<Model::BrushNode*>& toggledBrushes, const std::string& message) {
+                timeLambda([&](){
+                    r.invalidateBrushes(toggledBrushes);
+                    if (!r.valid()) {
+                        r.validate();
+                    }
+                }, message);
+            };
+
+            const std::vector<Model::BrushNode*> oneBrush{brushes.at(brushes.size() / 2)};
+            toggle(oneBrush, "toggle selection of 1 brush");
+
+            // 1% of the brushes, spread across the entire map
+            std::vector<Model::BrushNode*> onePercent;
+            for (size_t i = 0; i < brushes.size(); i += 100) {
+                onePercent.push_back(brushes.at(i));
+            }
+            toggle(onePercent, "toggle selection of " + std::to_string(onePercent.size()) + " brushes (1%)");
+
+            kdl::vec_clear_and_delete(brushes);
+            kdl::vec_clear_and_delete(textures);
+        }
     }
 }
 
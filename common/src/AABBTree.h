@@ -21,14 +21,22 @@
 
 #include "Exceptions.h"
 
+#include <kdl/parallel.h>
+
 #include <vecmath/scalar.h>
 #include <vecmath/bbox.h>
 #include <vecmath/bbox_io.h>
 #include <vecmath/ray.h>
+#include <vecmath/plane.h>
 #include <vecmath/intersection.h>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <functional>
 #include <iosfwd>
+#include <iterator>
+#include <limits>
 #include <unordered_map>
 #include <vector>
 
@@ -40,6 +48,9 @@ namespace TrenchBroom {
  * @tparam S the number of dimensions for vector types
  * @tparam U the node data to store in the leafs
  */
+    template <typename T, size_t S, typename U>
+    class FlatAABBTree;
+
     template <typename T, size_t S, typename U>
     class AABBTree {
     public:
@@ -193,6 +204,20 @@ namespace TrenchBroom {
                 updateHeight();
             }
 
+            /**
+             * Returns the left child of this node.
+             */
+            const Node* left() const {
+                return m_left;
+            }
+
+            /**
+             * Returns the right child of this node.
+             */
+            const Node* right() const {
+                return m_right;
+            }
+
         private: // node removal private
             /**
              * Children (or grandchildren etc.) changed. Update the height and bounds.
@@ -464,6 +489,8 @@ namespace TrenchBroom {
     private:
         Node* m_root;
         std::unordered_map<U, LeafNode*> m_leafForData;
+
+        friend class FlatAABBTree<T,S,U>;
     public:
         AABBTree() : m_root(nullptr) {}
 
@@ -483,16 +510,48 @@ namespace TrenchBroom {
         }
 
         /**
-         * Clears this tree and rebuilds it by inserting given objects.
+         * Clears this tree and rebuilds it from the given objects.
+         *
+         * Unlike inserting the objects one by one, this builds the tree top down using a surface area heuristic, so
+         * the resulting tree does not depend on the order of the given objects and is usually better balanced. Large
+         * subtrees are built in parallel. Objects whose bounds are identical are ordered using std::less on their
+         * data.
          *
          * @param objects the objects to insert, a list of DataType
          * @param getBounds a function from DataType -> Box to compute the bounds of each object
+         *
+         * @throws NodeTreeException if the given objects contain duplicates, or the bounds of an object contain NaN
          */
         template <typename DataList, typename GetBounds>
         void clearAndBuild(const DataList& objects, GetBounds&& getBounds) {
             clear();
-            for (const U& object : objects) {
-                insert(getBounds(object), object);
+
+            std::vector<LeafNode*> leafs;
+            leafs.reserve(std::size(objects));
+
+            try {
+                for (const U& object : objects) {
+                    const Box bounds = getBounds(object);
+                    check(bounds);
+
+                    if (m_leafForData.find(object) != m_leafForData.end()) {
+                        throw NodeTreeException("Data already in tree");
+                    }
+
+                    auto* leaf = new LeafNode(bounds, object);
+                    leafs.push_back(leaf);
+                    m_leafForData[object] = leaf;
+                }
+            } catch (...) {
+                m_leafForData.clear();
+                for (auto* leaf : leafs) {
+                    delete leaf;
+                }
+                throw;
+            }
+
+            if (!leafs.empty()) {
+                m_root = buildSubtree(std::begin(leafs), std::end(leafs));
             }
         }
 
@@ -563,6 +622,188 @@ namespace TrenchBroom {
             insert(newBounds, data);
         }
     private:
+        using LeafIterator = typename std::vector<LeafNode*>::iterator;
+
+        /**
+         * Subtrees with at least this many leafs are built in parallel.
+         */
+        static constexpr size_t ParallelBuildThreshold = 4096;
+
+        /**
+         * Builds a subtree containing the given leafs top down. At each level, the leafs are split into two groups
+         * using a binned surface area heuristic, and the subtrees for both groups are built recursively.
+         *
+         * @param first the first leaf
+         * @param last the end of the leaf range
+         * @return the root of the new subtree
+         */
+        static Node* buildSubtree(LeafIterator first, LeafIterator last) {
+            const auto count = static_cast<size_t>(std::distance(first, last));
+            assert(count > 0);
+
+            if (count == 1) {
+                return *first;
+            }
+
+            const auto mid = partitionLeafs(first, last);
+
+            Node* left = nullptr;
+            Node* right = nullptr;
+            if (count >= ParallelBuildThreshold) {
+                kdl::parallel_for(2u, [&](const size_t i) {
+                    if (i == 0u) {
+                        left = buildSubtree(first, mid);
+                    } else {
+                        right = buildSubtree(mid, last);
+                    }
+                });
+            } else {
+                left = buildSubtree(first, mid);
+                right = buildSubtree(mid, last);
+            }
+
+            return new InnerNode(left, right);
+        }
+
+        /**
+         * Partitions the given leafs into two non empty groups such that the sum of the surface areas of the
+         * groups' bounds, weighted by the number of leafs in each group, is minimal among the candidate splits.
+         *
+         * The candidate splits are found by sorting the leaf centers into a fixed number of equally sized bins
+         * along each axis. If all leaf centers coincide, the leafs are sorted by their bounds and data and split
+         * into two halves.
+         *
+         * @param first the first leaf
+         * @param last the end of the leaf range
+         * @return an iterator to the first leaf of the second group
+         */
+        static LeafIterator partitionLeafs(LeafIterator first, LeafIterator last) {
+            constexpr size_t BinCount = 16;
+
+            auto centerMin = (*first)->bounds().center();
+            auto centerMax = centerMin;
+            for (auto it = std::next(first); it != last; ++it) {
+                const auto center = (*it)->bounds().center();
+                for (size_t i = 0; i < S; ++i) {
+                    centerMin[i] = std::min(centerMin[i], center[i]);
+                    centerMax[i] = std::max(centerMax[i], center[i]);
+                }
+            }
+
+            const auto binIndex = [&](const LeafNode* leaf, const size_t axis) {
+                const auto extent = centerMax[axis] - centerMin[axis];
+                const auto offset = (leaf->bounds().center()[axis] - centerMin[axis]) / extent;
+                return std::min(static_cast<size_t>(offset * static_cast<T>(BinCount)), BinCount - 1u);
+            };
+
+            auto bestCost = std::numeric_limits<T>::max();
+            auto bestAxis = S;
+            auto bestBin = size_t(0);
+
+            for (size_t axis = 0; axis < S; ++axis) {
+                if (centerMax[axis] <= centerMin[axis]) {
+                    continue;
+                }
+
+                std::array<Box, BinCount> binBounds;
+                std::array<size_t, BinCount> binCounts{};
+                for (auto it = first; it != last; ++it) {
+                    const auto bin = binIndex(*it, axis);
+                    binBounds[bin] = binCounts[bin] == 0u ? (*it)->bounds() : vm::merge(binBounds[bin], (*it)->bounds());
+                    ++binCounts[bin];
+                }
+
+                // sweep from the right to compute the area and leaf count right of each candidate split
+                std::array<T, BinCount> rightAreas{};
+                std::array<size_t, BinCount> rightCounts{};
+                Box rightBounds;
+                auto rightCount = size_t(0);
+                for (size_t bin = BinCount - 1u; bin > 0u; --bin) {
+                    if (binCounts[bin] > 0u) {
+                        rightBounds = rightCount == 0u ? binBounds[bin] : vm::merge(rightBounds, binBounds[bin]);
+                        rightCount += binCounts[bin];
+                    }
+                    rightAreas[bin] = rightCount > 0u ? surfaceArea(rightBounds) : static_cast<T>(0);
+                    rightCounts[bin] = rightCount;
+                }
+
+                // sweep from the left and evaluate the split between bin and bin + 1
+                Box leftBounds;
+                auto leftCount = size_t(0);
+                for (size_t bin = 0; bin < BinCount - 1u; ++bin) {
+                    if (binCounts[bin] > 0u) {
+                        leftBounds = leftCount == 0u ? binBounds[bin] : vm::merge(leftBounds, binBounds[bin]);
+                        leftCount += binCounts[bin];
+                    }
+
+                    if (leftCount > 0u && rightCounts[bin + 1u] > 0u) {
+                        const auto cost = surfaceArea(leftBounds) * static_cast<T>(leftCount)
+                                        + rightAreas[bin + 1u] * static_cast<T>(rightCounts[bin + 1u]);
+                        if (cost < bestCost) {
+                            bestCost = cost;
+                            bestAxis = axis;
+                            bestBin = bin;
+                        }
+                    }
+                }
+            }
+
+            if (bestAxis == S) {
+                // order the leafs by their bounds and data so that the split does not depend on the given order
+                std::sort(first, last, [](const LeafNode* lhs, const LeafNode* rhs) {
+                    for (size_t i = 0; i < S; ++i) {
+                        if (lhs->bounds().min[i] != rhs->bounds().min[i]) {
+                            return lhs->bounds().min[i] < rhs->bounds().min[i];
+                        }
+                    }
+                    for (size_t i = 0; i < S; ++i) {
+                        if (lhs->bounds().max[i] != rhs->bounds().max[i]) {
+                            return lhs->bounds().max[i] < rhs->bounds().max[i];
+                        }
+                    }
+                    return std::less<U>{}(lhs->data(), rhs->data());
+                });
+                return std::next(first, std::distance(first, last) / 2);
+            }
+
+            return std::partition(first, last, [&](const LeafNode* leaf) {
+                return binIndex(leaf, bestAxis) <= bestBin;
+            });
+        }
+
+        /**
+         * Returns the surface area of the given box. For boxes with fewer than three dimensions, this is the sum of
+         * the areas of the faces spanned by each pair of axes.
+         */
+        static T surfaceArea(const Box& bounds) {
+            const auto size = bounds.size();
+            auto result = static_cast<T>(0);
+            for (size_t i = 0; i < S; ++i) {
+                for (size_t j = i + 1u; j < S; ++j) {
+                    result += size[i] * size[j];
+                }
+            }
+            return static_cast<T>(2) * result;
+        }
+
+        /**
+         * Indicates whether the given box is not entirely above any of the given planes. For each plane, only the
+         * corner of the box which is farthest below the plane needs to be tested.
+         */
+        static bool intersectsVolume(const Box& bounds, const std::vector<vm::plane<T,S>>& planes) {
+            for (const auto& plane : planes) {
+                auto distance = -plane.distance;
+                for (size_t i = 0; i < S; ++i) {
+                    const auto corner = plane.normal[i] >= static_cast<T>(0) ? bounds.min[i] : bounds.max[i];
+                    distance += corner * plane.normal[i];
+                }
+                if (distance > static_cast<T>(0)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
         void check(const Box& bounds) const {
             if (vm::is_nan(bounds.min) || vm::is_nan(bounds.max)) {
                 throw NodeTreeException("Cannot add node to AABB tree with invalid bounds");
@@ -653,6 +894,91 @@ namespace TrenchBroom {
             }
         }
 
+        /**
+         * Finds every data item in this tree whose bounding box intersects with the given box and returns a list of
+         * those items. Boxes which only touch each other are considered to intersect.
+         *
+         * @param box the box to test
+         * @return a list containing all found data items
+         */
+        List findIntersectors(const Box& box) const {
+            List result;
+            findIntersectors(box, std::back_inserter(result));
+            return result;
+        }
+
+        /**
+         * Finds every data item in this tree whose bounding box intersects with the given box and appends it to the
+         * given output iterator.
+         *
+         * @tparam O the output iterator type
+         * @param box the box to test
+         * @param out the output iterator to append to
+         */
+        template <typename O>
+        void findIntersectors(const Box& box, O out) const {
+            if (!empty()) {
+                LambdaVisitor visitor(
+                    [&](const InnerNode* innerNode) {
+                        return innerNode->bounds().intersects(box);
+                    },
+                    [&](const LeafNode* leaf) {
+                        if (leaf->bounds().intersects(box)) {
+                            out = leaf->data();
+                            ++out;
+                        }
+                    }
+                );
+                m_root->accept(visitor);
+            }
+        }
+
+        /**
+         * Finds every data item in this tree whose bounding box intersects with the given convex volume and returns a
+         * list of those items.
+         *
+         * The volume is the intersection of the half spaces below the given planes, i.e., the plane normals point out
+         * of the volume. This is the case for the frustum planes of a camera. A bounding box is rejected if it is
+         * entirely above one of the planes, so some boxes which are close to the edges of the volume may be returned
+         * even if they do not intersect with it.
+         *
+         * @param planes the planes bounding the volume
+         * @return a list containing all found data items
+         */
+        List findIntersectorsOfVolume(const std::vector<vm::plane<T,S>>& planes) const {
+            List result;
+            findIntersectorsOfVolume(planes, std::back_inserter(result));
+            return result;
+        }
+
+        /**
+         * Finds every data item in this tree whose bounding box intersects with the given convex volume and appends it
+         * to the given output iterator.
+         *
+         * @see findIntersectorsOfVolume(const std::vector<vm::plane<T,S>>&)
+         *
+         * @tparam O the output iterator type
+         * @param planes the planes bounding the volume
+         * @param out the output iterator to append to
+         */
+        template <typename O>
+        void findIntersectorsOfVolume(const std::vector<vm::plane<T,S>>& planes, O out) const {
+            if (!empty()) {
+                LambdaVisitor visitor(
+                    [&](const InnerNode* innerNode) {
+                        return intersectsVolume(innerNode->bounds(), planes);
+                    },
+                    [&](const LeafNode* leaf) {
+                        if (intersectsVolume(leaf->bounds(), planes)) {
+                            out = leaf->data();
+                            ++out;
+                        }
+                    }
+                );
+                m_root->accept(visitor);
+            }
+        }
+
         /**
          * Finds every data item in this tree whose bounding box contains the given point and returns a list of those items.
          *
@@ -52,7 +52,8 @@ namespace TrenchBroom {
         m_name(name),
         m_bounds(bounds),
         m_pitchType(pitchType),
-        m_spacialTree(std::make_unique<SpacialTree>()) {}
+        m_spacialTree(std::make_unique<SpacialTree>()),
+        m_spacialTreeValid(true) {}
 
         EntityModelLoadedFrame::~EntityModelLoadedFrame() = default;
 
@@ -73,6 +74,8 @@ namespace TrenchBroom {
         }
 
         float EntityModelLoadedFrame::intersect(const vm::ray3f& ray) const {
+            validateSpacialTree();
+
             auto closestDistance = vm::nan<float>();
 
             const auto candidates = m_spacialTree->findIntersectors(ray);
@@ -87,6 +90,8 @@ namespace TrenchBroom {
         }
 
         void EntityModelLoadedFrame::addToSpacialTree(const std::vector<EntityModelVertex>& vertices, const Renderer::PrimType primType, const size_t index, const size_t count) {
+            m_spacialTreeValid = false;
+
             switch (primType) {
                 case Renderer::PrimType::Points:
                 case Renderer::PrimType::Lines:
@@ -97,19 +102,13 @@ namespace TrenchBroom {
                     assert(count % 3 == 0);
                     m_tris.reserve(m_tris.size() + count);
                     for (size_t i = 0; i < count; i += 3) {
-                        vm::bbox3f::builder bounds;
                         const auto& p1 = Renderer::getVertexComponent<0>(vertices[index + i + 0]);
                         const auto& p2 = Renderer::getVertexComponent<0>(vertices[index + i + 1]);
                         const auto& p3 = Renderer::getVertexComponent<0>(vertices[index + i + 2]);
-                        bounds.add(p1);
-                        bounds.add(p2);
-                        bounds.add(p3);
 
-                        const size_t triIndex = m_tris.size() / 3u;
                         m_tris.push_back(p1);
                         m_tris.push_back(p2);
                         m_tris.push_back(p3);
-                        m_spacialTree->insert(bounds.bounds(), triIndex);
                     }
                     break;
                 }
@@ -120,18 +119,12 @@ namespace TrenchBroom {
 
                     const auto& p1 = Renderer::getVertexComponent<0>(vertices[index]);
                     for (size_t i = 1; i < count - 1; ++i) {
-                        vm::bbox3f::builder bounds;
                         const auto& p2 = Renderer::getVertexComponent<0>(vertices[index + i]);
                         const auto& p3 = Renderer::getVertexComponent<0>(vertices[index + i + 1]);
-                        bounds.add(p1);
-                        bounds.add(p2);
-                        bounds.add(p3);
 
-                        const size_t triIndex = m_tris.size() / 3u;
                         m_tris.push_back(p1);
                         m_tris.push_back(p2);
                         m_tris.push_back(p3);
-                        m_spacialTree->insert(bounds.bounds(), triIndex);
                     }
                     break;
                 }
@@ -141,15 +134,10 @@ namespace TrenchBroom {
                     assert(count > 2);
                     m_tris.reserve(m_tris.size() + (count - 2) * 3);
                     for (size_t i = 0; i < count-2; ++i) {
-                        vm::bbox3f::builder bounds;
                         const auto& p1 = Renderer::getVertexComponent<0>(vertices[index + i + 0]);
                         const auto& p2 = Renderer::getVertexComponent<0>(vertices[index + i + 1]);
                         const auto& p3 = Renderer::getVertexComponent<0>(vertices[index + i + 2]);
-                        bounds.add(p1);
-                        bounds.add(p2);
-                        bounds.add(p3);
 
-                        const size_t triIndex = m_tris.size() / 3u;
                         if (i % 2 == 0) {
                             m_tris.push_back(p1);
                             m_tris.push_back(p2);
@@ -159,7 +147,6 @@ namespace TrenchBroom {
                             m_tris.push_back(p3);
                             m_tris.push_back(p2);
                         }
-                        m_spacialTree->insert(bounds.bounds(), triIndex);
                     }
                     break;
                 }
@@ -167,6 +154,25 @@ namespace TrenchBroom {
             }
         }
 
+        void EntityModelLoadedFrame::validateSpacialTree() const {
+            if (!m_spacialTreeValid) {
+                std::vector<TriNum> triNums;
+                triNums.reserve(m_tris.size() / 3u);
+                for (size_t i = 0; i < m_tris.size() / 3u; ++i) {
+                    triNums.push_back(i);
+                }
+
+                m_spacialTree->clearAndBuild(triNums, [&](const TriNum triNum) {
+                    vm::bbox3f::builder bounds;
+                    bounds.add(m_tris[triNum * 3 + 0]);
+                    bounds.add(m_tris[triNum * 3 + 1]);
+                    bounds.add(m_tris[triNum * 3 + 2]);
+                    return bounds.bounds();
+                });
+                m_spacialTreeValid = true;
+            }
+        }
+
         // EntityModel::UnloadedFrame
 
         /**
@@ -112,11 +112,12 @@ namespace TrenchBroom {
             vm::bbox3f m_bounds;
             PitchType m_pitchType;
 
-            // For hit testing
+            // For hit testing, the spacial tree is built from m_tris on demand
             std::vector<vm::vec3f> m_tris;
             using TriNum = size_t;
             using SpacialTree = AABBTree<float, 3, TriNum>;
-            std::unique_ptr<SpacialTree> m_spacialTree;
+            mutable std::unique_ptr<SpacialTree> m_spacialTree;
+            mutable bool m_spacialTreeValid;
         public:
             /**
              * Creates a new frame with the given index, name and bounds.
@@ -136,7 +137,8 @@ namespace TrenchBroom {
             float intersect(const vm::ray3f& ray) const override;
 
             /**
-             * Adds the given primitives to the spacial tree for this frame.
+             * Adds the given primitives to the spacial tree for this frame. The tree is rebuilt from all primitives
+             * when it is queried next.
              *
              * @param vertices the vertices
              * @param primType the primitive type
@@ -144,6 +146,8 @@ namespace TrenchBroom {
              * @param count the number of vertices that make up the primitive(s)
              */
             void addToSpacialTree(const std::vector<EntityModelVertex>& vertices, Renderer::PrimType primType, size_t index, size_t count);
+        private:
+            void validateSpacialTree() const;
         };
 
         class EntityModelUnloadedFrame;
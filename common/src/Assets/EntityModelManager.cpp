@@ -19,6 +19,7 @@
 
 #include "EntityModelManager.h"
 
+#include "BufferedLogger.h"
 #include "Exceptions.h"
 #include "Logger.h"
 #include "Macros.h"
@@ -28,6 +29,12 @@
 #include "Model/EntityNode.h"
 #include "Renderer/TexturedIndexRangeRenderer.h"
 
+#include <kdl/parallel.h>
+
+#include <optional>
+#include <string>
+#include <utility>
+
 namespace TrenchBroom {
     namespace Assets {
         EntityModelManager::EntityModelManager(const int magFilter, const int minFilter, Logger& logger) :
@@ -110,6 +117,66 @@ namespace TrenchBroom {
             }
         }
 
+        void EntityModelManager::loadModels(const std::vector<ModelSpecification>& specs) const {
+            ensure(m_loader != nullptr, "loader is null");
+
+            // group the specifications by the models they refer to, skipping models that were handled before
+            auto specsByPath = std::map<IO::Path, std::vector<ModelSpecification>>{};
+            for (const auto& spec : specs) {
+                if (!spec.path.isEmpty() && m_models.count(spec.path) == 0u && m_modelMismatches.count(spec.path) == 0u) {
+                    specsByPath[spec.path].push_back(spec);
+                }
+            }
+
+            if (specsByPath.empty()) {
+                return;
+            }
+
+            struct LoadResult {
+                IO::Path path;
+                std::unique_ptr<EntityModel> model;
+                std::optional<std::string> error;
+            };
+
+            auto logger = BufferedLogger(m_logger);
+            auto results = kdl::vec_parallel_transform(
+                std::vector<std::pair<IO::Path, std::vector<ModelSpecification>>>(std::begin(specsByPath), std::end(specsByPath)),
+                [&](std::pair<IO::Path, std::vector<ModelSpecification>>&& pathAndSpecs) {
+                    auto& [path, pathSpecs] = pathAndSpecs;
+                    try {
+                        auto model = m_loader->initializeModel(path, logger);
+                        for (const auto& spec : pathSpecs) {
+                            if (model != nullptr && spec.frameIndex < model->frameCount() && !model->frame(spec.frameIndex)->loaded()) {
+                                try {
+                                    m_loader->loadFrame(spec.path, spec.frameIndex, *model, logger);
+                                } catch (const Exception& e) {
+                                    logger.error() << "Could not load entity model frame " << spec << ": " << e.what();
+                                }
+                            }
+                        }
+                        return LoadResult{std::move(path), std::move(model), std::nullopt};
+                    } catch (const GameException& e) {
+                        return LoadResult{std::move(path), nullptr, std::string(e.what())};
+                    }
+                });
+            logger.flush();
+
+            for (auto& result : results) {
+                if (result.error) {
+                    m_logger.error() << *result.error;
+                    m_modelMismatches.insert(result.path);
+                } else {
+                    const auto [pos, success] = m_models.insert({ result.path, std::move(result.model) });
+                    assert(success); unused(success);
+
+                    if (auto* model = pos->second.get()) {
+                        m_unpreparedModels.push_back(model);
+                    }
+                    m_logger.debug() << "Loaded entity model " << result.path;
+                }
+            }
+        }
+
         EntityModel* EntityModelManager::model(const IO::Path& path) const {
             if (path.isEmpty()) {
                 return nullptr;
@@ -83,6 +83,17 @@ namespace TrenchBroom {
             Renderer::TexturedRenderer* renderer(const ModelSpecification& spec) const;
 
             const EntityModelFrame* frame(const ModelSpecification& spec) const;
+
+            /**
+             * Loads the models and frames referenced by the given specifications in parallel, so that subsequent
+             * calls to `frame` and `renderer` do not need to load them one by one. Models which have already been
+             * loaded or which could not be loaded before are skipped.
+             *
+             * The loader must be safe to use from multiple threads at once.
+             *
+             * @param specs the model specifications to load
+             */
+            void loadModels(const std::vector<ModelSpecification>& specs) const;
         private:
             EntityModel* model(const IO::Path& path) const;
             EntityModel* safeGetModel(const IO::Path& path) const;
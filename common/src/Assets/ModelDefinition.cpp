@@ -28,7 +28,12 @@
 
 #include <vecmath/scalar.h>
 
+#include <map>
+#include <mutex>
 #include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Assets {
@@ -82,14 +87,47 @@ namespace TrenchBroom {
             return stream;
         }
 
+        struct ModelDefinition::Cache {
+            using Key = std::vector<std::pair<EL::ValueType, std::string>>;
+
+            /**
+             * Limits the memory used by expressions that refer to variables with many distinct values, e.g. names.
+             */
+            static constexpr size_t MaxSize = 4096u;
+
+            std::vector<std::string> variableNames;
+            std::mutex mutex;
+            std::map<Key, ModelSpecification> specifications;
+
+            explicit Cache(const EL::Expression& expression) :
+            variableNames(expression.variableNames()) {}
+
+            Key makeKey(const EL::VariableStore& variableStore) const {
+                auto key = Key();
+                key.reserve(variableNames.size());
+                for (const auto& variableName : variableNames) {
+                    const auto value = variableStore.value(variableName);
+                    if (value.type() == EL::ValueType::String) {
+                        key.emplace_back(value.type(), value.stringValue());
+                    } else {
+                        key.emplace_back(value.type(), value.asString());
+                    }
+                }
+                return key;
+            }
+        };
+
         ModelDefinition::ModelDefinition() :
-        m_expression(EL::LiteralExpression(EL::Value::Undefined), 0, 0) {}
+        m_expression(EL::LiteralExpression(EL::Value::Undefined), 0, 0),
+        m_cache(std::make_shared<Cache>(m_expression)) {}
 
         ModelDefinition::ModelDefinition(const size_t line, const size_t column) :
-        m_expression(EL::LiteralExpression(EL::Value::Undefined), line, column) {}
+        m_expression(EL::LiteralExpression(EL::Value::Undefined), line, column),
+        m_cache(std::make_shared<Cache>(m_expression)) {}
 
         ModelDefinition::ModelDefinition(const EL::Expression& expression) :
-        m_expression(expression) {}
+        m_expression(expression),
+        m_cache(std::make_shared<Cache>(m_expression)) {}
 
         bool operator==(const ModelDefinition& lhs, const ModelDefinition& rhs) {
             return lhs.m_expression.asString() == rhs.m_expression.asString();
@@ -112,11 +150,27 @@ namespace TrenchBroom {
             const size_t line = m_expression.line();
             const size_t column = m_expression.column();
             m_expression = EL::Expression(EL::SwitchExpression(std::move(cases)), line, column);
+            m_cache = std::make_shared<Cache>(m_expression);
         }
 
         ModelSpecification ModelDefinition::modelSpecification(const EL::VariableStore& variableStore) const {
+            auto key = m_cache->makeKey(variableStore);
+            {
+                std::lock_guard<std::mutex> lock(m_cache->mutex);
+                if (const auto it = m_cache->specifications.find(key); it != std::end(m_cache->specifications)) {
+                    return it->second;
+                }
+            }
+
             const EL::EvaluationContext context(variableStore);
-            return convertToModel(m_expression.evaluate(context));
+            auto result = convertToModel(m_expression.evaluate(context));
+
+            std::lock_guard<std::mutex> lock(m_cache->mutex);
+            if (m_cache->specifications.size() >= Cache::MaxSize) {
+                m_cache->specifications.clear();
+            }
+            m_cache->specifications.emplace(std::move(key), result);
+            return result;
         }
 
         ModelSpecification ModelDefinition::defaultModelSpecification() const {
@@ -23,6 +23,7 @@
 #include "IO/Path.h"
 
 #include <iosfwd>
+#include <memory>
 
 namespace TrenchBroom {
     namespace Assets {
@@ -47,7 +48,14 @@ namespace TrenchBroom {
 
         class ModelDefinition {
         private:
+            struct Cache;
+
             EL::Expression m_expression;
+            /**
+             * Caches the model specifications by the values of the variables that the expression refers to. Copies of
+             * this definition share the cache since they have the same expression.
+             */
+            std::shared_ptr<Cache> m_cache;
         public:
             ModelDefinition();
             ModelDefinition(size_t line, size_t column);
@@ -62,6 +70,9 @@ namespace TrenchBroom {
             /**
              * Evaluates the model expresion, using the given variable store to interpolate variables.
              *
+             * The result is cached by the values of the variables that the expression refers to, so the expression is
+             * only evaluated once for each distinct combination of values.
+             *
              * @param variableStore the variable store to use when interpolating variables
              * @return the model specification
              *
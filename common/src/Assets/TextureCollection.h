@@ -23,6 +23,7 @@
 #include "IO/Path.h"
 #include "Renderer/GL.h"
 
+#include <chrono>
 #include <string>
 #include <vector>
 
@@ -37,6 +38,7 @@ namespace TrenchBroom {
             std::vector<Texture> m_textures;
 
             TextureIdList m_textureIds;
+            size_t m_preparedCount;
 
             friend class Texture;
         public:
@@ -69,6 +71,14 @@ namespace TrenchBroom {
 
             bool prepared() const;
             void prepare(int minFilter, int magFilter);
+
+            /**
+             * Uploads the textures of this collection which have not been uploaded yet until the given deadline has
+             * passed. At least one texture is uploaded per call.
+             *
+             * @return true if all textures of this collection have been uploaded
+             */
+            bool prepare(int minFilter, int magFilter, std::chrono::steady_clock::time_point deadline);
             void setTextureMode(int minFilter, int magFilter);
         };
     }
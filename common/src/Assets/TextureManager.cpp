@@ -37,6 +37,9 @@
 
 namespace TrenchBroom {
     namespace Assets {
+        // The time that one call to commitChanges may spend uploading textures without noticeably dropping frames.
+        static constexpr auto PrepareTimeBudget = std::chrono::milliseconds(8);
+
         class CompareByName {
         public:
             CompareByName() {}
@@ -137,6 +140,10 @@ namespace TrenchBroom {
             m_toRemove.clear();
         }
 
+        bool TextureManager::hasPendingChanges() const {
+            return !m_toPrepare.empty();
+        }
+
         const Texture* TextureManager::texture(const std::string& name) const {
             auto it = m_texturesByName.find(kdl::str_to_lower(name));
             if (it == std::end(m_texturesByName)) {
@@ -168,11 +175,17 @@ namespace TrenchBroom {
         }
 
         void TextureManager::prepare() {
-            for (const size_t index : m_toPrepare) {
-                auto& collection = m_collections[index];
-                collection.prepare(m_minFilter, m_magFilter);
+            const auto deadline = std::chrono::steady_clock::now() + PrepareTimeBudget;
+
+            auto it = std::begin(m_toPrepare);
+            while (it != std::end(m_toPrepare) && std::chrono::steady_clock::now() < deadline) {
+                auto& collection = m_collections[*it];
+                if (!collection.prepare(m_minFilter, m_magFilter, deadline)) {
+                    break;
+                }
+                ++it;
             }
-            m_toPrepare.clear();
+            m_toPrepare.erase(std::begin(m_toPrepare), it);
         }
 
         void TextureManager::updateTextures() {
@@ -66,8 +66,23 @@ namespace TrenchBroom {
             void clear();
 
             void setTextureMode(int minFilter, int magFilter);
+
+            /**
+             * Applies pending texture mode changes and uploads textures that have not been uploaded yet. To keep the
+             * editor responsive while large texture collections are being uploaded, uploading stops once a small time
+             * budget is exhausted, and the remaining textures are uploaded by subsequent calls. Textures which have not
+             * been uploaded yet are rendered using their average color.
+             *
+             * Must be called while an OpenGL context is current.
+             */
             void commitChanges();
 
+            /**
+             * Indicates whether there are textures which have not been uploaded yet, i.e., whether `commitChanges`
+             * should be called again, usually when the next frame is rendered.
+             */
+            bool hasPendingChanges() const;
+
             const Texture* texture(const std::string& name) const;
             Texture* texture(const std::string& name);
             
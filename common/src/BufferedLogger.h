@@ -0,0 +1,54 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Logger.h"
+
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace TrenchBroom {
+    /**
+     * A logger that records messages instead of logging them. The recorded messages are passed on to the target logger
+     * when `flush` is called.
+     *
+     * Messages can be logged from any thread, which makes this logger suitable for code that runs on worker threads
+     * while the target logger, e.g. the console, may only be used from the main thread. `flush` must only be called on
+     * the thread that is allowed to use the target logger.
+     */
+    class BufferedLogger : public Logger {
+    private:
+        Logger& m_target;
+        std::mutex m_mutex;
+        std::vector<std::tuple<LogLevel, std::string>> m_messages;
+    public:
+        explicit BufferedLogger(Logger& target);
+
+        /**
+         * Logs all recorded messages to the target logger in the order in which they were recorded.
+         */
+        void flush();
+    private:
+        void doLog(LogLevel level, const std::string& message) override;
+        void doLog(LogLevel level, const QString& message) override;
+    };
+}
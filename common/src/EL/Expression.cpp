@@ -121,6 +121,19 @@ namespace TrenchBroom {
             }
         }
 
+        std::vector<std::string> Expression::variableNames() const {
+            auto result = std::vector<std::string>();
+            appendVariableNames(result);
+
+            std::sort(std::begin(result), std::end(result));
+            result.erase(std::unique(std::begin(result), std::end(result)), std::end(result));
+            return result;
+        }
+
+        void Expression::appendVariableNames(std::vector<std::string>& result) const {
+            std::visit([&](const auto& e) { e.appendVariableNames(result); }, *m_expression);
+        }
+
         size_t Expression::line() const {
             return m_line;
         }
@@ -196,6 +209,8 @@ namespace TrenchBroom {
         const Value& LiteralExpression::evaluate(const EvaluationContext&) const {
             return m_value;
         }
+
+        void LiteralExpression::appendVariableNames(std::vector<std::string>& /* result */) const {}
         
         std::ostream& operator<<(std::ostream& str, const LiteralExpression& exp) {
             str << exp.m_value;
@@ -208,6 +223,10 @@ namespace TrenchBroom {
         Value VariableExpression::evaluate(const EvaluationContext& context) const {
             return context.variableValue(m_variableName);
         }
+
+        void VariableExpression::appendVariableNames(std::vector<std::string>& result) const {
+            result.push_back(m_variableName);
+        }
         
         std::ostream& operator<<(std::ostream& str, const VariableExpression& exp) {
             str << exp.m_variableName;
@@ -237,6 +256,12 @@ namespace TrenchBroom {
             
             return Value(std::move(array));
         }
+
+        void ArrayExpression::appendVariableNames(std::vector<std::string>& result) const {
+            for (const auto& element : m_elements) {
+                element.appendVariableNames(result);
+            }
+        }
         
         std::optional<LiteralExpression> ArrayExpression::optimize() {
             bool allOptimized = true;
@@ -276,6 +301,12 @@ namespace TrenchBroom {
 
             return Value(std::move(map));
         }
+
+        void MapExpression::appendVariableNames(std::vector<std::string>& result) const {
+            for (const auto& [key, expression] : m_elements) {
+                expression.appendVariableNames(result);
+            }
+        }
         
         std::optional<LiteralExpression> MapExpression::optimize() {
             bool allOptimized = true;
@@ -324,6 +355,10 @@ namespace TrenchBroom {
                 switchDefault();
             }
         }
+
+        void UnaryExpression::appendVariableNames(std::vector<std::string>& result) const {
+            m_operand.appendVariableNames(result);
+        }
         
         std::optional<LiteralExpression> UnaryExpression::optimize() {
             if (m_operand.optimize()) {
@@ -444,15 +479,25 @@ namespace TrenchBroom {
                 switchDefault();
             };
         }
+
+        void BinaryExpression::appendVariableNames(std::vector<std::string>& result) const {
+            m_leftOperand.appendVariableNames(result);
+            m_rightOperand.appendVariableNames(result);
+        }
         
         std::optional<LiteralExpression> BinaryExpression::optimize() {
             const auto leftOptimized = m_leftOperand.optimize();
             const auto rightOptimized = m_rightOperand.optimize();
             if (leftOptimized && rightOptimized) {
                 return LiteralExpression(evaluate(EvaluationContext()));
-            } else {
-                return std::nullopt;
+            } else if (leftOptimized && m_operator == BinaryOperator::Case) {
+                // a case whose condition is constantly false never yields a value
+                const auto leftValue = m_leftOperand.evaluate(EvaluationContext());
+                if (leftValue.convertibleTo(ValueType::Boolean) && !leftValue.convertTo(ValueType::Boolean)) {
+                    return LiteralExpression(Value::Undefined);
+                }
             }
+            return std::nullopt;
         }
 
         size_t BinaryExpression::precedence() const {
@@ -578,6 +623,19 @@ namespace TrenchBroom {
             const auto rightValue = m_rightOperand.evaluate(stack);
             return leftValue[rightValue];
         }
+
+        void SubscriptExpression::appendVariableNames(std::vector<std::string>& result) const {
+            m_leftOperand.appendVariableNames(result);
+
+            // the auto range parameter is declared by this expression
+            auto rightVariableNames = std::vector<std::string>();
+            m_rightOperand.appendVariableNames(rightVariableNames);
+            for (auto& variableName : rightVariableNames) {
+                if (variableName != AutoRangeParameterName()) {
+                    result.push_back(std::move(variableName));
+                }
+            }
+        }
         
         std::optional<LiteralExpression> SubscriptExpression::optimize() {
             if (m_leftOperand.optimize() && m_rightOperand.optimize()) {
@@ -604,20 +662,40 @@ namespace TrenchBroom {
             }
             return Value::Undefined;
         }
+
+        void SwitchExpression::appendVariableNames(std::vector<std::string>& result) const {
+            for (const auto& case_ : m_cases) {
+                case_.appendVariableNames(result);
+            }
+        }
         
         std::optional<LiteralExpression> SwitchExpression::optimize() {
-            bool allOptimized = true;
-            
+            auto cases = std::vector<Expression>();
+            cases.reserve(m_cases.size());
+
             for (auto& case_ : m_cases) {
-                allOptimized &= case_.optimize();
-                if (allOptimized) {
+                if (case_.optimize()) {
                     auto result = case_.evaluate(EvaluationContext());
-                    if (!result.undefined()) {
+                    if (result.undefined()) {
+                        // this case can never match, so it can be dropped
+                        continue;
+                    }
+                    if (cases.empty()) {
                         return LiteralExpression(std::move(result));
                     }
+
+                    // this case always matches, so any following cases can be dropped
+                    cases.push_back(std::move(case_));
+                    break;
                 }
+                cases.push_back(std::move(case_));
             }
-            
+
+            if (cases.empty()) {
+                return LiteralExpression(Value::Undefined);
+            }
+
+            m_cases = std::move(cases);
             return std::nullopt;
         }
 
@@ -75,6 +75,14 @@ namespace TrenchBroom {
             Value evaluate(const EvaluationContext& context) const;
             bool optimize();
 
+            /**
+             * Returns the names of the variables whose values this expression reads from the evaluation context, in
+             * lexicographical order and without duplicates. Variables that the expression declares itself are not
+             * included.
+             */
+            std::vector<std::string> variableNames() const;
+            void appendVariableNames(std::vector<std::string>& result) const;
+
             size_t line() const;
             size_t column() const;
 
@@ -93,6 +101,7 @@ namespace TrenchBroom {
             LiteralExpression(Value value);
             
             const Value& evaluate(const EvaluationContext& context) const;
+            void appendVariableNames(std::vector<std::string>& result) const;
             
             friend std::ostream& operator<<(std::ostream& str, const LiteralExpression& exp);
         };
@@ -104,6 +113,7 @@ namespace TrenchBroom {
             VariableExpression(std::string variableName);
             
             Value evaluate(const EvaluationContext& context) const;
+            void appendVariableNames(std::vector<std::string>& result) const;
             
             friend std::ostream& operator<<(std::ostream& str, const VariableExpression& exp);
         };
@@ -115,6 +125,7 @@ namespace TrenchBroom {
             ArrayExpression(std::vector<Expression> elements);
             
             Value evaluate(const EvaluationContext& context) const;
+            void appendVariableNames(std::vector<std::string>& result) const;
             std::optional<LiteralExpression> optimize();
             
             friend std::ostream& operator<<(std::ostream& str, const ArrayExpression& exp);
@@ -127,6 +138,7 @@ namespace TrenchBroom {
             MapExpression(std::map<std::string, Expression> elements);
 
             Value evaluate(const EvaluationContext& context) const;
+            void appendVariableNames(std::vector<std::string>& result) const;
             std::optional<LiteralExpression> optimize();
             
             friend std::ostream& operator<<(std::ostream& str, const MapExpression& exp);
@@ -148,6 +160,7 @@ namespace TrenchBroom {
             UnaryExpression(UnaryOperator i_operator, Expression operand);
 
             Value evaluate(const EvaluationContext& context) const;
+            void appendVariableNames(std::vector<std::string>& result) const;
             std::optional<LiteralExpression> optimize();
             
             friend std::ostream& operator<<(std::ostream& str, const UnaryExpression& exp);
@@ -189,6 +202,7 @@ namespace TrenchBroom {
             static Expression createAutoRangeWithLeftOperand(Expression leftOperand, size_t line, size_t column);
 
             Value evaluate(const EvaluationContext& context) const;
+            void appendVariableNames(std::vector<std::string>& result) const;
             std::optional<LiteralExpression> optimize();
             
             size_t precedence() const;
@@ -206,6 +220,7 @@ namespace TrenchBroom {
             SubscriptExpression(Expression leftOperand, Expression rightOperand);
             
             Value evaluate(const EvaluationContext& context) const;
+            void appendVariableNames(std::vector<std::string>& result) const;
             std::optional<LiteralExpression> optimize();
             
             friend std::ostream& operator<<(std::ostream& str, const SubscriptExpression& exp);
@@ -218,6 +233,7 @@ namespace TrenchBroom {
             SwitchExpression(std::vector<Expression> cases);
 
             Value evaluate(const EvaluationContext& context) const;
+            void appendVariableNames(std::vector<std::string>& result) const;
             std::optional<LiteralExpression> optimize();
             
             friend std::ostream& operator<<(std::ostream& str, const SwitchExpression& exp);
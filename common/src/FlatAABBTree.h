@@ -0,0 +1,303 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "AABBTree.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/ray.h>
+#include <vecmath/scalar.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom {
+    /**
+     * An immutable snapshot of an AABB tree that is laid out for fast queries.
+     *
+     * The nodes are stored in contiguous arrays in depth first order, so the left child of an inner node is always
+     * the node following it. For each node, only the index of the first node after its subtree is stored, which is
+     * where a traversal continues if the node's bounds are rejected. The node bounds are stored per component in
+     * separate arrays.
+     *
+     * Queries are simple loops over these arrays and do not require any virtual calls, recursion or pointer chasing.
+     * The snapshot does not reflect any changes made to the original tree after it was created.
+     *
+     * @tparam T the floating point type
+     * @tparam S the number of dimensions for vector types
+     * @tparam U the node data to store in the leafs, must be default constructible
+     */
+    template <typename T, size_t S, typename U>
+    class FlatAABBTree {
+    public:
+        using Tree = AABBTree<T,S,U>;
+        using List = std::vector<U>;
+        using Box = vm::bbox<T,S>;
+        using DataType = U;
+        using FloatType = T;
+        static constexpr size_t Components = S;
+    private:
+        std::array<std::vector<T>, S> m_min;
+        std::array<std::vector<T>, S> m_max;
+        std::vector<size_t> m_next;
+        std::vector<U> m_data;
+    public:
+        /**
+         * Creates an empty tree.
+         */
+        FlatAABBTree() = default;
+
+        /**
+         * Creates a snapshot of the given tree.
+         *
+         * @param tree the tree to copy
+         */
+        explicit FlatAABBTree(const Tree& tree) {
+            if (!tree.empty()) {
+                const auto nodeCount = 2u * tree.m_leafForData.size() - 1u;
+                for (size_t i = 0; i < S; ++i) {
+                    m_min[i].reserve(nodeCount);
+                    m_max[i].reserve(nodeCount);
+                }
+                m_next.reserve(nodeCount);
+                m_data.reserve(nodeCount);
+
+                addNode(tree.m_root);
+            }
+        }
+
+        /**
+         * Indicates whether this tree is empty.
+         */
+        bool empty() const {
+            return m_next.empty();
+        }
+
+        /**
+         * Returns the number of inner nodes and leafs in this tree.
+         */
+        size_t nodeCount() const {
+            return m_next.size();
+        }
+
+        /**
+         * Finds every data item in this tree whose bounding box intersects with the given ray and retuns a list of those items.
+         *
+         * @param ray the ray to test
+         * @return a list containing all found data items
+         */
+        List findIntersectors(const vm::ray<T,S>& ray) const {
+            List result;
+            findIntersectors(ray, std::back_inserter(result));
+            return result;
+        }
+
+        /**
+         * Finds every data item in this tree whose bounding box intersects with the given ray and appends it to the given
+         * output iterator.
+         *
+         * @tparam O the output iterator type
+         * @param ray the ray to test
+         * @param out the output iterator to append to
+         */
+        template <typename O>
+        void findIntersectors(const vm::ray<T,S>& ray, O out) const {
+            const auto invDirection = invert(ray.direction);
+            visit([&](const size_t index) { return !vm::is_nan(intersect(index, ray, invDirection)); }, out);
+        }
+
+        /**
+         * Finds the data items whose bounding boxes intersect with the given ray in order of the distance at which the
+         * ray enters their bounding boxes, and passes each item and that distance to the given function. If the ray
+         * origin is contained in a bounding box, the distance is 0.
+         *
+         * The traversal stops early if the given function returns false. Since the bounds of a node contain the bounds
+         * of all of its descendants, no item that was not yet visited can have a smaller entry distance than the last
+         * visited item.
+         *
+         * @tparam F the type of the function to call, must be of type `bool(const U&, T)`
+         * @param ray the ray to test
+         * @param f the function to call
+         */
+        template <typename F>
+        void findIntersectorsByDistance(const vm::ray<T,S>& ray, F&& f) const {
+            if (empty()) {
+                return;
+            }
+
+            const auto invDirection = invert(ray.direction);
+
+            using Entry = std::pair<T, size_t>;
+            auto queue = std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>>();
+
+            const auto push = [&](const size_t index) {
+                const auto distance = intersect(index, ray, invDirection);
+                if (!vm::is_nan(distance)) {
+                    queue.emplace(distance, index);
+                }
+            };
+
+            push(0u);
+            while (!queue.empty()) {
+                const auto [distance, index] = queue.top();
+                queue.pop();
+
+                if (isLeaf(index)) {
+                    if (!f(m_data[index], distance)) {
+                        return;
+                    }
+                } else {
+                    // the left child directly follows its parent, and the right child follows the left subtree
+                    const auto left = index + 1u;
+                    push(left);
+                    push(m_next[left]);
+                }
+            }
+        }
+
+        /**
+         * Finds every data item in this tree whose bounding box contains the given point and returns a list of those items.
+         *
+         * @param point the point to test
+         * @return a list containing all found data items
+         */
+        List findContainers(const vm::vec<T,S>& point) const {
+            List result;
+            findContainers(point, std::back_inserter(result));
+            return result;
+        }
+
+        /**
+         * Finds every data item in this tree whose bounding box contains the given point and appends it to the given
+         * output iterator.
+         *
+         * @tparam O the output iterator type
+         * @param point the point to test
+         * @param out the output iterator to append to
+         */
+        template <typename O>
+        void findContainers(const vm::vec<T,S>& point, O out) const {
+            visit([&](const size_t index) { return contains(index, point); }, out);
+        }
+    private:
+        void addNode(const typename Tree::Node* node) {
+            const auto index = m_next.size();
+
+            const auto& bounds = node->bounds();
+            for (size_t i = 0; i < S; ++i) {
+                m_min[i].push_back(bounds.min[i]);
+                m_max[i].push_back(bounds.max[i]);
+            }
+            m_next.push_back(0u);
+            m_data.emplace_back();
+
+            const auto visitInnerNode = [&](const typename Tree::InnerNode* innerNode) {
+                addNode(innerNode->left());
+                addNode(innerNode->right());
+                return false;
+            };
+            const auto visitLeafNode = [&](const typename Tree::LeafNode* leafNode) {
+                m_data[index] = leafNode->data();
+            };
+
+            using Visitor = typename Tree::template LambdaVisitor<decltype(visitInnerNode), decltype(visitLeafNode)>;
+            auto visitor = Visitor(visitInnerNode, visitLeafNode);
+            node->accept(visitor);
+
+            m_next[index] = m_next.size();
+        }
+
+        /**
+         * Visits the nodes in depth first order, skipping the subtrees of nodes that the given test rejects, and
+         * appends the data of every accepted leaf to the given output iterator.
+         */
+        template <typename Test, typename O>
+        void visit(const Test& test, O& out) const {
+            const auto count = m_next.size();
+            auto index = size_t(0);
+            while (index < count) {
+                if (test(index)) {
+                    if (isLeaf(index)) {
+                        out = m_data[index];
+                        ++out;
+                    }
+                    ++index;
+                } else {
+                    index = m_next[index];
+                }
+            }
+        }
+
+        bool isLeaf(const size_t index) const {
+            // a leaf's subtree contains only the leaf itself
+            return m_next[index] == index + 1u;
+        }
+
+        static std::array<T,S> invert(const vm::vec<T,S>& direction) {
+            std::array<T,S> result;
+            for (size_t i = 0; i < S; ++i) {
+                result[i] = static_cast<T>(1) / direction[i];
+            }
+            return result;
+        }
+
+        /**
+         * Returns the distance at which the given ray enters the bounds of the node with the given index, 0 if the
+         * ray origin is contained in the bounds, or NaN if the ray misses the bounds.
+         */
+        T intersect(const size_t index, const vm::ray<T,S>& ray, const std::array<T,S>& invDirection) const {
+            auto tNear = static_cast<T>(0);
+            auto tFar = std::numeric_limits<T>::max();
+            for (size_t i = 0; i < S; ++i) {
+                const auto origin = ray.origin[i];
+                if (ray.direction[i] == static_cast<T>(0)) {
+                    if (origin < m_min[i][index] || origin > m_max[i][index]) {
+                        return vm::nan<T>();
+                    }
+                } else {
+                    const auto t1 = (m_min[i][index] - origin) * invDirection[i];
+                    const auto t2 = (m_max[i][index] - origin) * invDirection[i];
+                    tNear = std::max(tNear, std::min(t1, t2));
+                    tFar = std::min(tFar, std::max(t1, t2));
+                    if (tNear > tFar) {
+                        return vm::nan<T>();
+                    }
+                }
+            }
+            return tNear;
+        }
+
+        bool contains(const size_t index, const vm::vec<T,S>& point) const {
+            for (size_t i = 0; i < S; ++i) {
+                if (point[i] < m_min[i][index] || point[i] > m_max[i][index]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+}
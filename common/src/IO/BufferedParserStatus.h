@@ -0,0 +1,54 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "IO/ParserStatus.h"
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        /**
+         * A parser status that records messages instead of logging them. The recorded messages are passed on to the
+         * target status when `flush` is called, e.g. to log the messages of a parser that ran on a worker thread in a
+         * deterministic order.
+         *
+         * Messages are formatted using the prefix of the target status, so flushing them produces exactly the same
+         * output as logging them to the target status directly. Progress reports are discarded.
+         */
+        class BufferedParserStatus : public ParserStatus {
+        private:
+            ParserStatus& m_target;
+            std::vector<std::tuple<LogLevel, std::string>> m_messages;
+        public:
+            explicit BufferedParserStatus(ParserStatus& target);
+
+            /**
+             * Logs all recorded messages to the target status in the order in which they were recorded.
+             */
+            void flush();
+        private:
+            void doProgress(double progress) override;
+            void doLog(LogLevel level, const std::string& str) override;
+        };
+    }
+}
@@ -0,0 +1,156 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DirectoryIndex.h"
+
+#include "Exceptions.h"
+#include "IO/DiskIO.h"
+#include "IO/PathQt.h"
+
+#include <kdl/string_format.h>
+
+#include <algorithm>
+#include <mutex>
+
+#include <QDir>
+#include <QFileInfo>
+
+namespace TrenchBroom {
+    namespace IO {
+        DirectoryIndex::DirectoryIndex(Path root) :
+        m_root(std::move(root)) {}
+
+        const Path& DirectoryIndex::root() const {
+            return m_root;
+        }
+
+        std::optional<DirectoryIndex::Item> DirectoryIndex::find(const Path& path) const {
+            auto lock = SharedLock(m_mutex);
+
+            auto actualPath = Path("");
+            if (path.isEmpty()) {
+                if (getDirectory(actualPath, lock).exists) {
+                    return Item{actualPath, true};
+                }
+                return std::nullopt;
+            }
+
+            const auto* directory = findDirectory(path.deleteLastComponent(), actualPath, lock);
+            if (directory == nullptr) {
+                return std::nullopt;
+            }
+
+            const auto& name = path.lastComponent().asString();
+            const auto [begin, end] = directory->entries.equal_range(kdl::str_to_lower(name));
+            if (begin == end) {
+                return std::nullopt;
+            }
+
+            auto it = std::find_if(begin, end, [&](const auto& entry) { return entry.second.name == name; });
+            if (it == end) {
+                it = begin;
+            }
+            return Item{actualPath + Path(it->second.name), it->second.directory};
+        }
+
+        std::optional<std::vector<Path>> DirectoryIndex::getDirectoryContents(const Path& path) const {
+            auto lock = SharedLock(m_mutex);
+
+            auto actualPath = Path("");
+            const auto* directory = findDirectory(path, actualPath, lock);
+            if (directory == nullptr) {
+                return std::nullopt;
+            }
+
+            auto result = std::vector<Path>();
+            result.reserve(directory->entries.size());
+            for (const auto& [key, entry] : directory->entries) {
+                result.push_back(Path(entry.name));
+            }
+            return result;
+        }
+
+        void DirectoryIndex::invalidate() {
+            std::unique_lock<std::shared_mutex> lock(m_mutex);
+            m_directories.clear();
+        }
+
+        const DirectoryIndex::Directory* DirectoryIndex::findDirectory(const Path& path, Path& actualPath, SharedLock& lock) const {
+            const auto* directory = &getDirectory(actualPath, lock);
+            for (const auto& component : path.components()) {
+                if (!directory->exists) {
+                    return nullptr;
+                }
+
+                const auto [begin, end] = directory->entries.equal_range(kdl::str_to_lower(component));
+                auto it = std::find_if(begin, end, [&](const auto& entry) { return entry.second.directory && entry.second.name == component; });
+                if (it == end) {
+                    it = std::find_if(begin, end, [](const auto& entry) { return entry.second.directory; });
+                }
+                if (it == end) {
+                    return nullptr;
+                }
+
+                actualPath = actualPath + Path(it->second.name);
+                directory = &getDirectory(actualPath, lock);
+            }
+            return directory->exists ? directory : nullptr;
+        }
+
+        const DirectoryIndex::Directory& DirectoryIndex::getDirectory(const Path& actualPath, SharedLock& lock) const {
+            const auto key = actualPath.asString("/");
+            while (true) {
+                if (const auto it = m_directories.find(key); it != std::end(m_directories)) {
+                    return it->second;
+                }
+
+                lock.unlock();
+                auto directory = listDirectory(actualPath);
+                {
+                    std::unique_lock<std::shared_mutex> exclusiveLock(m_mutex);
+                    // another thread may have listed the directory in the meantime, in which case its listing is kept
+                    m_directories.emplace(key, std::move(directory));
+                }
+                lock.lock();
+
+                // the index may have been invalidated before the lock was reacquired, so look the directory up again
+            }
+        }
+
+        DirectoryIndex::Directory DirectoryIndex::listDirectory(const Path& actualPath) const {
+            auto directory = Directory{false, {}};
+            try {
+                QDir dir(pathAsQString(Disk::fixPath(m_root + actualPath)));
+                if (dir.exists()) {
+                    directory.exists = true;
+
+                    dir.setFilter(QDir::NoDotAndDotDot | QDir::AllEntries);
+                    for (const QFileInfo& info : dir.entryInfoList()) {
+                        auto name = pathFromQString(info.fileName()).asString();
+                        auto lowerName = kdl::str_to_lower(name);
+                        directory.entries.emplace(std::move(lowerName), Entry{std::move(name), info.isDir()});
+                    }
+                }
+            } catch (const FileSystemException&) {
+                // the directory is treated as missing
+            }
+            return directory;
+        }
+    }
+}
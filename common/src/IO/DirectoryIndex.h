@@ -0,0 +1,113 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "IO/Path.h"
+
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        /**
+         * Resolves paths relative to a root directory on disk case insensitively.
+         *
+         * The contents of every directory are listed once, when a path within that directory is first resolved, and
+         * are kept in a hash map from the lower case name to the actual name of each directory entry. Subsequent
+         * lookups in the same directory are answered from that map without accessing the disk.
+         *
+         * Changes made to the directory tree after it was listed are not picked up until the index is invalidated.
+         *
+         * This class is thread safe. Lookups share a lock, and the lock is only held exclusively while a newly listed
+         * directory is added to the index, so that listing a directory on disk does not block other lookups.
+         */
+        class DirectoryIndex {
+        public:
+            struct Item {
+                /** The path of the item relative to the root directory, using the actual case of each component. */
+                Path path;
+                bool directory;
+            };
+        private:
+            struct Entry {
+                std::string name;
+                bool directory;
+            };
+
+            struct Directory {
+                bool exists;
+                /** The directory entries by their lower case names. */
+                std::unordered_multimap<std::string, Entry> entries;
+            };
+
+            Path m_root;
+
+            mutable std::shared_mutex m_mutex;
+            /** The directories that have been listed so far by their actual path relative to the root. */
+            mutable std::unordered_map<std::string, Directory> m_directories;
+        public:
+            /**
+             * Creates a new index for the given root directory. The root directory need not exist.
+             *
+             * @param root the absolute path of the root directory
+             */
+            explicit DirectoryIndex(Path root);
+
+            const Path& root() const;
+
+            /**
+             * Finds the item at the given path relative to the root directory. If the directory contains several items
+             * whose names differ only in case, an exact match is preferred.
+             *
+             * @param path the canonical path relative to the root directory
+             * @return the item, or an empty optional if no item exists at the given path
+             */
+            std::optional<Item> find(const Path& path) const;
+
+            /**
+             * Returns the names of the items in the directory at the given path relative to the root directory.
+             *
+             * @param path the canonical path relative to the root directory
+             * @return the names of the items in the directory, or an empty optional if the directory does not exist
+             */
+            std::optional<std::vector<Path>> getDirectoryContents(const Path& path) const;
+
+            /**
+             * Discards all cached directory listings.
+             */
+            void invalidate();
+        private:
+            using SharedLock = std::shared_lock<std::shared_mutex>;
+
+            const Directory* findDirectory(const Path& path, Path& actualPath, SharedLock& lock) const;
+
+            /**
+             * Returns the listing of the directory at the given actual path, listing it on disk if it is not indexed
+             * yet. The given lock is released while the directory is listed, so any directory references obtained
+             * before calling this function must not be used afterwards.
+             */
+            const Directory& getDirectory(const Path& actualPath, SharedLock& lock) const;
+            Directory listDirectory(const Path& actualPath) const;
+        };
+    }
+}
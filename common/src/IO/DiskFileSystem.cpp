@@ -21,9 +21,12 @@
 
 #include "Exceptions.h"
 
+#include "IO/DirectoryIndex.h"
 #include "IO/DiskIO.h"
 #include "IO/File.h"
 
+#include <kdl/invoke.h>
+
 #include <memory>
 #include <string>
 
@@ -34,12 +37,15 @@ namespace TrenchBroom {
 
         DiskFileSystem::DiskFileSystem(std::shared_ptr<FileSystem> next, const Path& root, const bool ensureExists) :
         FileSystem(std::move(next)),
-        m_root(root.makeCanonical()) {
+        m_root(root.makeCanonical()),
+        m_index(Disk::isCaseSensitive() ? std::make_unique<DirectoryIndex>(m_root) : nullptr) {
             if (ensureExists && !Disk::directoryExists(m_root)) {
                 throw FileSystemException("Directory not found: '" + m_root.asString() + "'");
             }
         }
 
+        DiskFileSystem::~DiskFileSystem() = default;
+
         const Path& DiskFileSystem::root() const {
             return m_root;
         }
@@ -54,22 +60,54 @@ namespace TrenchBroom {
         }
 
         bool DiskFileSystem::doDirectoryExists(const Path& path) const {
-            return Disk::directoryExists(doMakeAbsolute(path));
+            const auto absolutePath = doMakeAbsolute(path);
+            if (m_index) {
+                const auto item = m_index->find(path.makeCanonical());
+                return item && item->directory;
+            }
+            return Disk::directoryExists(absolutePath);
         }
 
         bool DiskFileSystem::doFileExists(const Path& path) const {
-            return Disk::fileExists(doMakeAbsolute(path));
+            const auto absolutePath = doMakeAbsolute(path);
+            if (m_index) {
+                const auto item = m_index->find(path.makeCanonical());
+                return item && !item->directory;
+            }
+            return Disk::fileExists(absolutePath);
         }
 
         std::vector<Path> DiskFileSystem::doGetDirectoryContents(const Path& path) const {
-            return Disk::getDirectoryContents(doMakeAbsolute(path));
+            const auto absolutePath = doMakeAbsolute(path);
+            if (m_index) {
+                if (auto contents = m_index->getDirectoryContents(path.makeCanonical())) {
+                    return std::move(*contents);
+                }
+                throw FileSystemException("Cannot open directory: '" + absolutePath.asString() + "'");
+            }
+            return Disk::getDirectoryContents(absolutePath);
         }
 
         std::shared_ptr<File> DiskFileSystem::doOpenFile(const Path& path) const {
-            auto file = Disk::openFile(doMakeAbsolute(path));
+            auto absolutePath = doMakeAbsolute(path);
+            if (m_index) {
+                const auto item = m_index->find(path.makeCanonical());
+                if (!item || item->directory) {
+                    throw FileNotFoundException(absolutePath.asString());
+                }
+                absolutePath = m_root + item->path;
+            }
+
+            auto file = Disk::openFile(absolutePath);
             return std::make_shared<FileView>(path, file, 0u, file->size());
         }
 
+        void DiskFileSystem::doInvalidateCaches() {
+            if (m_index) {
+                m_index->invalidate();
+            }
+        }
+
         WritableDiskFileSystem::WritableDiskFileSystem(const Path& root, const bool create) :
         WritableDiskFileSystem(nullptr, root, create) {}
 
@@ -82,22 +120,27 @@ namespace TrenchBroom {
         }
 
         void WritableDiskFileSystem::doCreateFile(const Path& path, const std::string& contents) {
+            const auto invalidateIndex = kdl::invoke_later([&]() { doInvalidateCaches(); });
             Disk::createFile(doMakeAbsolute(path), contents);
         }
 
         void WritableDiskFileSystem::doCreateDirectory(const Path& path) {
+            const auto invalidateIndex = kdl::invoke_later([&]() { doInvalidateCaches(); });
             Disk::createDirectory(doMakeAbsolute(path));
         }
 
         void WritableDiskFileSystem::doDeleteFile(const Path& path) {
+            const auto invalidateIndex = kdl::invoke_later([&]() { doInvalidateCaches(); });
             Disk::deleteFile(doMakeAbsolute(path));
         }
 
         void WritableDiskFileSystem::doCopyFile(const Path& sourcePath, const Path& destPath, const bool overwrite) {
+            const auto invalidateIndex = kdl::invoke_later([&]() { doInvalidateCaches(); });
             Disk::copyFile(doMakeAbsolute(sourcePath), doMakeAbsolute(destPath), overwrite);
         }
 
         void WritableDiskFileSystem::doMoveFile(const Path& sourcePath, const Path& destPath, const bool overwrite) {
+            const auto invalidateIndex = kdl::invoke_later([&]() { doInvalidateCaches(); });
             Disk::moveFile(doMakeAbsolute(sourcePath), doMakeAbsolute(destPath), overwrite);
         }
     }
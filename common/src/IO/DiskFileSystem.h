@@ -27,17 +27,26 @@
 
 namespace TrenchBroom {
     namespace IO {
+        class DirectoryIndex;
         class Path;
 
         class DiskFileSystem : public FileSystem {
         protected:
             Path m_root;
+            /**
+             * Resolves paths case insensitively on case sensitive file systems. Null if the file system is case
+             * insensitive, in which case all queries are passed on to the disk directly.
+             */
+            std::unique_ptr<DirectoryIndex> m_index;
         public:
             explicit DiskFileSystem(const Path& root, bool ensureExists = true);
             DiskFileSystem(std::shared_ptr<FileSystem> next, const Path& root, bool ensureExists = true);
+            ~DiskFileSystem() override;
 
             const Path& root() const;
         protected:
+            void doInvalidateCaches() override;
+
             bool doCanMakeAbsolute(const Path& path) const override;
             Path doMakeAbsolute(const Path& path) const override;
 
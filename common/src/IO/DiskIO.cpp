@@ -139,7 +139,7 @@ namespace TrenchBroom {
                     throw FileNotFoundException(fixedPath.asString());
                 }
 
-                return std::make_shared<CFile>(fixedPath);
+                return std::make_shared<MappedFile>(fixedPath);
             }
 
             std::string readTextFile(const Path& path) {
@@ -112,7 +112,7 @@ namespace TrenchBroom {
                 const auto entrySize = compressed ? compressedSize : uncompressedSize;
 
                 const auto entryPath = Path(kdl::str_to_lower(entryName));
-                auto entryFile = std::make_shared<FileView>(entryPath, m_file, entryAddress, entrySize);
+                auto entryFile = createFileView(entryPath, entryAddress, entrySize);
 
                 if (compressed) {
                     m_root.addFile(entryPath, std::make_unique<DkCompressedFile>(entryFile, uncompressedSize));
@@ -25,6 +25,8 @@
 #include <cstdio>
 #include <memory>
 
+class QFile;
+
 namespace TrenchBroom {
     namespace IO {
         /**
@@ -133,6 +135,43 @@ namespace TrenchBroom {
             std::FILE* file() const;
         };
 
+        /**
+         * A file that is backed by a physical file on the disk which is mapped into memory. The file is opened and
+         * mapped in the constructor and unmapped and closed in the destructor.
+         *
+         * Readers returned by this file access the mapped memory directly, so reading from them does not copy the file
+         * contents into a separate buffer.
+         */
+        class MappedFile : public File {
+        private:
+            std::unique_ptr<QFile> m_file;
+            const char* m_begin;
+            const char* m_end;
+        public:
+            /**
+             * Creates a new file with the given path, opens the file for reading and maps it into memory.
+             *
+             * @param path the path of the file
+             *
+             * @throw FileSystemException if the file cannot be opened or mapped
+             */
+            explicit MappedFile(const Path& path);
+            ~MappedFile() override;
+
+            Reader reader() const override;
+            size_t size() const override;
+
+            /**
+             * Returns the start of the mapped memory.
+             */
+            const char* begin() const;
+
+            /**
+             * Returns the end of the mapped memory (position after the last byte).
+             */
+            const char* end() const;
+        };
+
         /**
          * A file that is backed by a portion of a physical file.
          */
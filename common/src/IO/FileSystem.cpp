@@ -143,6 +143,17 @@ namespace TrenchBroom {
             }
         }
 
+        void FileSystem::prefetchFiles(const std::vector<Path>& paths) const {
+            _prefetchFiles(kdl::vec_filter(paths, [](const Path& path) { return !path.isAbsolute(); }));
+        }
+
+        void FileSystem::invalidateCaches() {
+            doInvalidateCaches();
+            if (m_next) {
+                m_next->invalidateCaches();
+            }
+        }
+
         Path FileSystem::_makeAbsolute(const Path& path) const {
             if (doFileExists(path) || doDirectoryExists(path)) {
                 // If the file is present in this file system, make it absolute here.
@@ -184,6 +195,29 @@ namespace TrenchBroom {
             }
         }
 
+        void FileSystem::_prefetchFiles(const std::vector<Path>& paths) const {
+            auto pathsHere = std::vector<Path>{};
+            auto pathsElsewhere = std::vector<Path>{};
+            for (const auto& path : paths) {
+                try {
+                    if (doFileExists(path)) {
+                        pathsHere.push_back(path);
+                    } else {
+                        pathsElsewhere.push_back(path);
+                    }
+                } catch (const Exception&) {
+                    // the error is reported when the file is opened
+                }
+            }
+
+            if (!pathsHere.empty()) {
+                doPrefetchFiles(pathsHere);
+            }
+            if (m_next && !pathsElsewhere.empty()) {
+                m_next->_prefetchFiles(pathsElsewhere);
+            }
+        }
+
         bool FileSystem::doCanMakeAbsolute(const Path& /* path */) const {
             return false;
         }
@@ -192,6 +226,10 @@ namespace TrenchBroom {
             throw FileSystemException("Cannot make absolute path of '" + path.asString() + "'");
         }
 
+        void FileSystem::doPrefetchFiles(const std::vector<Path>& /* paths */) const {}
+
+        void FileSystem::doInvalidateCaches() {}
+
         WritableFileSystem::WritableFileSystem() = default;
         WritableFileSystem::~WritableFileSystem() = default;
 
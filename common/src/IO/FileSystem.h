@@ -114,6 +114,21 @@ namespace TrenchBroom {
 
             std::vector<Path> getDirectoryContents(const Path& directoryPath) const;
             std::shared_ptr<File> openFile(const Path& path) const;
+
+            /**
+             * Prepares the files at the given paths so that opening them later is cheap, e.g. by decompressing them in
+             * parallel. Each file is prepared by the file system that would open it. Paths that do not denote a file
+             * are ignored, and errors are only reported when the files are opened.
+             *
+             * @param paths the paths of the files to prefetch
+             */
+            void prefetchFiles(const std::vector<Path>& paths) const;
+
+            /**
+             * Discards any information about the contents of the underlying storage that this file system or the next
+             * file systems in the chain have cached, e.g. because files were changed externally.
+             */
+            void invalidateCaches();
         private: // private API to be used for chaining, avoids multiple checks of parameters
             bool _canMakeAbsolute(const Path& path) const;
             Path _makeAbsolute(const Path& path) const;
@@ -121,6 +136,7 @@ namespace TrenchBroom {
             bool _fileExists(const Path& path) const;
             std::vector<Path> _getDirectoryContents(const Path& directoryPath) const;
             std::shared_ptr<File> _openFile(const Path& path) const;
+            void _prefetchFiles(const std::vector<Path>& paths) const;
 
             /**
              * Finds all items matching the given matcher at the given search path, optionally recursively. This method
@@ -207,6 +223,9 @@ namespace TrenchBroom {
             virtual std::vector<Path> doGetDirectoryContents(const Path& path) const = 0;
 
             virtual std::shared_ptr<File> doOpenFile(const Path& path) const = 0;
+
+            virtual void doPrefetchFiles(const std::vector<Path>& paths) const;
+            virtual void doInvalidateCaches();
         };
 
         class WritableFileSystem {
@@ -65,7 +65,7 @@ namespace TrenchBroom {
                 const auto entrySize = reader.readSize<int32_t>();
 
                 const auto entryPath = Path(kdl::str_to_lower(entryName));
-                auto entryFile = std::make_shared<FileView>(entryPath, m_file, entryAddress, entrySize);
+                auto entryFile = createFileView(entryPath, entryAddress, entrySize);
                 m_root.addFile(entryPath, entryFile);
             }
         }
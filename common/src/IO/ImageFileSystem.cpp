@@ -23,17 +23,28 @@
 #include "IO/DiskFileSystem.h"
 #include "IO/File.h"
 
+#include <kdl/parallel.h>
+
 #include <cassert>
+#include <exception>
 #include <memory>
+#include <unordered_set>
 
 namespace TrenchBroom {
     namespace IO {
+        // the decompressed contents of files are cached up to this total size per file system
+        static const size_t MaxCachedSize = 16u * 1024u * 1024u;
+
         ImageFileSystemBase::FileEntry::~FileEntry() = default;
 
        std::shared_ptr<File> ImageFileSystemBase::FileEntry::open() const {
             return doOpen();
         }
 
+        size_t ImageFileSystemBase::FileEntry::decompressedSize() const {
+            return doGetDecompressedSize();
+        }
+
         ImageFileSystemBase::SimpleFileEntry::SimpleFileEntry(std::shared_ptr<File> file) :
         m_file(std::move(file)) {}
 
@@ -41,6 +52,10 @@ namespace TrenchBroom {
             return m_file;
         }
 
+        size_t ImageFileSystemBase::SimpleFileEntry::doGetDecompressedSize() const {
+            return 0u;
+        }
+
         ImageFileSystemBase::CompressedFileEntry::CompressedFileEntry(std::shared_ptr<File> file, const size_t uncompressedSize) :
         m_file(file),
         m_uncompressedSize(uncompressedSize) {}
@@ -50,6 +65,10 @@ namespace TrenchBroom {
             return std::make_shared<OwningBufferFile>(m_file->path(), std::move(data), m_uncompressedSize);
         }
 
+        size_t ImageFileSystemBase::CompressedFileEntry::doGetDecompressedSize() const {
+            return m_uncompressedSize;
+        }
+
         ImageFileSystemBase::Directory::Directory(const Path& path) :
         m_path(path) {}
 
@@ -159,7 +178,8 @@ namespace TrenchBroom {
         ImageFileSystemBase::ImageFileSystemBase(std::shared_ptr<FileSystem> next, const Path& path) :
         FileSystem(std::move(next)),
         m_path(path),
-        m_root(Path()) {}
+        m_root(Path()),
+        m_cachedSize(0u) {}
 
 
         ImageFileSystemBase::~ImageFileSystemBase() = default;
@@ -173,6 +193,7 @@ namespace TrenchBroom {
         }
 
         void ImageFileSystemBase::reload() {
+            clearCache();
             m_root = Directory(Path());
             initialize();
         }
@@ -195,13 +216,112 @@ namespace TrenchBroom {
 
         std::shared_ptr<File> ImageFileSystemBase::doOpenFile(const Path& path) const {
             const auto searchPath = path.makeLowerCase().makeCanonical();
-            return m_root.findFile(path).open();
+            return openEntry(m_root.findFile(path));
+        }
+
+        void ImageFileSystemBase::doPrefetchFiles(const std::vector<Path>& paths) const {
+            // prefetch no more than fits into the cache, otherwise the first files would be evicted by the last ones
+            auto entries = std::vector<const FileEntry*>{};
+            auto visitedEntries = std::unordered_set<const FileEntry*>{};
+            auto prefetchedSize = size_t(0);
+            for (const auto& path : paths) {
+                const auto& entry = m_root.findFile(path);
+                const auto size = entry.decompressedSize();
+                if (size > 0u && prefetchedSize + size <= MaxCachedSize && visitedEntries.insert(&entry).second && findCachedFile(entry) == nullptr) {
+                    entries.push_back(&entry);
+                    prefetchedSize += size;
+                }
+            }
+
+            auto files = kdl::vec_parallel_transform(entries, [](const FileEntry* entry) -> std::shared_ptr<File> {
+                try {
+                    return entry->open();
+                } catch (const std::exception&) {
+                    // the error is reported when the file is opened
+                    return nullptr;
+                }
+            });
+
+            for (size_t i = 0u; i < entries.size(); ++i) {
+                if (files[i] != nullptr) {
+                    cacheFile(*entries[i], std::move(files[i]));
+                }
+            }
+        }
+
+        std::shared_ptr<File> ImageFileSystemBase::openEntry(const FileEntry& entry) const {
+            if (entry.decompressedSize() == 0u) {
+                return entry.open();
+            }
+
+            if (auto file = findCachedFile(entry)) {
+                return file;
+            }
+
+            // decompress without holding the lock so that files can be opened in parallel
+            return cacheFile(entry, entry.open());
+        }
+
+        std::shared_ptr<File> ImageFileSystemBase::findCachedFile(const FileEntry& entry) const {
+            std::lock_guard<std::mutex> lock(m_cacheMutex);
+
+            const auto it = m_cachedFileIndex.find(&entry);
+            if (it == std::end(m_cachedFileIndex)) {
+                return nullptr;
+            }
+
+            // mark the file as the most recently used one
+            m_cachedFiles.splice(std::begin(m_cachedFiles), m_cachedFiles, it->second);
+            return it->second->second;
+        }
+
+        std::shared_ptr<File> ImageFileSystemBase::cacheFile(const FileEntry& entry, std::shared_ptr<File> file) const {
+            std::lock_guard<std::mutex> lock(m_cacheMutex);
+
+            if (const auto it = m_cachedFileIndex.find(&entry); it != std::end(m_cachedFileIndex)) {
+                // another thread has cached the file in the meantime
+                return it->second->second;
+            }
+
+            const auto size = file->size();
+            if (size > MaxCachedSize) {
+                return file;
+            }
+
+            m_cachedFiles.emplace_front(&entry, file);
+            m_cachedFileIndex.emplace(&entry, std::begin(m_cachedFiles));
+            m_cachedSize += size;
+
+            // evict the least recently used files
+            while (m_cachedSize > MaxCachedSize) {
+                const auto& [evictedEntry, evictedFile] = m_cachedFiles.back();
+                m_cachedSize -= evictedFile->size();
+                m_cachedFileIndex.erase(evictedEntry);
+                m_cachedFiles.pop_back();
+            }
+
+            return file;
+        }
+
+        void ImageFileSystemBase::clearCache() {
+            std::lock_guard<std::mutex> lock(m_cacheMutex);
+            m_cachedFiles.clear();
+            m_cachedFileIndex.clear();
+            m_cachedSize = 0u;
         }
 
         ImageFileSystem::ImageFileSystem(std::shared_ptr<FileSystem> next, const Path& path) :
         ImageFileSystemBase(std::move(next), path),
-        m_file(std::make_shared<CFile>(path)) {
+        m_file(std::make_shared<MappedFile>(path)) {
             ensure(m_path.isAbsolute(), "path must be absolute");
         }
+
+        std::shared_ptr<File> ImageFileSystem::createFileView(const Path& path, const size_t offset, const size_t length) const {
+            if (offset > m_file->size() || length > m_file->size() - offset) {
+                throw FileSystemException("File entry '" + path.asString() + "' is out of bounds");
+            }
+
+            return std::make_shared<FileView>(path, m_file, offset, length);
+        }
     }
 }
@@ -24,13 +24,17 @@
 
 #include <kdl/string_compare.h>
 
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
 
 namespace TrenchBroom {
     namespace IO {
-        class CFile;
         class File;
+        class MappedFile;
 
         class ImageFileSystemBase : public FileSystem {
         protected:
@@ -39,8 +43,15 @@ namespace TrenchBroom {
                 virtual ~FileEntry();
 
                 std::shared_ptr<File> open() const;
+
+                /**
+                 * Returns the size of the contents of this entry if they must be decompressed when the entry is opened,
+                 * and 0 otherwise. Only the contents of compressed entries are cached.
+                 */
+                size_t decompressedSize() const;
             private:
                 virtual std::shared_ptr<File> doOpen() const = 0;
+                virtual size_t doGetDecompressedSize() const = 0;
             };
 
             class SimpleFileEntry : public FileEntry {
@@ -50,6 +61,7 @@ namespace TrenchBroom {
                 explicit SimpleFileEntry(std::shared_ptr<File> file);
             private:
                 std::shared_ptr<File> doOpen() const override;
+                size_t doGetDecompressedSize() const override;
             };
 
             class CompressedFileEntry : public FileEntry {
@@ -61,6 +73,7 @@ namespace TrenchBroom {
                 ~CompressedFileEntry() override = default;
             private:
                 std::shared_ptr<File> doOpen() const override;
+                size_t doGetDecompressedSize() const override;
                 virtual std::unique_ptr<char[]> decompress(std::shared_ptr<File> file, size_t uncompressedSize) const = 0;
             };
 
@@ -90,6 +103,14 @@ namespace TrenchBroom {
         protected:
             Path m_path;
             Directory m_root;
+        private:
+            using CachedFileList = std::list<std::pair<const FileEntry*, std::shared_ptr<File>>>;
+
+            mutable std::mutex m_cacheMutex;
+            /** The decompressed contents of recently opened entries, the most recently used first. */
+            mutable CachedFileList m_cachedFiles;
+            mutable std::unordered_map<const FileEntry*, CachedFileList::iterator> m_cachedFileIndex;
+            mutable size_t m_cachedSize;
         protected:
             ImageFileSystemBase(std::shared_ptr<FileSystem> next, const Path& path);
         public:
@@ -107,15 +128,43 @@ namespace TrenchBroom {
 
             std::vector<Path> doGetDirectoryContents(const Path& path) const override;
             std::shared_ptr<File> doOpenFile(const Path& path) const override;
+
+            /**
+             * Decompresses the given files in parallel and caches their contents. Files whose contents are already
+             * cached or whose contents exceed the cache size are skipped.
+             */
+            void doPrefetchFiles(const std::vector<Path>& paths) const override;
         private:
             virtual void doReadDirectory() = 0;
+
+            std::shared_ptr<File> openEntry(const FileEntry& entry) const;
+            std::shared_ptr<File> findCachedFile(const FileEntry& entry) const;
+            std::shared_ptr<File> cacheFile(const FileEntry& entry, std::shared_ptr<File> file) const;
+            void clearCache();
         };
 
+        /**
+         * An image file system that is backed by a file on the disk. The file is mapped into memory, and files that are
+         * stored uncompressed in the image are views into the mapped memory. Each view keeps the mapping alive, so
+         * such files remain valid after this file system has been destroyed.
+         */
         class ImageFileSystem : public ImageFileSystemBase {
         protected:
-            std::shared_ptr<CFile> m_file;
+            std::shared_ptr<MappedFile> m_file;
         protected:
             ImageFileSystem(std::shared_ptr<FileSystem> next, const Path& path);
+
+            /**
+             * Creates a file that refers to the given portion of the image file without copying it. The returned file
+             * shares ownership of the image file.
+             *
+             * @param path the path of the file to create
+             * @param offset the offset of the file contents in the image file
+             * @param length the length of the file contents
+             *
+             * @throw FileSystemException if the given portion exceeds the image file
+             */
+            std::shared_ptr<File> createFileView(const Path& path, size_t offset, size_t length) const;
         };
     }
 }
@@ -19,6 +19,9 @@
 
 #include "MapReader.h"
 
+#include "Exceptions.h"
+#include "Macros.h"
+#include "IO/BufferedParserStatus.h"
 #include "IO/ParserStatus.h"
 #include "Model/BrushError.h"
 #include "Model/BrushFace.h"
@@ -42,23 +45,41 @@
 #include <kdl/result_for_each.h>
 #include <kdl/string_format.h>
 #include <kdl/string_utils.h>
+#include <kdl/thread_pool.h>
 #include <kdl/vector_utils.h>
 
+#include <algorithm>
 #include <cassert>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom {
     namespace IO {
+        // Below this size, splitting the input and merging the results costs more than parsing in parallel saves.
+        static constexpr size_t DefaultParallelParsingThreshold = 1024u * 1024u;
+
         MapReader::MapReader(std::string_view str, const Model::MapFormat sourceMapFormat, const Model::MapFormat targetMapFormat) :
-        StandardMapParser(std::move(str), sourceMapFormat, targetMapFormat) {}
+        StandardMapParser(str, sourceMapFormat, targetMapFormat),
+        m_str(str),
+        m_parallelParsingThreshold(DefaultParallelParsingThreshold) {}
+
+        void MapReader::setParallelParsingThreshold(const size_t threshold) {
+            m_parallelParsingThreshold = threshold;
+        }
 
         void MapReader::readEntities(const vm::bbox3& worldBounds, ParserStatus& status) {
             m_worldBounds = worldBounds;
-            parseEntities(status);
+            // Doom 3 maps start with a version header and parsing them modifies shared parser state
+            if (m_str.size() >= m_parallelParsingThreshold && m_sourceMapFormat != Model::MapFormat::Doom3) {
+                parseEntitiesInParallel(status);
+            } else {
+                parseEntities(status);
+            }
             createNodes(status);
         }
 
@@ -128,7 +149,292 @@ namespace TrenchBroom {
         }
 
         // helper methods
-        
+
+        namespace {
+            /** A part of the string to parse that consists of complete top level entities. */
+            struct EntityChunk {
+                std::string_view str;
+                size_t line;
+                size_t column;
+                size_t entityCount;
+            };
+        }
+
+        /**
+         * Splits the given string after the closing braces of top level entities into chunks of roughly the given size.
+         *
+         * The string is scanned the way QuakeMapTokenizer would tokenize it, skipping comments and quoted strings, so that
+         * braces in property values are not mistaken for entity boundaries. The line and column of the first character of
+         * each chunk are tracked like TokenizerBase::advance does. Any remainder that does not end with a top level closing
+         * brace is added to the last chunk.
+         *
+         * The scanner does not validate the input. If it places a boundary where the parser would not, parsing the
+         * affected chunks fails or yields a different number of entities.
+         */
+        static std::vector<EntityChunk> splitIntoEntityChunks(const std::string_view str, const size_t chunkSize) {
+            auto chunks = std::vector<EntityChunk>{};
+
+            const auto length = str.length();
+            auto pos = size_t(0);
+            auto line = size_t(1);
+            auto column = size_t(1);
+            auto escaped = false;
+
+            auto chunkBegin = size_t(0);
+            auto chunkLine = size_t(1);
+            auto chunkColumn = size_t(1);
+            auto chunkEntityCount = size_t(0);
+
+            auto depth = size_t(0);
+            // texture names follow the closing parenthesis of the face points and may start with a brace
+            auto afterCParenthesis = false;
+
+            const auto advance = [&]() {
+                switch (str[pos]) {
+                    case '\r':
+                        if (pos + 1u < length && str[pos + 1u] == '\n') {
+                            ++column;
+                            break;
+                        }
+                        switchFallthrough();
+                    case '\n':
+                        ++line;
+                        column = 1u;
+                        escaped = false;
+                        break;
+                    default:
+                        ++column;
+                        escaped = str[pos] == '\\' ? !escaped : false;
+                        break;
+                }
+                ++pos;
+            };
+
+            const auto isWhitespace = [](const char c) {
+                return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+            };
+
+            const auto isEscapedQuote = [&]() {
+                return escaped && str[pos] == '"';
+            };
+
+            const auto discardLine = [&]() {
+                while (pos < length && str[pos] != '\n' && str[pos] != '\r') {
+                    advance();
+                }
+            };
+
+            while (pos < length) {
+                const auto c = str[pos];
+                if (isWhitespace(c)) {
+                    advance();
+                    continue;
+                }
+
+                switch (c) {
+                    case '/':
+                        advance();
+                        if (pos < length && str[pos] == '/') {
+                            advance();
+                            if (pos + 1u < length && str[pos] == '/' && str[pos + 1u] == ' ') {
+                                // doc comment token, the remainder of the line is tokenized
+                                advance();
+                            } else {
+                                discardLine();
+                            }
+                        }
+                        afterCParenthesis = false;
+                        break;
+                    case ';':
+                        advance();
+                        discardLine();
+                        afterCParenthesis = false;
+                        break;
+                    case '"': {
+                        // property values handle a trailing backslash before the closing quote, texture names do not
+                        const auto handleTrailingBackslash = !afterCParenthesis;
+                        advance();
+                        while (pos < length && (str[pos] != '"' || isEscapedQuote())) {
+                            if (handleTrailingBackslash && isEscapedQuote() && pos + 1u < length && (str[pos + 1u] == '\n' || str[pos + 1u] == '}')) {
+                                escaped = false;
+                                break;
+                            }
+                            advance();
+                        }
+                        if (pos < length) {
+                            advance();
+                        }
+                        afterCParenthesis = false;
+                        break;
+                    }
+                    case '}':
+                        advance();
+                        if (depth > 0u && --depth == 0u) {
+                            ++chunkEntityCount;
+                            if (pos - chunkBegin >= chunkSize) {
+                                chunks.push_back(EntityChunk{str.substr(chunkBegin, pos - chunkBegin), chunkLine, chunkColumn, chunkEntityCount});
+                                chunkBegin = pos;
+                                chunkLine = line;
+                                chunkColumn = column;
+                                chunkEntityCount = 0u;
+                            }
+                        }
+                        afterCParenthesis = false;
+                        break;
+                    case ')':
+                        advance();
+                        afterCParenthesis = true;
+                        break;
+                    case '(':
+                    case '[':
+                    case ']':
+                        advance();
+                        afterCParenthesis = false;
+                        break;
+                    case '{':
+                        if (!afterCParenthesis) {
+                            advance();
+                            ++depth;
+                            break;
+                        }
+                        switchFallthrough();
+                    default: {
+                        // read a word until whitespace, numbers are also terminated by a closing parenthesis
+                        auto isNumber = true;
+                        do {
+                            isNumber = isNumber && std::string_view("+-.0123456789e").find(str[pos]) != std::string_view::npos;
+                            advance();
+                        } while (pos < length && !isWhitespace(str[pos]) && !(isNumber && str[pos] == ')'));
+                        afterCParenthesis = false;
+                        break;
+                    }
+                }
+            }
+
+            if (chunks.empty() || chunkEntityCount > 0u || depth > 0u) {
+                chunks.push_back(EntityChunk{str.substr(chunkBegin), chunkLine, chunkColumn, chunkEntityCount});
+            } else {
+                // append trailing whitespace and comments to the last chunk
+                auto& lastChunk = chunks.back();
+                lastChunk.str = std::string_view(lastChunk.str.data(), length - static_cast<size_t>(lastChunk.str.data() - str.data()));
+            }
+
+            return chunks;
+        }
+
+        /**
+         * Parses a chunk of complete entities and records the object infos and the number of entities that were read.
+         */
+        class MapReader::ChunkReader : public MapReader {
+        private:
+            size_t m_beginEntityCount = 0u;
+            size_t m_endEntityCount = 0u;
+        public:
+            ChunkReader(const EntityChunk& chunk, const Model::MapFormat sourceMapFormat, const Model::MapFormat targetMapFormat) :
+            MapReader(chunk.str, sourceMapFormat, targetMapFormat) {
+                setStartPosition(chunk.line, chunk.column);
+            }
+
+            /**
+             * Parses the chunk and returns the recorded object infos. Returns an empty optional if the number of entities
+             * in the chunk is not the given expected count.
+             *
+             * @throws ParserException if parsing fails
+             */
+            std::optional<std::vector<ObjectInfo>> read(const size_t expectedEntityCount, ParserStatus& status) {
+                parseEntities(status);
+                if (m_beginEntityCount != expectedEntityCount || m_endEntityCount != expectedEntityCount) {
+                    return std::nullopt;
+                }
+                return std::move(m_objectInfos);
+            }
+        private:
+            void onBeginEntity(const size_t line, std::vector<Model::EntityProperty> properties, ParserStatus& status) override {
+                ++m_beginEntityCount;
+                MapReader::onBeginEntity(line, std::move(properties), status);
+            }
+
+            void onEndEntity(const size_t startLine, const size_t lineCount, ParserStatus& status) override {
+                ++m_endEntityCount;
+                MapReader::onEndEntity(startLine, lineCount, status);
+            }
+
+            Model::Node* onWorldNode(std::unique_ptr<Model::WorldNode>, ParserStatus&) override { return nullptr; }
+            void onLayerNode(std::unique_ptr<Model::Node>, ParserStatus&) override {}
+            void onNode(Model::Node*, std::unique_ptr<Model::Node>, ParserStatus&) override {}
+        };
+
+        namespace {
+            /** The object infos recorded for a chunk and the messages that were logged while parsing it. */
+            struct ChunkResult {
+                std::optional<std::vector<MapReader::ObjectInfo>> objectInfos;
+                std::unique_ptr<BufferedParserStatus> status;
+            };
+        }
+
+        void MapReader::parseEntitiesInParallel(ParserStatus& status) {
+            // create a few more chunks than there are threads so that threads which finish early can take over work
+            const auto chunkCount = 4u * (kdl::default_thread_pool().thread_count() + 1u);
+            auto chunks = splitIntoEntityChunks(m_str, std::max(m_str.length() / chunkCount, size_t(1)));
+            if (chunks.size() < 2u) {
+                parseEntities(status);
+                return;
+            }
+
+            // the chunks are contiguous, so the progress is the share of the string covered by the parsed chunks
+            auto progressMutex = std::mutex{};
+            auto parsedLength = size_t(0);
+            const auto reportProgress = [&](const EntityChunk& chunk) {
+                const auto lock = std::lock_guard<std::mutex>{progressMutex};
+                parsedLength += chunk.str.length();
+                status.progress(static_cast<double>(parsedLength) / static_cast<double>(m_str.length()));
+            };
+
+            auto chunkResults = kdl::vec_parallel_transform(std::move(chunks), [&](EntityChunk&& chunk) {
+                auto chunkStatus = std::make_unique<BufferedParserStatus>(status);
+                try {
+                    auto reader = ChunkReader{chunk, m_sourceMapFormat, m_targetMapFormat};
+                    auto objectInfos = reader.read(chunk.entityCount, *chunkStatus);
+                    reportProgress(chunk);
+                    return ChunkResult{std::move(objectInfos), std::move(chunkStatus)};
+                } catch (const ParserException&) {
+                    reportProgress(chunk);
+                    return ChunkResult{std::nullopt, std::move(chunkStatus)};
+                }
+            });
+
+            const auto failed = std::any_of(std::begin(chunkResults), std::end(chunkResults), [](const auto& chunkResult) {
+                return !chunkResult.objectInfos.has_value();
+            });
+            if (failed) {
+                // parse again so that messages and errors are reported exactly as if the chunks had never been split
+                parseEntities(status);
+                return;
+            }
+
+            for (auto& chunkResult : chunkResults) {
+                // parent indices refer to the entity infos of the chunk
+                const auto offset = m_objectInfos.size();
+                for (auto& objectInfo : *chunkResult.objectInfos) {
+                    std::visit(kdl::overload(
+                        [] (EntityInfo&) {},
+                        [&](BrushInfo& brushInfo) {
+                            if (brushInfo.parentIndex) {
+                                *brushInfo.parentIndex += offset;
+                            }
+                        },
+                        [&](PatchInfo& patchInfo) {
+                            if (patchInfo.parentIndex) {
+                                *patchInfo.parentIndex += offset;
+                            }
+                        }
+                    ), objectInfo);
+                    m_objectInfos.push_back(std::move(objectInfo));
+                }
+                chunkResult.status->flush();
+            }
+        }
+
         namespace {
             /** The type of a node's container. */
             enum class ContainerType {
@@ -61,7 +61,8 @@ namespace TrenchBroom {
          *
          * The flow of control is:
          *
-         * 1. MapParser callbacks get called with the raw data, which we just store (m_objectInfos).
+         * 1. MapParser callbacks get called with the raw data, which we just store (m_objectInfos). Large files are
+         *    split at top level entity boundaries and the parts are parsed in parallel (parseEntitiesInParallel).
          * 2. Convert the raw data to nodes in parallel (createNodes) and record any additional information
          *    necessary to restore the parent / child relationships.
          * 3. Validate the created nodes.
@@ -95,6 +96,10 @@ namespace TrenchBroom {
 
             using ObjectInfo = std::variant<EntityInfo, BrushInfo, PatchInfo>;
         private:
+            class ChunkReader;
+
+            std::string_view m_str;
+            size_t m_parallelParsingThreshold;
             vm::bbox3 m_worldBounds;
         private: // data populated in response to MapParser callbacks
             std::vector<ObjectInfo> m_objectInfos;
@@ -109,7 +114,15 @@ namespace TrenchBroom {
              * @param targetMapFormat the format to convert the created objects to
              */
             MapReader(std::string_view str, Model::MapFormat sourceMapFormat, Model::MapFormat targetMapFormat);
-
+        public:
+            /**
+             * Sets the minimum length of the string to parse in bytes at which `readEntities` parses the entities in
+             * parallel. Parsing in parallel produces the same results and messages as parsing sequentially.
+             *
+             * @param threshold the minimum length in bytes
+             */
+            void setParallelParsingThreshold(size_t threshold);
+        protected:
             /**
              * Attempts to parse as one or more entities.
              *
@@ -137,6 +150,18 @@ namespace TrenchBroom {
             void onValveBrushFace(size_t line, Model::MapFormat targetMapFormat, const vm::vec3& point1, const vm::vec3& point2, const vm::vec3& point3, const Model::BrushFaceAttributes& attribs, const vm::vec3& texAxisX, const vm::vec3& texAxisY, ParserStatus& status) override;
             void onPatch(size_t startLine, size_t lineCount, Model::MapFormat targetMapFormat, size_t rowCount, size_t columnCount, std::vector<vm::vec<FloatType, 5>> controlPoints, std::string textureName, ParserStatus& status) override;
         private: // helper methods
+            /**
+             * Splits the string at top level entity boundaries and parses the parts in parallel, then appends the
+             * recorded object infos to m_objectInfos and logs the messages in the order of the string. Falls back to
+             * parsing sequentially if any part fails to parse so that errors are reported exactly as if the entire
+             * string had been parsed at once.
+             *
+             * Progress is reported to the given status whenever a part has been parsed. These reports are made from the
+             * worker threads, but never concurrently.
+             *
+             * @throws ParserException if parsing fails
+             */
+            void parseEntitiesInParallel(ParserStatus& status);
             void createNodes(ParserStatus& status);
         private: // subclassing interface - these will be called in the order that nodes should be inserted
             /**
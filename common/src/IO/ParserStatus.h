@@ -28,6 +28,8 @@ namespace TrenchBroom {
     namespace IO {
         class ParserStatus {
         private:
+            friend class BufferedParserStatus;
+
             Logger& m_logger;
             std::string m_prefix;
         protected:
@@ -19,6 +19,7 @@
 
 #include "Quake3ShaderFileSystem.h"
 
+#include "BufferedLogger.h"
 #include "Logger.h"
 #include "Assets/Quake3Shader.h"
 #include "IO/File.h"
@@ -26,10 +27,15 @@
 #include "IO/Quake3ShaderParser.h"
 #include "IO/SimpleParserStatus.h"
 
+#include <kdl/parallel.h>
+#include <kdl/string_format.h>
 #include <kdl/vector_utils.h>
 
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom {
@@ -53,34 +59,35 @@ namespace TrenchBroom {
             auto result = std::vector<Assets::Quake3Shader>();
 
             if (next().directoryExists(m_shaderSearchPath)) {
-                auto paths = next().findItems(m_shaderSearchPath, FileExtensionMatcher("shader"));
-                for (const auto& path : paths) {
-                    const auto file = next().openFile(path);
-                    auto bufferedReader = file->reader().buffer();
-
-                    try {
-                        Quake3ShaderParser parser(bufferedReader.stringView());
-                        SimpleParserStatus status(m_logger, file->path().asString());
-                        result = kdl::vec_concat(std::move(result), parser.parse(status));
-                    } catch (const ParserException& e) {
-                        m_logger.warn() << "Skipping malformed shader file " << path << ": " << e.what();
-                    }
-                }
-
                 // RB: ugly but do the same with Doom 3 materials again
-                paths = next().findItems(m_shaderSearchPath, FileExtensionMatcher("mtr"));
-                for (const auto& path : paths) {
-                    const auto file = next().openFile(path);
+                const auto paths = kdl::vec_concat(
+                    next().findItems(m_shaderSearchPath, FileExtensionMatcher("shader")),
+                    next().findItems(m_shaderSearchPath, FileExtensionMatcher("mtr")));
+
+                // decompress the shader files in parallel before opening them one by one
+                next().prefetchFiles(paths);
+                auto files = kdl::vec_transform(paths, [&](const auto& path) {
+                    return std::make_pair(path, next().openFile(path));
+                });
+
+                // parse the shader files in parallel, but keep the shaders in the order of their files
+                auto logger = BufferedLogger(m_logger);
+                auto shaders = kdl::vec_parallel_transform(std::move(files), [&](std::pair<Path, std::shared_ptr<File>>&& pathAndFile) {
+                    const auto& [path, file] = pathAndFile;
                     auto bufferedReader = file->reader().buffer();
 
                     try {
                         Quake3ShaderParser parser(bufferedReader.stringView());
-                        SimpleParserStatus status(m_logger, file->path().asString());
-                        result = kdl::vec_concat(std::move(result), parser.parse(status));
+                        SimpleParserStatus status(logger, file->path().asString());
+                        return parser.parse(status);
                     } catch (const ParserException& e) {
-                        m_logger.warn() << "Skipping malformed shader file " << path << ": " << e.what();
+                        logger.warn() << "Skipping malformed shader file " << path << ": " << e.what();
+                        return std::vector<Assets::Quake3Shader>();
                     }
-                }
+                });
+                logger.flush();
+
+                result = kdl::vec_flatten(std::move(shaders));
             }
 
             m_logger.info() << "Loaded " << result.size() << " shaders";
@@ -104,24 +111,34 @@ namespace TrenchBroom {
 
         void Quake3ShaderFileSystem::linkTextures(const std::vector<Path>& textures, std::vector<Assets::Quake3Shader>& shaders) {
             m_logger.debug() << "Linking textures...";
+
+            // If several shaders have the same path, only the first one is linked to a texture.
+            auto shadersByPath = std::unordered_map<std::string, size_t>();
+            shadersByPath.reserve(shaders.size());
+            for (size_t i = 0u; i < shaders.size(); ++i) {
+                shadersByPath.emplace(shaders[i].shaderPath.asString("/"), i);
+            }
+
+            // Shader paths are looked up case insensitively in this file system, and so are the linked paths.
+            auto linkedPaths = std::unordered_set<std::string>();
+            linkedPaths.reserve(textures.size());
+            auto linkedShaders = std::vector<bool>(shaders.size(), false);
+
             for (const auto& texture : textures) {
                 const auto shaderPath = texture.deleteExtension();
 
                 // Only link a shader if it has not been linked yet.
-                if (!fileExists(shaderPath)) {
-                    const auto shaderIt = std::find_if(std::begin(shaders), std::end(shaders), [&shaderPath](const auto& shader){
-                        return shaderPath == shader.shaderPath;
-                    });
-
-                    if (shaderIt != std::end(shaders)) {
+                if (linkedPaths.insert(kdl::str_to_lower(shaderPath.asString("/"))).second) {
+                    const auto shaderIt = shadersByPath.find(shaderPath.asString("/"));
+                    if (shaderIt != std::end(shadersByPath)) {
                         // Found a matching shader.
-                        auto& shader = *shaderIt;
+                        const auto index = shaderIt->second;
 
-                        auto shaderFile = std::make_shared<ObjectFile<Assets::Quake3Shader>>(shaderPath, shader);
-                        m_root.addFile(shaderPath, shaderFile);
+                        auto shaderFile = std::make_shared<ObjectFile<Assets::Quake3Shader>>(shaderPath, std::move(shaders[index]));
+                        m_root.addFile(shaderPath, std::move(shaderFile));
 
-                        // Remove the shader so that we don't revisit it when linking standalone shaders.
-                        shaders.erase(shaderIt);
+                        // Mark the shader so that we don't revisit it when linking standalone shaders.
+                        linkedShaders[index] = true;
                     } else {
                         // No matching shader found, generate one.
                         auto shader = Assets::Quake3Shader();
@@ -133,6 +150,15 @@ namespace TrenchBroom {
                     }
                 }
             }
+
+            auto unlinkedShaders = std::vector<Assets::Quake3Shader>();
+            unlinkedShaders.reserve(shaders.size());
+            for (size_t i = 0u; i < shaders.size(); ++i) {
+                if (!linkedShaders[i]) {
+                    unlinkedShaders.push_back(std::move(shaders[i]));
+                }
+            }
+            shaders = std::move(unlinkedShaders);
         }
 
         void Quake3ShaderFileSystem::linkStandaloneShaders(std::vector<Assets::Quake3Shader>& shaders) {
@@ -192,6 +192,13 @@ namespace TrenchBroom {
             m_tokenizer.reset();
         }
 
+        void StandardMapParser::setStartPosition(const size_t line, const size_t column) {
+            auto state = m_tokenizer.snapshot();
+            state.line = line;
+            state.column = column;
+            m_tokenizer.restore(state);
+        }
+
         void StandardMapParser::parseEntity(ParserStatus& status) {
             Token token = m_tokenizer.nextToken();
             if (token.type() == QuakeMapToken::Eof) {
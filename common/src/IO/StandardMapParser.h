@@ -97,6 +97,15 @@ namespace TrenchBroom {
             void parseBrushFaces(ParserStatus& status);
 
             void reset();
+
+            /**
+             * Sets the line and column of the first character of the string passed to the constructor. This is useful
+             * if the string is a part of a larger file so that reported positions refer to that file.
+             *
+             * @param line the line number of the first character
+             * @param column the column number of the first character
+             */
+            void setStartPosition(size_t line, size_t column);
         private:
             void parseEntity(ParserStatus& status);
             void parseEntityProperty(std::vector<Model::EntityProperty>& properties, PropertyKeys& keys, ParserStatus& status);
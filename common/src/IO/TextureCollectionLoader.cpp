@@ -20,6 +20,7 @@
 #include "TextureCollectionLoader.h"
 
 #include "Logger.h"
+#include "Assets/Texture.h"
 #include "Assets/TextureCollection.h"
 #include "IO/DiskIO.h"
 #include "IO/File.h"
@@ -28,7 +29,10 @@
 #include "IO/TextureReader.h"
 #include "IO/WadFileSystem.h"
 
+#include <kdl/parallel.h>
+
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace TrenchBroom {
@@ -39,7 +43,7 @@ namespace TrenchBroom {
 
         TextureCollectionLoader::~TextureCollectionLoader() = default;
 
-        bool TextureCollectionLoader::shouldExclude(const std::string& textureName) {
+        bool TextureCollectionLoader::shouldExclude(const std::string& textureName) const {
             for (const auto& pattern : m_textureExclusions) {
                 if (kdl::ci::str_matches_glob(textureName, pattern)) {
                     return true;
@@ -48,6 +52,19 @@ namespace TrenchBroom {
             return false;
         }
 
+        std::vector<Assets::Texture> TextureCollectionLoader::collectTextures(std::vector<std::optional<Assets::Texture>> textures) {
+            auto result = std::vector<Assets::Texture>();
+            result.reserve(textures.size());
+
+            for (auto& texture : textures) {
+                if (texture.has_value()) {
+                    result.push_back(std::move(*texture));
+                }
+            }
+
+            return result;
+        }
+
         FileTextureCollectionLoader::FileTextureCollectionLoader(Logger& logger, const std::vector<IO::Path>& searchPaths, const std::vector<std::string>& exclusions) :
         TextureCollectionLoader(logger, exclusions),
         m_searchPaths(searchPaths) {}
@@ -57,23 +74,21 @@ namespace TrenchBroom {
             WadFileSystem wadFS(wadPath, m_logger);
 
             const auto texturePaths = wadFS.findItems(Path(""), FileExtensionMatcher(textureExtensions));
-            auto textures = std::vector<Assets::Texture>();
-            textures.reserve(texturePaths.size());
-            
-            for (const auto& texturePath : texturePaths)  {
+            auto textures = kdl::vec_parallel_transform(texturePaths, [&](const Path& texturePath) -> std::optional<Assets::Texture> {
                 try {
                     auto file = wadFS.openFile(texturePath);
                     const auto name = file->path().lastComponent().deleteExtension().asString();
                     if (shouldExclude(name)) {
-                        continue;
+                        return std::nullopt;
                     }
-                    textures.push_back(textureReader.readTexture(file));
+                    return textureReader.readTexture(file);
                 } catch (const std::exception& e) {
                     m_logger.warn() << e.what();
+                    return std::nullopt;
                 }
-            }
+            });
 
-            return Assets::TextureCollection(path, std::move(textures));
+            return Assets::TextureCollection(path, collectTextures(std::move(textures)));
         }
 
         DirectoryTextureCollectionLoader::DirectoryTextureCollectionLoader(Logger& logger, const FileSystem& gameFS, const std::vector<std::string>& exclusions) :
@@ -82,10 +97,7 @@ namespace TrenchBroom {
 
         Assets::TextureCollection DirectoryTextureCollectionLoader::loadTextureCollection(const Path& path, const std::vector<std::string>& textureExtensions, const TextureReader& textureReader) {
             const auto texturePaths = m_gameFS.findItems(path, FileExtensionMatcher(textureExtensions));
-            auto textures = std::vector<Assets::Texture>();
-            textures.reserve(texturePaths.size());
-
-            for (const auto& texturePath : texturePaths) {
+            auto textures = kdl::vec_parallel_transform(texturePaths, [&](const Path& texturePath) -> std::optional<Assets::Texture> {
                 try {
                     auto file = m_gameFS.openFile(texturePath);
 
@@ -99,18 +111,19 @@ namespace TrenchBroom {
 
                     const auto name = file->path().lastComponent().deleteExtension().asString();
                     if (shouldExclude(name)) {
-                        continue;
+                        return std::nullopt;
                     }
                     auto texture = textureReader.readTexture(file);
                     texture.setAbsolutePath(absolutePath);
                     texture.setRelativePath(texturePath);
-                    textures.push_back(std::move(texture));
+                    return texture;
                 } catch (const std::exception& e) {
                     m_logger.warn() << e.what();
+                    return std::nullopt;
                 }
-            }
-            
-            return Assets::TextureCollection(path, std::move(textures));
+            });
+
+            return Assets::TextureCollection(path, collectTextures(std::move(textures)));
         }
     }
 }
@@ -20,14 +20,15 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
-#include <string>
 
 namespace TrenchBroom {
     class Logger;
 
     namespace Assets {
+        class Texture;
         class TextureCollection;
     }
 
@@ -37,6 +38,10 @@ namespace TrenchBroom {
         class Path;
         class TextureReader;
 
+        /**
+         * Loads the textures of a texture collection. The textures are read in parallel, so the given texture reader and
+         * logger must be safe to use from multiple threads.
+         */
         class TextureCollectionLoader {
         protected:
             using FileList = std::vector<std::shared_ptr<File>>;
@@ -50,7 +55,8 @@ namespace TrenchBroom {
         public:
             virtual Assets::TextureCollection loadTextureCollection(const Path& path, const std::vector<std::string>& textureExtensions, const TextureReader& textureReader) = 0;
         protected:
-            bool shouldExclude(const std::string& textureName);
+            bool shouldExclude(const std::string& textureName) const;
+            static std::vector<Assets::Texture> collectTextures(std::vector<std::optional<Assets::Texture>> textures);
         };
 
         class FileTextureCollectionLoader : public TextureCollectionLoader {
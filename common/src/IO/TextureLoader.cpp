@@ -19,6 +19,7 @@
 
 #include "TextureLoader.h"
 
+#include "BufferedLogger.h"
 #include "Ensure.h"
 #include "Logger.h"
 #include "Assets/Palette.h"
@@ -35,17 +36,21 @@
 #include "IO/Path.h"
 #include "Model/GameConfig.h"
 
+#include <kdl/invoke.h>
+
 #include <string>
 #include <vector>
 
 namespace TrenchBroom {
     namespace IO {
         TextureLoader::TextureLoader(const FileSystem& gameFS, const std::vector<IO::Path>& fileSearchPaths, const Model::TextureConfig& textureConfig, Logger& logger) :
+        m_logger(std::make_unique<BufferedLogger>(logger)),
         m_textureExtensions(getTextureExtensions(textureConfig)),
-        m_textureReader(createTextureReader(gameFS, textureConfig, logger)),
-        m_textureCollectionLoader(createTextureCollectionLoader(gameFS, fileSearchPaths, textureConfig, logger)) {
+        m_textureReader(createTextureReader(gameFS, textureConfig, *m_logger)),
+        m_textureCollectionLoader(createTextureCollectionLoader(gameFS, fileSearchPaths, textureConfig, *m_logger)) {
             ensure(m_textureReader != nullptr, "textureReader is null");
             ensure(m_textureCollectionLoader != nullptr, "textureCollectionLoader is null");
+            m_logger->flush();
         }
 
         TextureLoader::~TextureLoader() = default;
@@ -104,6 +109,7 @@ namespace TrenchBroom {
         }
 
         Assets::TextureCollection TextureLoader::loadTextureCollection(const Path& path) {
+            const auto flushLog = kdl::invoke_later([&]() { m_logger->flush(); });
             return m_textureCollectionLoader->loadTextureCollection(path, m_textureExtensions, *m_textureReader);
         }
 
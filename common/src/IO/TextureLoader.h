@@ -26,6 +26,7 @@
 #include <vector>
 
 namespace TrenchBroom {
+    class BufferedLogger;
     class Logger;
 
     namespace Assets {
@@ -44,8 +45,13 @@ namespace TrenchBroom {
         class TextureCollectionLoader;
         class TextureReader;
 
+        /**
+         * Loads texture collections. The textures of a collection are decoded in parallel, and messages that are logged
+         * while decoding are passed on to the given logger on the calling thread once the collection has been loaded.
+         */
         class TextureLoader {
         private:
+            std::unique_ptr<BufferedLogger> m_logger;
             std::vector<std::string> m_textureExtensions;
             std::unique_ptr<TextureReader> m_textureReader;
             std::unique_ptr<TextureCollectionLoader> m_textureCollectionLoader;
@@ -105,7 +105,7 @@ namespace TrenchBroom {
                 }
 
                 const auto path = IO::Path(entryName).addExtension(entryType);
-                auto file = std::make_shared<FileView>(path, m_file, entryAddress, entrySize);
+                auto file = createFileView(path, entryAddress, entrySize);
                 m_root.addFile(path, file);
             }
         }
@@ -19,37 +19,82 @@
 
 #include "ZipFileSystem.h"
 
+#include "Exceptions.h"
 #include "IO/File.h"
 #include "IO/DiskFileSystem.h"
+#include "IO/Reader.h"
+#include "IO/ReaderException.h"
+
+#include <kdl/invoke.h>
 
 #include <memory>
 #include <string>
 
 namespace TrenchBroom {
     namespace IO {
+        namespace ZipLayout {
+            static const uint32_t LocalHeaderSignature        = 0x04034b50;
+            static const size_t   LocalHeaderSize             = 0x1e;
+            static const size_t   LocalHeaderNameLengthOffset = 0x1a;
+        }
+
         // ZipFileSystem::ZipCompressedFile
 
-        ZipFileSystem::ZipCompressedFile::ZipCompressedFile(ZipFileSystem* owner, const mz_uint fileIndex) :
+        ZipFileSystem::ZipCompressedFile::ZipCompressedFile(const ZipFileSystem* owner, Path path, const mz_zip_archive_file_stat& stat) :
         m_owner(owner),
-        m_fileIndex(fileIndex) {}
+        m_path(std::move(path)),
+        m_localHeaderOffset(static_cast<size_t>(stat.m_local_header_ofs)),
+        m_compressedSize(static_cast<size_t>(stat.m_comp_size)),
+        m_uncompressedSize(static_cast<size_t>(stat.m_uncomp_size)),
+        m_method(stat.m_method),
+        m_crc32(stat.m_crc32),
+        m_supported(stat.m_is_supported && !stat.m_is_encrypted) {}
 
         std::shared_ptr<File> ZipFileSystem::ZipCompressedFile::doOpen() const {
-            const auto path = Path(m_owner->filename(m_fileIndex));
+            if (!m_supported || (m_method != 0 && m_method != MZ_DEFLATED)) {
+                throw FileSystemException("Unsupported compression method for " + m_path.asString());
+            }
 
-            mz_zip_archive_file_stat stat;
-            if (!mz_zip_reader_file_stat(&m_owner->m_archive, m_fileIndex, &stat)) {
-                throw FileSystemException("mz_zip_reader_file_stat failed for " + path.asString());
+            const auto compressedFile = m_owner->createFileView(m_path, findData(), m_compressedSize);
+            if (m_method == 0) {
+                // stored files are used in place
+                return compressedFile;
             }
 
-            const auto uncompressedSize = static_cast<size_t>(stat.m_uncomp_size);
-            auto data = std::make_unique<char[]>(uncompressedSize);
+            auto data = std::make_unique<char[]>(m_uncompressedSize);
             auto* begin = data.get();
 
-            if (!mz_zip_reader_extract_to_mem(&m_owner->m_archive, m_fileIndex, begin, uncompressedSize, 0)) {
-                throw FileSystemException("mz_zip_reader_extract_to_mem failed for " + path.asString());
+            const auto reader = compressedFile->reader().buffer();
+            const auto size = tinfl_decompress_mem_to_mem(begin, m_uncompressedSize, reader.begin(), reader.size(), 0);
+            if (size != m_uncompressedSize || mz_crc32(MZ_CRC32_INIT, reinterpret_cast<const unsigned char*>(begin), m_uncompressedSize) != m_crc32) {
+                throw FileSystemException("Failed to decompress " + m_path.asString());
             }
 
-            return std::make_shared<OwningBufferFile>(path, std::move(data), uncompressedSize);
+            return std::make_shared<OwningBufferFile>(m_path, std::move(data), m_uncompressedSize);
+        }
+
+        size_t ZipFileSystem::ZipCompressedFile::doGetDecompressedSize() const {
+            return m_method == MZ_DEFLATED ? m_uncompressedSize : 0u;
+        }
+
+        /**
+         * Returns the offset of the file data in the archive. The data follows the local header, whose name and extra
+         * field may differ in length from those in the central directory.
+         */
+        size_t ZipFileSystem::ZipCompressedFile::findData() const {
+            try {
+                auto reader = m_owner->m_file->reader().subReaderFromBegin(m_localHeaderOffset, ZipLayout::LocalHeaderSize);
+                if (reader.readUnsignedInt<uint32_t>() != ZipLayout::LocalHeaderSignature) {
+                    throw FileSystemException("Invalid local header for " + m_path.asString());
+                }
+
+                reader.seekFromBegin(ZipLayout::LocalHeaderNameLengthOffset);
+                const auto nameLength = reader.readSize<uint16_t>();
+                const auto extraLength = reader.readSize<uint16_t>();
+                return m_localHeaderOffset + ZipLayout::LocalHeaderSize + nameLength + extraLength;
+            } catch (const ReaderException& e) {
+                throw FileSystemException("Invalid local header for " + m_path.asString() + ": " + e.what());
+            }
         }
 
         // ZipFileSystem
@@ -62,37 +107,12 @@ namespace TrenchBroom {
             initialize();
         }
 
-        ZipFileSystem::~ZipFileSystem() {
-            mz_zip_reader_end(&m_archive);
-        }
-
-        void ZipFileSystem::doReadDirectory() {
-            mz_zip_zero_struct(&m_archive);
-
-            if (mz_zip_reader_init_cfile(&m_archive, m_file->file(), m_file->size(), 0) != MZ_TRUE) {
-                throw FileSystemException("Error calling mz_zip_reader_init_cfile");
-            }
-
-            const mz_uint numFiles = mz_zip_reader_get_num_files(&m_archive);
-            for (mz_uint i = 0; i < numFiles; ++i) {
-                if (!mz_zip_reader_is_file_a_directory(&m_archive, i)) {
-                    const auto path = Path(filename(i));
-                    m_root.addFile(path, std::make_unique<ZipCompressedFile>(this, i));
-                }
-            }
-
-            const auto err = mz_zip_get_last_error(&m_archive);
-            if (err != MZ_ZIP_NO_ERROR) {
-                throw FileSystemException(std::string("Error while reading compressed file: ") + mz_zip_get_error_string(err));
-            }
-        }
-
         /**
          * Helper to get the filename of a file in the zip archive
          */
-        std::string ZipFileSystem::filename(const mz_uint fileIndex) {
+        static std::string filename(mz_zip_archive& archive, const mz_uint fileIndex) {
             // nameLen includes space for the null-terminator byte
-            const mz_uint nameLen = mz_zip_reader_get_filename(&m_archive, fileIndex, nullptr, 0);
+            const mz_uint nameLen = mz_zip_reader_get_filename(&archive, fileIndex, nullptr, 0);
             if (nameLen == 0) {
                 return "";
             }
@@ -101,9 +121,39 @@ namespace TrenchBroom {
             result.resize(static_cast<size_t>(nameLen - 1));
 
             // NOTE: this will overwrite the std::string's null terminator, which is permitted in C++17 and later
-            mz_zip_reader_get_filename(&m_archive, fileIndex, result.data(), nameLen);
+            mz_zip_reader_get_filename(&archive, fileIndex, result.data(), nameLen);
 
             return result;
         }
+
+        void ZipFileSystem::doReadDirectory() {
+            // the archive is only needed to read the central directory, the files are read from the mapped file
+            mz_zip_archive archive;
+            mz_zip_zero_struct(&archive);
+
+            if (mz_zip_reader_init_mem(&archive, m_file->begin(), m_file->size(), 0) != MZ_TRUE) {
+                throw FileSystemException("Error calling mz_zip_reader_init_mem");
+            }
+            const auto endArchive = kdl::invoke_later([&]() { mz_zip_reader_end(&archive); });
+
+            const mz_uint numFiles = mz_zip_reader_get_num_files(&archive);
+            for (mz_uint i = 0; i < numFiles; ++i) {
+                if (!mz_zip_reader_is_file_a_directory(&archive, i)) {
+                    const auto path = Path(filename(archive, i));
+
+                    mz_zip_archive_file_stat stat;
+                    if (!mz_zip_reader_file_stat(&archive, i, &stat)) {
+                        throw FileSystemException("mz_zip_reader_file_stat failed for " + path.asString());
+                    }
+
+                    m_root.addFile(path, std::make_unique<ZipCompressedFile>(this, path, stat));
+                }
+            }
+
+            const auto err = mz_zip_get_last_error(&archive);
+            if (err != MZ_ZIP_NO_ERROR) {
+                throw FileSystemException(std::string("Error while reading compressed file: ") + mz_zip_get_error_string(err));
+            }
+        }
     }
 }
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "IO/ImageFileSystem.h"
+#include "IO/Path.h"
 
 #include <memory>
 
@@ -27,31 +28,36 @@
 
 namespace TrenchBroom {
     namespace IO {
-        class Path;
-
         class ZipFileSystem : public ImageFileSystem {
         private:
-            mz_zip_archive m_archive;
-        private:
+            /**
+             * A file in the archive. Its contents are read directly from the mapped archive file rather than through
+             * miniz, so that several files can be decompressed in parallel.
+             */
             class ZipCompressedFile : public FileEntry {
             private:
-                ZipFileSystem* m_owner;
-                mz_uint m_fileIndex;
+                const ZipFileSystem* m_owner;
+                Path m_path;
+                size_t m_localHeaderOffset;
+                size_t m_compressedSize;
+                size_t m_uncompressedSize;
+                mz_uint16 m_method;
+                mz_uint32 m_crc32;
+                bool m_supported;
             public:
-                ZipCompressedFile(ZipFileSystem* owner, mz_uint fileIndex);
+                ZipCompressedFile(const ZipFileSystem* owner, Path path, const mz_zip_archive_file_stat& stat);
             private:
                 std::shared_ptr<File> doOpen() const override;
+                size_t doGetDecompressedSize() const override;
+
+                size_t findData() const;
             };
             friend class ZipCompressedFile;
         public:
             explicit ZipFileSystem(const Path& path);
             ZipFileSystem(std::shared_ptr<FileSystem> next, const Path& path);
-            ~ZipFileSystem() override;
         private:
             void doReadDirectory() override;
-        private:
-            std::string filename(mz_uint fileIndex);
         };
     }
 }
-
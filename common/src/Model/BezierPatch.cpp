@@ -22,9 +22,9 @@
 #include "Ensure.h"
 #include "Assets/Texture.h"
 
-#include <vecmath/bezier_surface.h>
 #include <vecmath/vec_io.h>
 
+#include <array>
 #include <cassert>
 #include <iostream>
 
@@ -132,58 +132,48 @@ namespace TrenchBroom {
             m_bounds = builder.bounds();
         }
 
-        using SurfaceControlPoints = std::array<std::array<BezierPatch::Point, 3u>, 3u>;
-        static SurfaceControlPoints collectSurfaceControlPoints(const std::vector<BezierPatch::Point>& controlPoints, const size_t pointColumnCount, const size_t surfaceRow, const size_t surfaceCol) {
-            // at which column and row do we need to start collecting control points for the surface?
-            const size_t rowOffset = 2u * surfaceRow;
-            const size_t colOffset = 2u * surfaceCol;
-
-            // collect 3*3 control points
-            auto result = SurfaceControlPoints{};
-            for (size_t row = 0; row < 3u; ++row) {
-                for (size_t col = 0; col < 3u; ++col) {
-                    result[row][col] = controlPoints[(row + rowOffset) * pointColumnCount + col + colOffset];
-                }
-            }
-            return result;
-        }
+        using BasisTable = std::vector<std::array<FloatType, 3u>>;
 
-        static std::vector<SurfaceControlPoints> collectAllSurfaceControlPoints(const std::vector<BezierPatch::Point>& controlPoints, const size_t pointRowCount, const size_t pointColumnCount) {
-            // determine how many 3*3 surfaces the patch has in each direction
-            const size_t surfaceRowCount = (pointRowCount - 1u) / 2u;
-            const size_t surfaceColumnCount = (pointColumnCount - 1u) / 2u;
+        /**
+         * Computes the values of the three quadratic Bernstein polynomials at each of the given number of equidistant
+         * parameter values in [0, 1], including both 0 and 1.
+         */
+        static BasisTable computeBasisTable(const size_t quadsPerSurfaceSide) {
+            auto result = BasisTable{};
+            result.reserve(quadsPerSurfaceSide + 1u);
 
-            // collect the control points for each surface
-            auto result = std::vector<SurfaceControlPoints>{};
-            result.reserve(surfaceRowCount * surfaceColumnCount);
-
-            for (size_t surfaceRow = 0u; surfaceRow < surfaceRowCount; ++surfaceRow) {
-                for (size_t surfaceCol = 0u; surfaceCol < surfaceColumnCount; ++surfaceCol) {
-                    result.push_back(collectSurfaceControlPoints(controlPoints, pointColumnCount, surfaceRow, surfaceCol));
-                }
+            for (size_t i = 0u; i <= quadsPerSurfaceSide; ++i) {
+                const auto t = static_cast<FloatType>(i) / static_cast<FloatType>(quadsPerSurfaceSide);
+                const auto s = static_cast<FloatType>(1) - t;
+                result.push_back({s * s, static_cast<FloatType>(2) * s * t, t * t});
             }
             return result;
         }
 
-        template <typename O>
-        void evaluateSurface(const SurfaceControlPoints& surfaceControlPoints, const size_t subdivisionsPerSurface, const bool isLastCol, const bool isLastRow, O out) {
-            const auto maxRow = isLastRow ? subdivisionsPerSurface + 1u : subdivisionsPerSurface;
-            const auto maxCol = isLastCol ? subdivisionsPerSurface + 1u : subdivisionsPerSurface;
+        // the tables for these subdivision levels are computed once and shared by all patches
+        constexpr static size_t CachedBasisTableCount = 8u;
 
-            for (size_t row = 0u; row < maxRow; ++row) {
-                const auto v = static_cast<FloatType>(row) / static_cast<FloatType>(subdivisionsPerSurface);
-                for (size_t col = 0u; col < maxCol; ++col) {
-                    const auto u = static_cast<FloatType>(col) / static_cast<FloatType>(subdivisionsPerSurface);
-                    out = vm::evaluate_quadratic_bezier_surface(surfaceControlPoints, u, v);
+        static const BasisTable& cachedBasisTable(const size_t subdivisionsPerSurface) {
+            static const auto tables = []() {
+                auto result = std::array<BasisTable, CachedBasisTableCount>{};
+                for (size_t i = 0u; i < CachedBasisTableCount; ++i) {
+                    result[i] = computeBasisTable(size_t(1) << i);
                 }
-            }
+                return result;
+            }();
+
+            assert(subdivisionsPerSurface < CachedBasisTableCount);
+            return tables[subdivisionsPerSurface];
         }
 
         std::vector<BezierPatch::Point> BezierPatch::evaluate(const size_t subdivisionsPerSurface) const {
-            // collect the control points for each surface in this patch
-            const auto allSurfaceControlPoints = collectAllSurfaceControlPoints(m_controlPoints, m_pointRowCount, m_pointColumnCount);
+            const auto quadsPerSurfaceSide = (size_t(1) << subdivisionsPerSurface);
 
-            const auto quadsPerSurfaceSide = (1u << subdivisionsPerSurface);
+            // the Bernstein polynomials only depend on the subdivision level, so they are evaluated once per level
+            auto uncachedBasis = BasisTable{};
+            const auto& basis = subdivisionsPerSurface < CachedBasisTableCount
+                ? cachedBasisTable(subdivisionsPerSurface)
+                : (uncachedBasis = computeBasisTable(quadsPerSurfaceSide));
 
             // determine dimensions of the resulting point grid
             const size_t gridPointRowCount = surfaceRowCount() * quadsPerSurfaceSide + 1u;
@@ -237,17 +227,32 @@ namespace TrenchBroom {
             value of v
             */
 
+            const auto blend = [](const std::array<FloatType, 3u>& weights, const Point& p0, const Point& p1, const Point& p2) {
+                return weights[0] * p0 + weights[1] * p1 + weights[2] * p2;
+            };
+
+            // the control points blended in v direction for the current grid row, one per control point column
+            auto rowPoints = std::vector<Point>(m_pointColumnCount);
+
             for (size_t gridRow = 0u; gridRow < gridPointRowCount; ++gridRow) {
                 const size_t surfaceRow = (gridRow > 0u ? gridRow - 1u : gridRow) / quadsPerSurfaceSide;
-                const FloatType v = static_cast<FloatType>(gridRow - surfaceRow * quadsPerSurfaceSide) / static_cast<FloatType>(quadsPerSurfaceSide);
-                
+                const auto& v = basis[gridRow - surfaceRow * quadsPerSurfaceSide];
+
+                for (size_t col = 0u; col < m_pointColumnCount; ++col) {
+                    rowPoints[col] = blend(v,
+                        controlPoint(2u * surfaceRow,      col),
+                        controlPoint(2u * surfaceRow + 1u, col),
+                        controlPoint(2u * surfaceRow + 2u, col));
+                }
+
                 for (size_t gridCol = 0u; gridCol < gridPointColumnCount; ++gridCol) {
                     const size_t surfaceCol = (gridCol > 0u ? gridCol - 1u : gridCol) / quadsPerSurfaceSide;
-                    const FloatType u = static_cast<FloatType>(gridCol - surfaceCol * quadsPerSurfaceSide) / static_cast<FloatType>(quadsPerSurfaceSide);
+                    const auto& u = basis[gridCol - surfaceCol * quadsPerSurfaceSide];
 
-                    const auto& surfaceControlPoints = allSurfaceControlPoints[surfaceRow * surfaceColumnCount() + surfaceCol];
-                    auto point = vm::evaluate_quadratic_bezier_surface(surfaceControlPoints, u, v);
-                    grid.push_back(std::move(point));
+                    grid.push_back(blend(u,
+                        rowPoints[2u * surfaceCol],
+                        rowPoints[2u * surfaceCol + 1u],
+                        rowPoints[2u * surfaceCol + 2u]));
                 }
             }
 
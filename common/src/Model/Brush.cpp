@@ -29,6 +29,7 @@
 #include "Model/MapFormat.h"
 #include "Model/TexCoordSystem.h"
 
+#include <kdl/overload.h>
 #include <kdl/result.h>
 #include <kdl/result_for_each.h>
 #include <kdl/string_utils.h>
@@ -58,11 +59,13 @@ namespace TrenchBroom {
             }
         };
 
-        Brush::Brush() {}
+        Brush::Brush() :
+        m_geometryIsReproducible(false) {}
 
         Brush::Brush(const Brush& other) :
         m_faces(other.m_faces),
-        m_geometry(other.m_geometry ? std::make_unique<BrushGeometry>(*other.m_geometry, CopyCallback()) : nullptr) {
+        m_geometry(other.m_geometry ? std::make_unique<BrushGeometry>(*other.m_geometry, CopyCallback()) : nullptr),
+        m_geometryIsReproducible(other.m_geometryIsReproducible) {
             if (m_geometry) {
                 for (BrushFaceGeometry* faceGeometry : m_geometry->faces()) {
                     if (const auto faceIndex = faceGeometry->payload()) {
@@ -75,7 +78,8 @@ namespace TrenchBroom {
 
         Brush::Brush(Brush&& other) noexcept :
         m_faces(std::move(other.m_faces)),
-        m_geometry(std::move(other.m_geometry)) {}
+        m_geometry(std::move(other.m_geometry)),
+        m_geometryIsReproducible(other.m_geometryIsReproducible) {}
 
         Brush& Brush::operator=(Brush other) noexcept {
             using std::swap;
@@ -87,12 +91,14 @@ namespace TrenchBroom {
             using std::swap;
             swap(lhs.m_faces, rhs.m_faces);
             swap(lhs.m_geometry, rhs.m_geometry);
+            swap(lhs.m_geometryIsReproducible, rhs.m_geometryIsReproducible);
         }
         
         Brush::~Brush() = default;
 
         Brush::Brush(std::vector<BrushFace> faces) :
-        m_faces(std::move(faces)) {}
+        m_faces(std::move(faces)),
+        m_geometryIsReproducible(false) {}
 
         kdl::result<Brush, BrushError> Brush::create(const vm::bbox3& worldBounds, std::vector<BrushFace> faces) {
             Brush brush(std::move(faces));
@@ -104,39 +110,52 @@ namespace TrenchBroom {
             // First, add all faces to the brush geometry
             BrushFace::sortFaces(m_faces);
             
-            auto geometry = std::make_unique<BrushGeometry>(worldBounds);
-            
-            for (size_t i = 0u; i < m_faces.size(); ++i) {
-                BrushFace& face = m_faces[i];
-                const auto result = geometry->clip(face.boundary());
-                if (result.success()) {
-                    BrushFaceGeometry* faceGeometry = result.face();
-                    face.setGeometry(faceGeometry);
-                    faceGeometry->setPayload(i);
-                } else  if (result.empty()) {
-                    return BrushError::EmptyBrush;
+            auto geometry = buildGeometryFromPlanes(worldBounds);
+            if (geometry == nullptr) {
+                // Fall back to clipping the world bounds with every face
+                geometry = std::make_unique<BrushGeometry>(worldBounds);
+
+                for (size_t i = 0u; i < m_faces.size(); ++i) {
+                    BrushFace& face = m_faces[i];
+                    const auto result = geometry->clip(face.boundary());
+                    if (result.success()) {
+                        BrushFaceGeometry* faceGeometry = result.face();
+                        face.setGeometry(faceGeometry);
+                        faceGeometry->setPayload(i);
+                    } else  if (result.empty()) {
+                        return BrushError::EmptyBrush;
+                    }
                 }
-            }
 
-            // Correct vertex positions and heal short edges
-            geometry->correctVertexPositions();
-            if (!geometry->healEdges()) {
-                return BrushError::InvalidBrush;
+                // Correct vertex positions and heal short edges
+                geometry->correctVertexPositions();
+                if (!geometry->healEdges()) {
+                    return BrushError::InvalidBrush;
+                }
             }
             
-            // Now collect all faces which still remain
-            std::vector<BrushFace> remainingFaces;
-            remainingFaces.reserve(m_faces.size());
-            
+            // Now collect all faces which still remain. They are kept in sorted order because the order of the
+            // geometry's faces depends on how the geometry was built.
+            std::vector<BrushFaceGeometry*> remainingGeometries(m_faces.size(), nullptr);
             for (BrushFaceGeometry* faceGeometry : geometry->faces()) {
                 if (const auto faceIndex = faceGeometry->payload()) {
-                    remainingFaces.push_back(std::move(m_faces[*faceIndex]));
-                    faceGeometry->setPayload(remainingFaces.size() - 1u);
+                    remainingGeometries[*faceIndex] = faceGeometry;
                 } else {
                     return BrushError::IncompleteBrush;
                 }
             }
 
+            std::vector<BrushFace> remainingFaces;
+            remainingFaces.reserve(m_faces.size());
+            
+            for (size_t i = 0u; i < m_faces.size(); ++i) {
+                if (BrushFaceGeometry* faceGeometry = remainingGeometries[i]) {
+                    remainingFaces.push_back(std::move(m_faces[i]));
+                    faceGeometry->setPayload(remainingFaces.size() - 1u);
+                }
+            }
+
+            m_geometryIsReproducible = remainingFaces.size() == m_faces.size();
             m_faces = std::move(remainingFaces);
             m_geometry = std::move(geometry);
             
@@ -145,11 +164,71 @@ namespace TrenchBroom {
             return kdl::void_success;
         }
         
+        /**
+         * Builds the geometry directly from the face boundaries if that yields the same result as clipping the world
+         * bounds with them, i.e. if the brush has integer vertices and lies strictly inside the world bounds. Returns
+         * null otherwise.
+         */
+        std::unique_ptr<BrushGeometry> Brush::buildGeometryFromPlanes(const vm::bbox3& worldBounds) {
+            std::vector<vm::plane3> planes;
+            planes.reserve(m_faces.size());
+            for (const BrushFace& face : m_faces) {
+                planes.push_back(face.boundary());
+            }
+
+            std::vector<BrushFaceGeometry*> faceGeometries;
+            auto geometry = BrushGeometry::fromPlanes(planes, faceGeometries);
+            if (!geometry) {
+                return nullptr;
+            }
+
+            // If the brush touches or exceeds the world bounds, clipping would retain faces of the world bounds.
+            const auto epsilon = vm::constants<FloatType>::point_status_epsilon();
+            const auto& bounds = geometry->bounds();
+            for (size_t i = 0u; i < 3u; ++i) {
+                if (bounds.min[i] <= worldBounds.min[i] + epsilon || bounds.max[i] >= worldBounds.max[i] - epsilon) {
+                    return nullptr;
+                }
+            }
+
+            auto result = std::make_unique<BrushGeometry>(std::move(*geometry));
+            for (size_t i = 0u; i < m_faces.size(); ++i) {
+                if (BrushFaceGeometry* faceGeometry = faceGeometries[i]) {
+                    m_faces[i].setGeometry(faceGeometry);
+                    faceGeometry->setPayload(i);
+                }
+            }
+            return result;
+        }
+
         const vm::bbox3& Brush::bounds() const {
             ensure(m_geometry != nullptr, "geometry is null");
             return m_geometry->bounds();
         }
 
+        bool Brush::hasGeometry() const {
+            return m_geometry != nullptr;
+        }
+
+        bool Brush::discardGeometry() {
+            ensure(m_geometry != nullptr, "geometry is null");
+
+            if (!m_geometryIsReproducible) {
+                return false;
+            }
+
+            for (auto& face : m_faces) {
+                face.setGeometry(nullptr);
+            }
+            m_geometry.reset();
+            return true;
+        }
+
+        kdl::result<void, BrushError> Brush::restoreGeometry(const vm::bbox3& worldBounds) {
+            ensure(m_geometry == nullptr, "geometry is not null");
+            return updateGeometryFromFaces(worldBounds);
+        }
+
         std::optional<size_t> Brush::findFace(const std::string& textureName) const {
             return kdl::vec_index_of(m_faces, [&](const BrushFace& face) { return face.attributes().textureName() == textureName; });
         }
@@ -53,6 +53,13 @@ namespace TrenchBroom {
         private:
             std::vector<BrushFace> m_faces;
             std::unique_ptr<BrushGeometry> m_geometry;
+
+            /**
+             * Indicates whether building the geometry from the faces yields exactly the current geometry again. This
+             * is the case if no face was dropped when the geometry was last built, because the build is deterministic
+             * and the faces remain sorted.
+             */
+            bool m_geometryIsReproducible;
         public:
             Brush();
 
@@ -69,8 +76,32 @@ namespace TrenchBroom {
             Brush(std::vector<BrushFace> faces);
 
             kdl::result<void, BrushError> updateGeometryFromFaces(const vm::bbox3& worldBounds);
+            std::unique_ptr<BrushGeometry> buildGeometryFromPlanes(const vm::bbox3& worldBounds);
         public:
             const vm::bbox3& bounds() const;
+        public: // discarding and restoring the geometry
+            /**
+             * Indicates whether this brush has a geometry. Only brushes whose geometry was discarded have no geometry,
+             * and such brushes must not be used until their geometry is restored.
+             */
+            bool hasGeometry() const;
+
+            /**
+             * Discards the geometry of this brush to save memory, e.g. if the brush is stored in the undo history. The
+             * geometry is only discarded if rebuilding it from the faces yields exactly the same brush, which is known
+             * from the last time the geometry was built, so this does not rebuild the geometry.
+             *
+             * @return true if the geometry was discarded and false otherwise
+             */
+            bool discardGeometry();
+
+            /**
+             * Rebuilds the geometry of this brush after it was discarded.
+             *
+             * @param worldBounds the world bounds
+             * @return a void result or an error
+             */
+            kdl::result<void, BrushError> restoreGeometry(const vm::bbox3& worldBounds);
         public: // face management:
             std::optional<size_t> findFace(const std::string& textureName) const;
             std::optional<size_t> findFace(const vm::vec3& normal) const;
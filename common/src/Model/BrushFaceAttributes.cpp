@@ -21,50 +21,171 @@
 #include "Assets/Texture.h"
 
 #include <vecmath/vec.h>
+#include <vecmath/mat.h>
 
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 
 namespace TrenchBroom {
     namespace Model {
         const std::string BrushFaceAttributes::NoTextureName = "__TB_empty";
 
+        struct BrushFaceAttributes::Data : public std::enable_shared_from_this<Data> {
+            std::string textureName;
+
+            vm::vec2f offset;
+            vm::vec2f scale;
+            float rotation;
+
+            int surfaceContents;
+            int surfaceFlags;
+            float surfaceValue;
+
+            Color color;
+
+            // RB: Quake 3 / Doom 3 brush primitives that require the ComputeAxisBase rule for projection
+            bool bpMode;
+            vm::mat4x4f bpMatrix; // usually 2x3 affine transform in 2D space
+
+            explicit Data(std::string_view i_textureName) :
+            textureName(i_textureName),
+            offset(vm::vec2f::zero()),
+            scale(vm::vec2f(1.0f, 1.0f)),
+            rotation(0.0f),
+            surfaceContents(0),
+            surfaceFlags(0),
+            surfaceValue(0.0f),
+            bpMode(false),
+            bpMatrix(vm::mat4x4f::identity())
+            {}
+
+            Data(std::string_view i_textureName, const Data& other) :
+            Data(other) {
+                textureName = i_textureName;
+            }
+
+            Data(const Data& other) = default;
+
+            size_t hash() const {
+                size_t result = std::hash<std::string>{}(textureName);
+                const auto combine = [&](const auto& value) {
+                    using T = std::decay_t<decltype(value)>;
+                    result ^= std::hash<T>{}(value) + 0x9e3779b9 + (result << 6) + (result >> 2);
+                };
+
+                combine(offset.x());
+                combine(offset.y());
+                combine(scale.x());
+                combine(scale.y());
+                combine(rotation);
+                combine(surfaceContents);
+                combine(surfaceFlags);
+                combine(surfaceValue);
+                combine(color.r());
+                combine(color.g());
+                combine(color.b());
+                combine(color.a());
+                combine(bpMode);
+                for (size_t i = 0u; i < 4u; ++i) {
+                    for (size_t j = 0u; j < 4u; ++j) {
+                        combine(bpMatrix[i][j]);
+                    }
+                }
+                return result;
+            }
+
+            friend bool operator==(const Data& lhs, const Data& rhs) {
+                return (lhs.textureName == rhs.textureName &&
+                        lhs.offset == rhs.offset &&
+                        lhs.scale == rhs.scale &&
+                        lhs.rotation == rhs.rotation &&
+                        lhs.surfaceContents == rhs.surfaceContents &&
+                        lhs.surfaceFlags == rhs.surfaceFlags &&
+                        lhs.surfaceValue == rhs.surfaceValue &&
+                        lhs.color == rhs.color &&
+                        lhs.bpMode == rhs.bpMode &&
+                        lhs.bpMatrix == rhs.bpMatrix
+                    );
+            }
+        };
+
+        namespace {
+            /**
+             * A pool of shared immutable values. The values are distributed over several shards by their hash, and
+             * each shard has its own lock, so that threads which intern different values rarely wait for each other.
+             * Values are removed from the pool when their last reference is released.
+             */
+            template <typename T, size_t ShardCount = 32u>
+            class InternPool {
+            private:
+                struct Shard {
+                    std::mutex mutex;
+                    std::unordered_multimap<size_t, const T*> values;
+                };
+
+                std::array<Shard, ShardCount> m_shards;
+            public:
+                std::shared_ptr<T> intern(const T& value) {
+                    const auto hash = value.hash();
+                    auto& shard = m_shards[hash % ShardCount];
+
+                    std::lock_guard<std::mutex> lock(shard.mutex);
+                    const auto [first, last] = shard.values.equal_range(hash);
+                    for (auto it = first; it != last; ++it) {
+                        if (*it->second == value) {
+                            if (auto existing = it->second->weak_from_this().lock()) {
+                                return std::const_pointer_cast<T>(existing);
+                            }
+                            // the value is being destroyed on another thread, its deleter won't erase our replacement
+                            shard.values.erase(it);
+                            break;
+                        }
+                    }
+
+                    auto* result = new T(value);
+                    shard.values.emplace(hash, result);
+                    return std::shared_ptr<T>(result, [this, hash](T* released) {
+                        release(hash, released);
+                        delete released;
+                    });
+                }
+            private:
+                void release(const size_t hash, const T* value) {
+                    auto& shard = m_shards[hash % ShardCount];
+
+                    std::lock_guard<std::mutex> lock(shard.mutex);
+                    const auto [first, last] = shard.values.equal_range(hash);
+                    for (auto it = first; it != last; ++it) {
+                        if (it->second == value) {
+                            shard.values.erase(it);
+                            return;
+                        }
+                    }
+                }
+            };
+        }
+
         BrushFaceAttributes::BrushFaceAttributes(std::string_view textureName) :
-        m_textureName(textureName),
-        m_offset(vm::vec2f::zero()),
-        m_scale(vm::vec2f(1.0f, 1.0f)),
-        m_rotation(0.0f),
-        m_surfaceContents(0),
-        m_surfaceFlags(0),
-        m_surfaceValue(0.0f),
-        m_bpMode(false),
-        m_bpMatrix(vm::mat4x4f::identity()) 
-        {}
+        m_data(std::make_shared<Data>(textureName)),
+        m_interned(false) {}
 
         BrushFaceAttributes::BrushFaceAttributes(const BrushFaceAttributes& other) :
-        m_textureName(other.m_textureName),
-        m_offset(other.m_offset),
-        m_scale(other.m_scale),
-        m_rotation(other.m_rotation),
-        m_surfaceContents(other.m_surfaceContents),
-        m_surfaceFlags(other.m_surfaceFlags),
-        m_surfaceValue(other.m_surfaceValue),
-        m_color(other.m_color),
-        m_bpMode(other.m_bpMode),
-        m_bpMatrix(other.m_bpMatrix)
-        {}
+        m_data(other.m_interned ? other.m_data : intern(*other.m_data)),
+        m_interned(true) {}
+
+        BrushFaceAttributes::BrushFaceAttributes(BrushFaceAttributes&& other) noexcept :
+        m_data(std::exchange(other.m_data, emptyData())),
+        m_interned(std::exchange(other.m_interned, true)) {}
 
         BrushFaceAttributes::BrushFaceAttributes(std::string_view textureName, const BrushFaceAttributes& other) :
-        m_textureName(textureName),
-        m_offset(other.m_offset),
-        m_scale(other.m_scale),
-        m_rotation(other.m_rotation),
-        m_surfaceContents(other.m_surfaceContents),
-        m_surfaceFlags(other.m_surfaceFlags),
-        m_surfaceValue(other.m_surfaceValue),
-        m_color(other.m_color),
-        m_bpMode(other.m_bpMode),
-        m_bpMatrix(other.m_bpMatrix)
-        {}
+        m_data(intern(Data(textureName, *other.m_data))),
+        m_interned(true) {}
 
         BrushFaceAttributes& BrushFaceAttributes::operator=(BrushFaceAttributes other) {
             using std::swap;
@@ -73,47 +194,29 @@ namespace TrenchBroom {
         }
 
         bool operator==(const BrushFaceAttributes& lhs, const BrushFaceAttributes& rhs) {
-            return (lhs.m_textureName == rhs.m_textureName &&
-                    lhs.m_offset == rhs.m_offset &&
-                    lhs.m_scale == rhs.m_scale &&
-                    lhs.m_rotation == rhs.m_rotation &&
-                    lhs.m_surfaceContents == rhs.m_surfaceContents &&
-                    lhs.m_surfaceFlags == rhs.m_surfaceFlags &&
-                    lhs.m_surfaceValue == rhs.m_surfaceValue &&
-                    lhs.m_color == rhs.m_color && 
-                    lhs.m_bpMode == rhs.m_bpMode && 
-                    lhs.m_bpMatrix == rhs.m_bpMatrix
-                );
+            return lhs.m_data == rhs.m_data || *lhs.m_data == *rhs.m_data;
         }
 
         void swap(BrushFaceAttributes& lhs, BrushFaceAttributes& rhs) {
             using std::swap;
-            swap(lhs.m_textureName, rhs.m_textureName);
-            swap(lhs.m_offset, rhs.m_offset);
-            swap(lhs.m_scale, rhs.m_scale);
-            swap(lhs.m_rotation, rhs.m_rotation);
-            swap(lhs.m_surfaceContents, rhs.m_surfaceContents);
-            swap(lhs.m_surfaceFlags, rhs.m_surfaceFlags);
-            swap(lhs.m_surfaceValue, rhs.m_surfaceValue);
-            swap(lhs.m_color, rhs.m_color);
-            swap(lhs.m_bpMode, rhs.m_bpMode);
-            swap(lhs.m_bpMatrix, rhs.m_bpMatrix);
+            swap(lhs.m_data, rhs.m_data);
+            swap(lhs.m_interned, rhs.m_interned);
         }
 
         const std::string& BrushFaceAttributes::textureName() const {
-            return m_textureName;
+            return m_data->textureName;
         }
 
         const vm::vec2f& BrushFaceAttributes::offset() const {
-            return m_offset;
+            return m_data->offset;
         }
 
         float BrushFaceAttributes::xOffset() const {
-            return m_offset.x();
+            return m_data->offset.x();
         }
 
         float BrushFaceAttributes::yOffset() const {
-            return m_offset.y();
+            return m_data->offset.y();
         }
 
         vm::vec2f BrushFaceAttributes::modOffset(const vm::vec2f& offset, const vm::vec2f& textureSize) const {
@@ -121,19 +224,19 @@ namespace TrenchBroom {
         }
 
         const vm::vec2f& BrushFaceAttributes::scale() const {
-            return m_scale;
+            return m_data->scale;
         }
 
         float BrushFaceAttributes::xScale() const {
-            return m_scale.x();
+            return m_data->scale.x();
         }
 
         float BrushFaceAttributes::yScale() const {
-            return m_scale.y();
+            return m_data->scale.y();
         }
 
         float BrushFaceAttributes::rotation() const {
-            return m_rotation;
+            return m_data->rotation;
         }
 
         bool BrushFaceAttributes::hasSurfaceAttributes() const {
@@ -141,149 +244,182 @@ namespace TrenchBroom {
         }
 
         int BrushFaceAttributes::surfaceContents() const {
-            return m_surfaceContents;
+            return m_data->surfaceContents;
         }
 
         int BrushFaceAttributes::surfaceFlags() const {
-            return m_surfaceFlags;
+            return m_data->surfaceFlags;
         }
 
         float BrushFaceAttributes::surfaceValue() const {
-            return m_surfaceValue;
+            return m_data->surfaceValue;
         }
 
         bool BrushFaceAttributes::hasColor() const {
-            return m_color.a() > 0.0f;
+            return m_data->color.a() > 0.0f;
         }
         
         const Color& BrushFaceAttributes::color() const {
-            return m_color;
+            return m_data->color;
         }
 
         bool BrushFaceAttributes::valid() const {
-            return !vm::is_zero(m_scale.x(), vm::Cf::almost_zero()) && !vm::is_zero(m_scale.y(), vm::Cf::almost_zero());
+            return !vm::is_zero(m_data->scale.x(), vm::Cf::almost_zero()) && !vm::is_zero(m_data->scale.y(), vm::Cf::almost_zero());
         }
         
         bool BrushFaceAttributes::setTextureName(const std::string& textureName) {
-            if (textureName == m_textureName) {
+            if (textureName == m_data->textureName) {
                 return false;
             } else {
-                m_textureName = textureName;
+                mutableData().textureName = textureName;
                 return true;
             }
         }
 
         bool BrushFaceAttributes::setOffset(const vm::vec2f& offset) {
-            if (offset == m_offset) {
+            if (offset == m_data->offset) {
                 return false;
             } else {
-                m_offset = offset;
+                mutableData().offset = offset;
                 return true;
             }
         }
 
         bool BrushFaceAttributes::setXOffset(const float xOffset) {
-            if (xOffset == m_offset.x()) {
+            if (xOffset == m_data->offset.x()) {
                 return false;
             } else {
-                m_offset[0] = xOffset;
+                mutableData().offset[0] = xOffset;
                 return true;
             }
         }
 
         bool BrushFaceAttributes::setYOffset(const float yOffset) {
-            if (yOffset == m_offset.y()) {
+            if (yOffset == m_data->offset.y()) {
                 return false;
             } else {
-                m_offset[1] = yOffset;
+                mutableData().offset[1] = yOffset;
                 return true;
             }
         }
 
         bool BrushFaceAttributes::setScale(const vm::vec2f& scale) {
-            if (scale == m_scale) {
+            if (scale == m_data->scale) {
                 return false;
             } else {
-                m_scale = scale;
+                mutableData().scale = scale;
                 return true;
             }
         }
 
         bool BrushFaceAttributes::setXScale(const float xScale) {
-            if (xScale == m_scale.x()) {
+            if (xScale == m_data->scale.x()) {
                 return false;
             } else {
-                m_scale[0] = xScale;
+                mutableData().scale[0] = xScale;
                 return true;
             }
         }
 
         bool BrushFaceAttributes::setYScale(const float yScale) {
-            if (yScale == m_scale.y()) {
+            if (yScale == m_data->scale.y()) {
                 return false;
             } else {
-                m_scale[1] = yScale;
+                mutableData().scale[1] = yScale;
                 return true;
             }
         }
 
         bool BrushFaceAttributes::setRotation(const float rotation) {
-            if (rotation == m_rotation) {
+            if (rotation == m_data->rotation) {
                 return false;
             } else {
-                m_rotation = rotation;
+                mutableData().rotation = rotation;
                 return true;
             }
         }
 
         bool BrushFaceAttributes::setSurfaceContents(const int surfaceContents) {
-            if (surfaceContents == m_surfaceContents) {
+            if (surfaceContents == m_data->surfaceContents) {
                 return false;
             } else {
-                m_surfaceContents = surfaceContents;
+                mutableData().surfaceContents = surfaceContents;
                 return true;
             }
         }
 
         bool BrushFaceAttributes::setSurfaceFlags(const int surfaceFlags) {
-            if (surfaceFlags == m_surfaceFlags) {
+            if (surfaceFlags == m_data->surfaceFlags) {
                 return false;
             } else {
-                m_surfaceFlags = surfaceFlags;
+                mutableData().surfaceFlags = surfaceFlags;
                 return true;
             }
         }
 
         bool BrushFaceAttributes::setSurfaceValue(const float surfaceValue) {
-            if (surfaceValue == m_surfaceValue) {
+            if (surfaceValue == m_data->surfaceValue) {
                 return false;
             } else {
-                m_surfaceValue = surfaceValue;
+                mutableData().surfaceValue = surfaceValue;
                 return true;
             }
         }
 
         bool BrushFaceAttributes::setColor(const Color& color) {
-            if (color == m_color) {
+            if (color == m_data->color) {
                 return false;
             } else {
-                m_color = color;
+                mutableData().color = color;
                 return true;
             }
         }
 
+        bool BrushFaceAttributes::hasBrushPrimitMode() const {
+            return m_data->bpMode;
+        }
+
         bool BrushFaceAttributes::setBrushPrimitMatrix(const vm::mat4x4f& matrix) {
-            if( matrix == m_bpMatrix ) {
+            if (matrix == m_data->bpMatrix) {
                 return false;
             } else {
-                m_bpMode = true;
-                m_bpMatrix = matrix;
+                auto& data = mutableData();
+                data.bpMode = true;
+                data.bpMatrix = matrix;
                 return true;
             }
         }
 
         const vm::mat4x4f& BrushFaceAttributes::bpMatrix() const {
-            return m_bpMatrix;
+            return m_data->bpMatrix;
+        }
+
+        bool BrushFaceAttributes::sharesDataWith(const BrushFaceAttributes& other) const {
+            return m_data == other.m_data;
+        }
+
+        std::shared_ptr<BrushFaceAttributes::Data> BrushFaceAttributes::intern(const Data& data) {
+            if (!(data == data)) {
+                // NaN values can never be found in the pool again, so such records are not shared
+                return std::make_shared<Data>(data);
+            }
+
+            // never destroyed so that attributes can still be released during static destruction
+            static auto* pool = new InternPool<Data>();
+            return pool->intern(data);
+        }
+
+        const std::shared_ptr<BrushFaceAttributes::Data>& BrushFaceAttributes::emptyData() {
+            static const auto data = intern(Data(""));
+            return data;
+        }
+
+        BrushFaceAttributes::Data& BrushFaceAttributes::mutableData() {
+            if (m_interned) {
+                m_data = std::make_shared<Data>(*m_data);
+                m_interned = false;
+            }
+            return *m_data;
         }
     }
 }
@@ -24,6 +24,7 @@
 #include <vecmath/forward.h>
 #include <vecmath/mat.h>
 
+#include <memory>
 #include <string>
 #include <string_view>
 
@@ -37,25 +38,25 @@ namespace TrenchBroom {
         public:
             static const std::string NoTextureName;
         private:
-            std::string m_textureName;
+            struct Data;
 
-            vm::vec2f m_offset;
-            vm::vec2f m_scale;
-            float m_rotation;
-
-            int m_surfaceContents;
-            int m_surfaceFlags;
-            float m_surfaceValue;
-
-            Color m_color;
-
-            // RB: Quake 3 / Doom 3 brush primitives that require the ComputeAxisBase rule for projection
-            bool m_bpMode;
-            vm::mat4x4f m_bpMatrix; // usually 2x3 affine transform in 2D space
+            /**
+             * The attribute values. Data that is interned is shared with other attributes and must not be modified;
+             * a setter that changes a value replaces it with a private copy first. Data that is not interned is owned
+             * by this object alone and is modified in place.
+             */
+            std::shared_ptr<Data> m_data;
+            bool m_interned;
 
         public:
             explicit BrushFaceAttributes(std::string_view textureName);
             BrushFaceAttributes(const BrushFaceAttributes& other);
+
+            /**
+             * Takes over the values of the given attributes without interning them. The given attributes are left with
+             * an empty texture name and default values.
+             */
+            BrushFaceAttributes(BrushFaceAttributes&& other) noexcept;
             BrushFaceAttributes(std::string_view textureName, const BrushFaceAttributes& other);
 
             BrushFaceAttributes& operator=(BrushFaceAttributes other);
@@ -99,11 +100,30 @@ namespace TrenchBroom {
             bool setSurfaceValue(float surfaceValue);
             bool setColor(const Color& color);
 
-            bool hasBrushPrimitMode() const {
-                return m_bpMode;
-            }
+            bool hasBrushPrimitMode() const;
             bool setBrushPrimitMatrix(const vm::mat4x4f& matrix);
             const vm::mat4x4f& bpMatrix() const;
+
+            /**
+             * Indicates whether the given attributes share their values, i.e. whether they refer to the same interned
+             * record.
+             */
+            bool sharesDataWith(const BrushFaceAttributes& other) const;
+        private:
+            /**
+             * Returns the interned record that is equal to the given data, creating it if necessary.
+             */
+            static std::shared_ptr<Data> intern(const Data& data);
+
+            /**
+             * Returns the interned record with an empty texture name and default values.
+             */
+            static const std::shared_ptr<Data>& emptyData();
+
+            /**
+             * Ensures that m_data is not shared with other attributes so that it may be modified.
+             */
+            Data& mutableData();
         };
     }
 }
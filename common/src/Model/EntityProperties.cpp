@@ -25,7 +25,12 @@
 #include <kdl/vector_set.h>
 
 #include <iostream>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom {
@@ -84,21 +89,52 @@ namespace TrenchBroom {
             return kdl::cs::str_matches_glob(key, pattern);
         }
 
-        EntityProperty::EntityProperty() = default;
+        const std::string& internPropertyKey(const std::string& key) {
+            // the keys this thread has already looked up, so that repeated keys can be found without locking the pool
+            static thread_local std::unordered_map<std::string_view, const std::string*> cache;
+            if (const auto it = cache.find(key); it != std::end(cache)) {
+                return *it->second;
+            }
+
+            static std::shared_mutex mutex;
+            // the elements of an unordered_set are never moved, so it is safe to hand out references to them
+            static std::unordered_set<std::string> keys;
+
+            const std::string* interned = nullptr;
+            {
+                std::shared_lock<std::shared_mutex> lock(mutex);
+                if (const auto it = keys.find(key); it != std::end(keys)) {
+                    interned = &*it;
+                }
+            }
+
+            if (interned == nullptr) {
+                std::unique_lock<std::shared_mutex> lock(mutex);
+                interned = &*keys.insert(key).first;
+            }
+
+            cache.emplace(*interned, interned);
+            return *interned;
+        }
+
+        EntityProperty::EntityProperty() :
+        m_key(&internPropertyKey("")) {}
 
         EntityProperty::EntityProperty(const std::string& key, const std::string& value) :
-        m_key(key),
+        m_key(&internPropertyKey(key)),
         m_value(value) {}
 
         int EntityProperty::compare(const EntityProperty& rhs) const {
-            const int keyCmp = m_key.compare(rhs.m_key);
-            if (keyCmp != 0)
-                return keyCmp;
+            if (m_key != rhs.m_key) {
+                const int keyCmp = m_key->compare(*rhs.m_key);
+                if (keyCmp != 0)
+                    return keyCmp;
+            }
             return m_value.compare(rhs.m_value);
         }
 
         const std::string& EntityProperty::key() const {
-            return m_key;
+            return *m_key;
         }
 
         const std::string& EntityProperty::value() const {
@@ -106,7 +142,7 @@ namespace TrenchBroom {
         }
 
         bool EntityProperty::hasKey(std::string_view key) const {
-            return kdl::cs::str_is_equal(m_key, key);
+            return kdl::cs::str_is_equal(*m_key, key);
         }
 
         bool EntityProperty::hasValue(const std::string_view value) const {
@@ -118,7 +154,7 @@ namespace TrenchBroom {
         }
 
         bool EntityProperty::hasPrefix(const std::string_view prefix) const {
-            return kdl::cs::str_is_prefix(m_key, prefix);
+            return kdl::cs::str_is_prefix(*m_key, prefix);
         }
 
         bool EntityProperty::hasPrefixAndValue(const std::string_view prefix, const std::string_view value) const {
@@ -126,7 +162,7 @@ namespace TrenchBroom {
         }
 
         bool EntityProperty::hasNumberedPrefix(const std::string_view prefix) const {
-            return isNumberedProperty(prefix, m_key);
+            return isNumberedProperty(prefix, *m_key);
         }
 
         bool EntityProperty::hasNumberedPrefixAndValue(const std::string_view prefix, const std::string_view value) const {
@@ -134,7 +170,7 @@ namespace TrenchBroom {
         }
 
         void EntityProperty::setKey(const std::string& key) {
-            m_key = key;
+            m_key = &internPropertyKey(key);
         }
 
         void EntityProperty::setValue(const std::string& value) {
@@ -158,11 +194,12 @@ namespace TrenchBroom {
         }
 
         bool operator==(const EntityProperty& lhs, const EntityProperty& rhs) {
-            return lhs.compare(rhs) == 0;
+            // interned keys can be compared by address
+            return &lhs.key() == &rhs.key() && lhs.value() == rhs.value();
         }
 
         bool operator!=(const EntityProperty& lhs, const EntityProperty& rhs) {
-            return lhs.compare(rhs) != 0;
+            return !(lhs == rhs);
         }
 
         std::ostream& operator<<(std::ostream& str, const EntityProperty& prop) {
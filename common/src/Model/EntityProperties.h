@@ -75,9 +75,19 @@ namespace TrenchBroom {
 
         bool isNumberedProperty(std::string_view prefix, std::string_view key);
 
+        /**
+         * Returns the unique shared instance of the given property key. Property keys are repeated across many
+         * entities, so every key is stored only once for the lifetime of the program. Interned keys are equal if and
+         * only if their addresses are equal.
+         *
+         * This function is thread safe. Every thread caches the keys it has interned, so looking up a key again does
+         * not lock the shared pool.
+         */
+        const std::string& internPropertyKey(const std::string& key);
+
         class EntityProperty {
         private:
-            std::string m_key;
+            const std::string* m_key;
             std::string m_value;
         public:
             EntityProperty();
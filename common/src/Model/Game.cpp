@@ -54,6 +54,10 @@ namespace TrenchBroom {
             return doCheckAdditionalSearchPaths(searchPaths);
         }
 
+        void Game::invalidateFileSystemCaches() {
+            doInvalidateFileSystemCaches();
+        }
+
         const CompilationConfig& Game::compilationConfig() {
             return doCompilationConfig();
         }
@@ -86,6 +90,10 @@ namespace TrenchBroom {
             doWriteMap(world, path);
         }
 
+        void Game::writeMapToStream(WorldNode& world, std::ostream& stream) const {
+            doWriteMapToStream(world, stream);
+        }
+
         void Game::exportMap(WorldNode& world, const Model::ExportFormat format, const IO::Path& path) const {
             doExportMap(world, format, path);
         }
@@ -72,6 +72,12 @@ namespace TrenchBroom {
             using PathErrors = std::map<IO::Path, std::string>;
             PathErrors checkAdditionalSearchPaths(const std::vector<IO::Path>& searchPaths) const;
 
+            /**
+             * Discards any cached directory listings of the game file system so that files which were added, removed
+             * or renamed on disk are found again.
+             */
+            void invalidateFileSystemCaches();
+
             const CompilationConfig& compilationConfig();
 
             size_t maxPropertyLength() const;
@@ -98,6 +104,7 @@ namespace TrenchBroom {
             std::unique_ptr<WorldNode> newMap(MapFormat format, const vm::bbox3& worldBounds, Logger& logger) const;
             std::unique_ptr<WorldNode> loadMap(MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, Logger& logger) const;
             void writeMap(WorldNode& world, const IO::Path& path) const;
+            void writeMapToStream(WorldNode& world, std::ostream& stream) const;
             void exportMap(WorldNode& world, Model::ExportFormat format, const IO::Path& path) const;
         public: // parsing and serializing objects
             std::vector<Node*> parseNodes(const std::string& str, MapFormat mapFormat, const vm::bbox3& worldBounds, Logger& logger) const;
@@ -136,6 +143,7 @@ namespace TrenchBroom {
             virtual void doSetGamePath(const IO::Path& gamePath, Logger& logger) = 0;
             virtual void doSetAdditionalSearchPaths(const std::vector<IO::Path>& searchPaths, Logger& logger) = 0;
             virtual PathErrors doCheckAdditionalSearchPaths(const std::vector<IO::Path>& searchPaths) const = 0;
+            virtual void doInvalidateFileSystemCaches() = 0;
 
             virtual const CompilationConfig& doCompilationConfig() = 0;
             virtual size_t doMaxPropertyLength() const = 0;
@@ -147,6 +155,7 @@ namespace TrenchBroom {
             virtual std::unique_ptr<WorldNode> doNewMap(MapFormat format, const vm::bbox3& worldBounds, Logger& logger) const = 0;
             virtual std::unique_ptr<WorldNode> doLoadMap(MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, Logger& logger) const = 0;
             virtual void doWriteMap(WorldNode& world, const IO::Path& path) const = 0;
+            virtual void doWriteMapToStream(WorldNode& world, std::ostream& stream) const = 0;
             virtual void doExportMap(WorldNode& world, Model::ExportFormat format, const IO::Path& path) const = 0;
 
             virtual std::vector<Node*> doParseNodes(const std::string& str, MapFormat mapFormat, const vm::bbox3& worldBounds, Logger& logger) const = 0;
@@ -56,6 +56,9 @@ namespace TrenchBroom {
         }
 
         void GameFileSystem::reloadShaders() {
+            // pick up files that were added, removed or renamed since they were first looked up
+            invalidateCaches();
+
             if (m_shaderFS != nullptr) {
                 m_shaderFS->reload();
             }
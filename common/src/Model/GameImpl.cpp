@@ -119,6 +119,10 @@ namespace TrenchBroom {
             return result;
         }
 
+        void GameImpl::doInvalidateFileSystemCaches() {
+            m_fs.invalidateCaches();
+        }
+
         const CompilationConfig& GameImpl::doCompilationConfig() {
             return m_config.compilationConfig();
         }
@@ -192,21 +196,28 @@ namespace TrenchBroom {
         }
 
         void GameImpl::doWriteMap(WorldNode& world, const IO::Path& path, const bool exporting) const {
-            const auto mapFormatName = formatName(world.mapFormat());
-
             std::ofstream file = openPathAsOutputStream(path);
             if (!file) {
                 throw FileSystemException("Cannot open file: " + path.asString());
             }
-            IO::writeGameComment(file, gameName(), mapFormatName);
+            doWriteMapToStream(world, file, exporting);
+        }
+
+        void GameImpl::doWriteMap(WorldNode& world, const IO::Path& path) const {
+            doWriteMap(world, path, false);
+        }
+
+        void GameImpl::doWriteMapToStream(WorldNode& world, std::ostream& stream, const bool exporting) const {
+            const auto mapFormatName = formatName(world.mapFormat());
+            IO::writeGameComment(stream, gameName(), mapFormatName);
 
-            IO::NodeWriter writer(world, file);
+            IO::NodeWriter writer(world, stream);
             writer.setExporting(exporting);
             writer.writeMap();
         }
 
-        void GameImpl::doWriteMap(WorldNode& world, const IO::Path& path) const {
-            doWriteMap(world, path, false);
+        void GameImpl::doWriteMapToStream(WorldNode& world, std::ostream& stream) const {
+            doWriteMapToStream(world, stream, false);
         }
 
         void GameImpl::doExportMap(WorldNode& world, const Model::ExportFormat format, const IO::Path& path) const {
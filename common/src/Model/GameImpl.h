@@ -53,6 +53,7 @@ namespace TrenchBroom {
             void doSetGamePath(const IO::Path& gamePath, Logger& logger) override;
             void doSetAdditionalSearchPaths(const std::vector<IO::Path>& searchPaths, Logger& logger) override;
             PathErrors doCheckAdditionalSearchPaths(const std::vector<IO::Path>& searchPaths) const override;
+            void doInvalidateFileSystemCaches() override;
 
             const CompilationConfig& doCompilationConfig() override;
 
@@ -67,6 +68,8 @@ namespace TrenchBroom {
             std::unique_ptr<WorldNode> doLoadMap(MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, Logger& logger) const override;
             void doWriteMap(WorldNode& world, const IO::Path& path, bool exporting) const;
             void doWriteMap(WorldNode& world, const IO::Path& path) const override;
+            void doWriteMapToStream(WorldNode& world, std::ostream& stream, bool exporting) const;
+            void doWriteMapToStream(WorldNode& world, std::ostream& stream) const override;
             void doExportMap(WorldNode& world, Model::ExportFormat format, const IO::Path& path) const override;
 
             std::vector<Node*> doParseNodes(const std::string& str, MapFormat mapFormat, const vm::bbox3& worldBounds, Logger& logger) const override;
@@ -32,6 +32,7 @@
 #include <kdl/overload.h>
 #include <kdl/vector_utils.h>
 
+#include <atomic>
 #include <string>
 
 namespace TrenchBroom {
@@ -96,7 +97,8 @@ namespace TrenchBroom {
         }
 
         size_t Issue::nextSeqId() {
-            static size_t seqId = 0;
+            // issues are generated in parallel
+            static std::atomic<size_t> seqId = 0;
             return seqId++;
         }
 
@@ -19,22 +19,31 @@
 
 #include "ModelUtils.h"
 
+#include "AABBTree.h"
 #include "Ensure.h"
 #include "Polyhedron.h"
+#include "Model/BezierPatch.h"
 #include "Model/Brush.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushFaceHandle.h"
+#include "Model/BrushGeometry.h"
 #include "Model/BrushNode.h"
 #include "Model/EditorContext.h"
+#include "Model/Entity.h"
 #include "Model/EntityNode.h"
+#include "Model/EntityProperties.h"
 #include "Model/GroupNode.h"
 #include "Model/LayerNode.h"
+#include "Model/NodeContents.h"
 #include "Model/PatchNode.h"
 #include "Model/WorldNode.h"
 
 #include <kdl/overload.h>
 #include <kdl/vector_utils.h>
 
+#include <unordered_map>
+#include <variant>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom {
@@ -232,14 +241,18 @@ namespace TrenchBroom {
          * in the given vector of brushes such that the predicate evaluates to true for that pair of
          * node and brush.
          *
+         * Closed groups are tested against all given brushes. For brushes, patches and entities,
+         * the given function `candidateBrushes` returns the brushes to test, which allows the caller
+         * to skip brushes which cannot match a node.
+         *
          * The given predicate must be a function that maps a node and a brush to true or false.
          */
-        template <typename P>
-        static std::vector<Node*> collectMatchingNodes(const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes, const P& predicate) {
+        template <typename P, typename C>
+        static std::vector<Node*> collectMatchingNodes(const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes, const P& predicate, const C& candidateBrushes) {
             auto result = std::vector<Model::Node*>{};
 
-            const auto collectIfMatching = [&](auto* node) {
-                for (const auto* brush : brushes) {
+            const auto collectIfMatching = [&](auto* node, const std::vector<BrushNode*>& brushesToTest) {
+                for (const auto* brush : brushesToTest) {
                     if (predicate(node, brush)) {
                         result.push_back(node);
                         return;
@@ -247,6 +260,8 @@ namespace TrenchBroom {
                 }
             };
 
+            const auto brushSet = std::unordered_set<const Node*>{std::begin(brushes), std::end(brushes)};
+
             for (auto* node : nodes) {
                 node->accept(kdl::overload(
                     [] (auto&& thisLambda, Model::WorldNode* world) { world->visitChildren(thisLambda); },
@@ -255,25 +270,25 @@ namespace TrenchBroom {
                         if (group->opened()) {
                             group->visitChildren(thisLambda);
                         } else {
-                            collectIfMatching(group);
+                            collectIfMatching(group, brushes);
                         }
                     },
                     [&](auto&& thisLambda, Model::EntityNode* entity) { 
                         if (entity->hasChildren()) {
                             entity->visitChildren(thisLambda);
                         } else {
-                            collectIfMatching(entity);
+                            collectIfMatching(entity, candidateBrushes(entity));
                         }
                     },
                     [&](Model::BrushNode* brush)  { 
                         // if `brush` is one of the search query nodes, don't count it as touching
-                        if (!kdl::vec_contains(brushes, brush)) {
-                            collectIfMatching(brush);
+                        if (brushSet.count(brush) == 0u) {
+                            collectIfMatching(brush, candidateBrushes(brush));
                         }
                     },
                     [&](Model::PatchNode* patch)  { 
                         // if `patch` is one of the search query nodes, don't count it as touching
-                        collectIfMatching(patch);
+                        collectIfMatching(patch, candidateBrushes(patch));
                     }
                 ));
             }
@@ -281,18 +296,58 @@ namespace TrenchBroom {
             return result;
         }
 
-        std::vector<Node*> collectTouchingNodes(const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes) {
-            return collectMatchingNodes(nodes, brushes, [](const auto* node, const auto* brush) {
-                return brush->intersects(node);
+        template <typename P>
+        static std::vector<Node*> collectMatchingNodes(const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes, const P& predicate) {
+            return collectMatchingNodes(nodes, brushes, predicate, [&](const Node*) -> const std::vector<BrushNode*>& {
+                return brushes;
             });
         }
 
-        std::vector<Node*> collectContainedNodes(const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes) {
-            return collectMatchingNodes(nodes, brushes, [](const auto* node, const auto* brush) {
-                return brush->contains(node);
+        /**
+         * Collects the nodes of the given world that match the given predicate as above. Since a node can only match a
+         * brush if their bounds intersect, the world's node tree is used to find the brushes that each node is tested
+         * against.
+         */
+        template <typename P>
+        static std::vector<Node*> collectMatchingNodes(WorldNode& world, const std::vector<BrushNode*>& brushes, const P& predicate) {
+            auto candidates = std::unordered_map<const Node*, std::vector<BrushNode*>>{};
+            for (auto* brush : brushes) {
+                for (const auto* node : world.nodeTree().findIntersectors(brush->physicalBounds())) {
+                    candidates[node].push_back(brush);
+                }
+            }
+
+            const auto noBrushes = std::vector<BrushNode*>{};
+            return collectMatchingNodes(std::vector<Node*>{&world}, brushes, predicate, [&](const Node* node) -> const std::vector<BrushNode*>& {
+                const auto it = candidates.find(node);
+                return it != std::end(candidates) ? it->second : noBrushes;
             });
         }
 
+        static bool touches(const Node* node, const BrushNode* brush) {
+            return brush->intersects(node);
+        }
+
+        static bool isContainedIn(const Node* node, const BrushNode* brush) {
+            return brush->contains(node);
+        }
+
+        std::vector<Node*> collectTouchingNodes(const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes) {
+            return collectMatchingNodes(nodes, brushes, touches);
+        }
+
+        std::vector<Node*> collectTouchingNodes(WorldNode& world, const std::vector<BrushNode*>& brushes) {
+            return collectMatchingNodes(world, brushes, touches);
+        }
+
+        std::vector<Node*> collectContainedNodes(const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes) {
+            return collectMatchingNodes(nodes, brushes, isContainedIn);
+        }
+
+        std::vector<Node*> collectContainedNodes(WorldNode& world, const std::vector<BrushNode*>& brushes) {
+            return collectMatchingNodes(world, brushes, isContainedIn);
+        }
+
         std::vector<Node*> collectSelectedNodes(const std::vector<Node*>& nodes) {
             auto selectedNodes = std::vector<Model::Node*>{};
             
@@ -458,5 +513,67 @@ namespace TrenchBroom {
             }
             return result;
         }
+   
+        static size_t estimateMemorySize(const Brush& brush) {
+            auto result = sizeof(Brush) + brush.faceCount() * sizeof(BrushFace);
+            if (brush.hasGeometry()) {
+                result += brush.vertexCount() * sizeof(BrushVertex)
+                    + brush.edgeCount() * (sizeof(BrushEdge) + 2u * sizeof(BrushHalfEdge))
+                    + brush.faceCount() * sizeof(BrushFaceGeometry);
+            }
+            return result;
+        }
+
+        static size_t estimateMemorySize(const Entity& entity) {
+            auto result = sizeof(Entity);
+            for (const auto& property : entity.properties()) {
+                // property keys are interned and shared among all entities
+                result += sizeof(EntityProperty) + property.value().capacity();
+            }
+            return result;
+        }
+
+        static size_t estimateMemorySize(const BezierPatch& patch) {
+            return sizeof(BezierPatch) + patch.controlPoints().size() * sizeof(BezierPatch::Point);
+        }
+
+        size_t estimateMemorySize(const NodeContents& contents) {
+            return std::visit(kdl::overload(
+                [](const Brush& brush)        { return estimateMemorySize(brush); },
+                [](const Entity& entity)      { return estimateMemorySize(entity); },
+                [](const BezierPatch& patch)  { return estimateMemorySize(patch); },
+                [](const auto& other)         { return sizeof(other); }
+            ), contents.get());
+        }
+
+        size_t estimateMemorySize(const std::vector<Node*>& nodes) {
+            auto result = size_t(0);
+            Node::visitAll(nodes, kdl::overload(
+                [&](auto&& thisLambda, WorldNode* world) {
+                    result += sizeof(WorldNode) - sizeof(Entity) + estimateMemorySize(world->entity());
+                    world->visitChildren(thisLambda);
+                },
+                [&](auto&& thisLambda, LayerNode* layer) {
+                    result += sizeof(LayerNode);
+                    layer->visitChildren(thisLambda);
+                },
+                [&](auto&& thisLambda, GroupNode* group) {
+                    result += sizeof(GroupNode);
+                    group->visitChildren(thisLambda);
+                },
+                [&](auto&& thisLambda, EntityNode* entity) {
+                    result += sizeof(EntityNode) - sizeof(Entity) + estimateMemorySize(entity->entity());
+                    entity->visitChildren(thisLambda);
+                },
+                [&](BrushNode* brush) {
+                    result += sizeof(BrushNode) - sizeof(Brush) + estimateMemorySize(brush->brush());
+                },
+                [&](PatchNode* patch) {
+                    result += sizeof(PatchNode) - sizeof(BezierPatch) + estimateMemorySize(patch->patch())
+                        + patch->grid().points.size() * sizeof(PatchGrid::Point);
+                }
+            ));
+            return result;
+        }
     }
 }
@@ -35,6 +35,7 @@ namespace TrenchBroom {
         class EditorContext;
         class LayerNode;
         class Node;
+        class NodeContents;
 
         HitType::Type nodeHitType();
 
@@ -70,6 +71,14 @@ namespace TrenchBroom {
         std::vector<Node*> collectTouchingNodes(const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes);
         std::vector<Node*> collectContainedNodes(const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes);
 
+        /**
+         * Collects the nodes of the given world which touch or are contained in one of the given brushes. The result is
+         * the same as for the overloads above when passed the world, but only nodes whose bounds intersect with the
+         * bounds of one of the given brushes are tested exactly. These nodes are found using the world's node tree.
+         */
+        std::vector<Node*> collectTouchingNodes(WorldNode& world, const std::vector<BrushNode*>& brushes);
+        std::vector<Node*> collectContainedNodes(WorldNode& world, const std::vector<BrushNode*>& brushes);
+
         std::vector<Node*> collectSelectedNodes(const std::vector<Node*>& nodes);
 
         std::vector<Node*> collectSelectableNodes(const std::vector<Node*>& nodes, const EditorContext& editorContext);
@@ -82,6 +91,16 @@ namespace TrenchBroom {
 
         std::vector<BrushNode*> filterBrushNodes(const std::vector<Node*>& nodes);
         std::vector<EntityNode*> filterEntityNodes(const std::vector<Node*>& nodes);
+
+        /**
+         * Returns an estimate of the memory used by the given node contents, in bytes.
+         */
+        size_t estimateMemorySize(const NodeContents& contents);
+
+        /**
+         * Returns an estimate of the memory used by the given nodes and their descendants, in bytes.
+         */
+        size_t estimateMemorySize(const std::vector<Node*>& nodes);
     }
 }
 
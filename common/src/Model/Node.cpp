@@ -30,6 +30,7 @@
 
 #include <vecmath/bbox.h>
 
+#include <algorithm>
 #include <cassert>
 #include <iterator>
 #include <ostream>
@@ -68,7 +69,7 @@ namespace TrenchBroom {
         m_lockState(LockState::Inherited),
         m_lineNumber(0),
         m_lineCount(0),
-        m_issuesValid(false),
+        m_validIssueTypes(0),
         m_hiddenIssues(0) {}
 
         Node::~Node() {
@@ -679,6 +680,12 @@ namespace TrenchBroom {
             return m_issues;
         }
 
+        bool Node::issuesValid(const std::vector<IssueGenerator*>& issueGenerators) const {
+            return std::all_of(std::begin(issueGenerators), std::end(issueGenerators), [&](const auto* generator) {
+                return (generator->type() & m_validIssueTypes) != 0;
+            });
+        }
+
         bool Node::issueHidden(const IssueType type) const {
             return (type & m_hiddenIssues) != 0;
         }
@@ -692,17 +699,17 @@ namespace TrenchBroom {
         }
 
         void Node::validateIssues(const std::vector<IssueGenerator*>& issueGenerators) {
-            if (!m_issuesValid) {
-                for (const auto* generator : issueGenerators) {
+            for (const auto* generator : issueGenerators) {
+                if ((generator->type() & m_validIssueTypes) == 0) {
                     doGenerateIssues(generator, m_issues);
+                    m_validIssueTypes |= generator->type();
                 }
-                m_issuesValid = true;
             }
         }
 
         void Node::invalidateIssues() const {
             clearIssues();
-            m_issuesValid = false;
+            m_validIssueTypes = 0;
         }
 
         void Node::clearIssues() const {
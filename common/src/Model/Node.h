@@ -69,7 +69,7 @@ namespace TrenchBroom {
             mutable size_t m_lineCount;
 
             mutable std::vector<Issue*> m_issues;
-            mutable bool m_issuesValid;
+            mutable IssueType m_validIssueTypes;
             IssueType m_hiddenIssues;
         protected:
             Node();
@@ -328,12 +328,25 @@ namespace TrenchBroom {
         public: // issue management
             const std::vector<Issue*>& issues(const std::vector<IssueGenerator*>& issueGenerators);
 
+            /**
+             * Indicates whether the issues of all of the given generators are up to date.
+             */
+            bool issuesValid(const std::vector<IssueGenerator*>& issueGenerators) const;
+
+            /**
+             * Runs those of the given generators whose issues are not up to date. The issues of the other generators
+             * are kept.
+             *
+             * Validating the issues of a node only modifies that node, so different nodes can be validated in parallel
+             * as long as the document is not modified at the same time.
+             */
+            void validateIssues(const std::vector<IssueGenerator*>& issueGenerators);
+
             bool issueHidden(IssueType type) const;
             void setIssueHidden(IssueType type, bool hidden);
         public: // should only be called from this and from the world
             void invalidateIssues() const;
         private:
-            void validateIssues(const std::vector<IssueGenerator*>& issueGenerators);
             void clearIssues() const;
         public: // visitors
             /**
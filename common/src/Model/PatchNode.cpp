@@ -87,7 +87,7 @@ namespace TrenchBroom {
          * Not every grid point has four incident quadrants (e.g. the corner points have only one). If the grid points of two opposing sides of the
          * grid coincide, we treat them as one grid point and average their normals.
          */
-        std::vector<vm::vec3> computeGridNormals(const std::vector<BezierPatch::Point> patchGrid, const size_t pointRowCount, const size_t pointColumnCount) {
+        std::vector<vm::vec3> computeGridNormals(const std::vector<BezierPatch::Point>& patchGrid, const size_t pointRowCount, const size_t pointColumnCount) {
             /* Returns the index of a grid point with the given coordinates. */
             const auto index = [&](const size_t row, const size_t col) {
                 return row * pointColumnCount + col;
@@ -256,6 +256,10 @@ namespace TrenchBroom {
         m_patch{std::move(patch)},
         m_grid{makePatchGrid(m_patch, DefaultSubdivisionsPerSurface)} {}
 
+        PatchNode::PatchNode(BezierPatch patch, PatchGrid grid) :
+        m_patch{std::move(patch)},
+        m_grid{std::move(grid)} {}
+
         const EntityNodeBase* PatchNode::entity() const {
             return visitParent(kdl::overload(
                 [](const WorldNode* world)                    -> const EntityNodeBase* { return world; },
@@ -280,7 +284,13 @@ namespace TrenchBroom {
             const NotifyPhysicalBoundsChange boundsChange(this);
 
             auto previousPatch = std::exchange(m_patch, std::move(patch));
-            m_grid = makePatchGrid(m_patch, DefaultSubdivisionsPerSurface);
+
+            // the grid only depends on the control points, so it can be kept if they did not change
+            if (m_patch.pointRowCount() != previousPatch.pointRowCount()
+                || m_patch.pointColumnCount() != previousPatch.pointColumnCount()
+                || m_patch.controlPoints() != previousPatch.controlPoints()) {
+                m_grid = makePatchGrid(m_patch, DefaultSubdivisionsPerSurface);
+            }
             return previousPatch;
         }
 
@@ -321,7 +331,7 @@ namespace TrenchBroom {
         }
 
         Node* PatchNode::doClone(const vm::bbox3&) const {
-            return new PatchNode(m_patch);
+            return new PatchNode(m_patch, m_grid);
         }
 
         bool PatchNode::doCanAddChild(const Node*) const {
@@ -54,7 +54,7 @@ namespace TrenchBroom {
         };
 
         // public for testing
-        std::vector<vm::vec3> computeGridNormals(const std::vector<BezierPatch::Point> patchGrid, const size_t pointRowCount, const size_t pointColumnCount);
+        std::vector<vm::vec3> computeGridNormals(const std::vector<BezierPatch::Point>& patchGrid, const size_t pointRowCount, const size_t pointColumnCount);
 
         // public for testing
         PatchGrid makePatchGrid(const BezierPatch& patch, size_t subdivisionsPerSurface);
@@ -71,6 +71,9 @@ namespace TrenchBroom {
             PatchGrid m_grid;
         public:
             explicit PatchNode(BezierPatch patch);
+        private:
+            PatchNode(BezierPatch patch, PatchGrid grid);
+        public:
 
             EntityNodeBase* entity();
             const EntityNodeBase* entity() const;
@@ -29,6 +29,7 @@
 #include <vecmath/util.h>
 #include <vecmath/vec.h>
 
+#include <cstddef>
 #include <initializer_list>
 #include <limits>
 #include <optional>
@@ -101,6 +102,13 @@ namespace TrenchBroom {
              */
             explicit Polyhedron_Vertex(const vm::vec<T,3>& position);
         public:
+            /**
+             * Allocates the memory for vertices from a pool instead of the heap, since polyhedra create and destroy
+             * their elements in large numbers.
+             */
+            static void* operator new(std::size_t size);
+            static void operator delete(void* ptr) noexcept;
+
             /**
              * Returns the position of this vertex.
              */
@@ -235,6 +243,13 @@ namespace TrenchBroom {
              */
             Polyhedron_Edge(HalfEdge* first, HalfEdge* second = nullptr);
         public:
+            /**
+             * Allocates the memory for edges from a pool instead of the heap, since polyhedra create and destroy
+             * their elements in large numbers.
+             */
+            static void* operator new(std::size_t size);
+            static void operator delete(void* ptr) noexcept;
+
             /**
              * Returns the origin of the first half edge.
              */
@@ -513,6 +528,13 @@ namespace TrenchBroom {
              */
             Polyhedron_HalfEdge(Vertex* origin);
         public:
+            /**
+             * Allocates the memory for half edges from a pool instead of the heap, since polyhedra create and destroy
+             * their elements in large numbers.
+             */
+            static void* operator new(std::size_t size);
+            static void operator delete(void* ptr) noexcept;
+
             /**
              * Returns the origin vertex of this half edge.
              */
@@ -718,6 +740,13 @@ namespace TrenchBroom {
              */
             explicit Polyhedron_Face(HalfEdgeList&& boundary, const vm::plane<T,3>& plane);
         public:
+            /**
+             * Allocates the memory for faces from a pool instead of the heap, since polyhedra create and destroy
+             * their elements in large numbers.
+             */
+            static void* operator new(std::size_t size);
+            static void operator delete(void* ptr) noexcept;
+
             /**
              * Returns the circular list of half edges that make up the boundary of this face.
              */
@@ -2020,6 +2049,30 @@ namespace TrenchBroom {
              */
             HalfEdge* findNextIntersectingEdge(HalfEdge* searchFrom, const vm::plane<T,3>& plane) const;
 
+            /* ====================== Implementation in Polyhedron_Planes.h ====================== */
+        public: // Building from planes
+            /**
+             * Builds the polyhedron that is the intersection of the half spaces below the given planes without clipping.
+             * The vertices are computed directly as the points of intersection of plane triples, and the half edge
+             * structure is built once from them.
+             *
+             * The result is only returned if it is guaranteed to be equal to the result of clipping a sufficiently
+             * large polyhedron with the given planes in order and correcting its vertex positions afterwards, except for
+             * the order of its vertices, edges and faces. This is the case if every vertex of the result has integer
+             * coordinates after correction and no vertex is so close to a plane that clipping might classify it
+             * differently. Otherwise, nullopt is returned, and the caller has to clip. Nullopt is also returned if the
+             * given planes do not enclose a bounded non empty polyhedron.
+             *
+             * The faces of the returned polyhedron are created in the order of the given planes, and every face has the
+             * plane it was created for. For every given plane, the created face or null if the plane does not contribute a
+             * face is appended to the given vector.
+             *
+             * @param planes the planes bounding the polyhedron
+             * @param planeFaces the vector to which the faces for the given planes are appended
+             * @return the polyhedron or nullopt if it cannot be built without clipping
+             */
+            static std::optional<Polyhedron> fromPlanes(const std::vector<vm::plane<T,3>>& planes, std::vector<Face*>& planeFaces);
+
             /* ====================== Implementation in Polyhedron_CSG.h ====================== */
         public: // Intersection
             /**
@@ -22,6 +22,8 @@
 #include "Polyhedron.h"
 #include "Macros.h"
 
+#include <kdl/fixed_size_pool.h>
+
 #include <vecmath/vec.h>
 #include <vecmath/plane.h>
 #include <vecmath/segment.h>
@@ -61,6 +63,18 @@ m_link(this)
             }
         }
 
+        template <typename T, typename FP, typename VP>
+        void* Polyhedron_Edge<T,FP,VP>::operator new(const std::size_t size) {
+            assert(size == sizeof(Polyhedron_Edge<T,FP,VP>));
+            unused(size);
+            return kdl::fixed_size_pool<sizeof(Polyhedron_Edge<T,FP,VP>), alignof(Polyhedron_Edge<T,FP,VP>)>::allocate();
+        }
+
+        template <typename T, typename FP, typename VP>
+        void Polyhedron_Edge<T,FP,VP>::operator delete(void* ptr) noexcept {
+            kdl::fixed_size_pool<sizeof(Polyhedron_Edge<T,FP,VP>), alignof(Polyhedron_Edge<T,FP,VP>)>::deallocate(ptr);
+        }
+
         template <typename T, typename FP, typename VP>
         typename Polyhedron_Edge<T,FP,VP>::Vertex* Polyhedron_Edge<T,FP,VP>::firstVertex() const {
             assert(m_first != nullptr);
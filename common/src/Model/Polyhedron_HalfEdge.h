@@ -19,8 +19,11 @@
 
 #pragma once
 
+#include "Macros.h"
 #include "Polyhedron.h"
 
+#include <kdl/fixed_size_pool.h>
+
 namespace TrenchBroom {
     namespace Model {
         template <typename T, typename FP, typename VP>
@@ -52,6 +55,18 @@ m_link(this)
             setAsLeaving();
         }
 
+        template <typename T, typename FP, typename VP>
+        void* Polyhedron_HalfEdge<T,FP,VP>::operator new(const std::size_t size) {
+            assert(size == sizeof(Polyhedron_HalfEdge<T,FP,VP>));
+            unused(size);
+            return kdl::fixed_size_pool<sizeof(Polyhedron_HalfEdge<T,FP,VP>), alignof(Polyhedron_HalfEdge<T,FP,VP>)>::allocate();
+        }
+
+        template <typename T, typename FP, typename VP>
+        void Polyhedron_HalfEdge<T,FP,VP>::operator delete(void* ptr) noexcept {
+            kdl::fixed_size_pool<sizeof(Polyhedron_HalfEdge<T,FP,VP>), alignof(Polyhedron_HalfEdge<T,FP,VP>)>::deallocate(ptr);
+        }
+
         template <typename T, typename FP, typename VP>
         typename Polyhedron_HalfEdge<T,FP,VP>::Vertex* Polyhedron_HalfEdge<T,FP,VP>::origin() const {
             return m_origin;
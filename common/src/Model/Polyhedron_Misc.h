@@ -275,6 +275,9 @@ namespace TrenchBroom {
              */
             Copy(const FaceList& originalFaces, const EdgeList& originalEdges, const VertexList& originalVertices, Polyhedron& destination, const CopyCallback& callback) :
                 m_destination(destination) {
+                m_vertexMap.reserve(originalVertices.size());
+                m_halfEdgeMap.reserve(2u * originalEdges.size());
+
                 copyVertices(originalVertices, callback);
                 copyFaces(originalFaces, callback);
                 copyEdges(originalEdges);
@@ -0,0 +1,255 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Polyhedron.h"
+
+#include <vecmath/constants.h>
+#include <vecmath/plane.h>
+#include <vecmath/scalar.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        template <typename T, typename FP, typename VP>
+        std::optional<Polyhedron<T,FP,VP>> Polyhedron<T,FP,VP>::fromPlanes(const std::vector<vm::plane<T,3>>& planes, std::vector<Face*>& planeFaces) {
+            // The number of plane triples grows cubically, so clipping is faster for brushes with many faces.
+            static constexpr auto MaxPlaneCount = size_t(24);
+            // Points whose distance to a plane is between the point status epsilon and this multiple of it might be
+            // classified differently by clipping because the clipped vertices are not computed exactly.
+            static constexpr auto AmbiguityFactor = T(16);
+
+            const auto planeCount = planes.size();
+            if (planeCount < 4u || planeCount > MaxPlaneCount) {
+                return std::nullopt;
+            }
+
+            const auto epsilon = vm::constants<T>::point_status_epsilon();
+
+            struct Corner {
+                vm::vec<T,3> position;
+                std::vector<size_t> planes;
+            };
+            std::vector<Corner> corners;
+
+            for (size_t i = 0u; i < planeCount; ++i) {
+                for (size_t j = i + 1u; j < planeCount; ++j) {
+                    for (size_t k = j + 1u; k < planeCount; ++k) {
+                        const auto& p1 = planes[i];
+                        const auto& p2 = planes[j];
+                        const auto& p3 = planes[k];
+
+                        const auto n23 = vm::cross(p2.normal, p3.normal);
+                        const auto det = vm::dot(p1.normal, n23);
+                        if (vm::abs(det) < vm::constants<T>::almost_zero()) {
+                            continue;
+                        }
+
+                        const auto point = (p1.distance * n23
+                                            + p2.distance * vm::cross(p3.normal, p1.normal)
+                                            + p3.distance * vm::cross(p1.normal, p2.normal)) / det;
+
+                        auto outside = false;
+                        std::vector<size_t> incidentPlanes;
+                        for (size_t l = 0u; l < planeCount && !outside; ++l) {
+                            const auto distance = planes[l].point_distance(point);
+                            const auto absDistance = vm::abs(distance);
+                            if (absDistance <= epsilon) {
+                                incidentPlanes.push_back(l);
+                            } else if (absDistance <= AmbiguityFactor * epsilon) {
+                                return std::nullopt;
+                            } else if (distance > T(0)) {
+                                outside = true;
+                            }
+                        }
+
+                        if (outside) {
+                            continue;
+                        }
+
+                        const auto position = vm::correct(point, 0, vm::constants<T>::correct_epsilon());
+                        if (position != vm::round(position)) {
+                            return std::nullopt;
+                        }
+
+                        const auto it = std::find_if(std::begin(corners), std::end(corners), [&](const Corner& c) { return c.position == position; });
+                        if (it == std::end(corners)) {
+                            corners.push_back(Corner{position, std::move(incidentPlanes)});
+                        } else if (it->planes != incidentPlanes) {
+                            // two different corners were corrected to the same position
+                            return std::nullopt;
+                        }
+                    }
+                }
+            }
+
+            // A plane contributes a face if it contains at least three corners, and a corner is a vertex if it lies on at
+            // least three contributing planes. Removing corners can remove faces, so repeat until nothing changes.
+            std::vector<bool> isVertex(corners.size(), true);
+            std::vector<size_t> planeVertexCount(planeCount, 0u);
+            auto changed = true;
+            while (changed) {
+                changed = false;
+                std::fill(std::begin(planeVertexCount), std::end(planeVertexCount), 0u);
+                for (size_t c = 0u; c < corners.size(); ++c) {
+                    if (isVertex[c]) {
+                        for (const auto p : corners[c].planes) {
+                            ++planeVertexCount[p];
+                        }
+                    }
+                }
+                for (size_t c = 0u; c < corners.size(); ++c) {
+                    if (isVertex[c]) {
+                        const auto count = std::count_if(std::begin(corners[c].planes), std::end(corners[c].planes), [&](const size_t p) { return planeVertexCount[p] >= 3u; });
+                        if (count < 3) {
+                            isVertex[c] = false;
+                            changed = true;
+                        }
+                    }
+                }
+            }
+
+            std::vector<std::vector<size_t>> faceVertices(planeCount);
+            for (size_t c = 0u; c < corners.size(); ++c) {
+                if (isVertex[c]) {
+                    for (const auto p : corners[c].planes) {
+                        if (planeVertexCount[p] >= 3u) {
+                            faceVertices[p].push_back(c);
+                        }
+                    }
+                }
+            }
+
+            // Sort the vertices of every face counter clockwise when viewed from above its plane and check that the
+            // resulting polygon is strictly convex.
+            auto faceCount = size_t(0);
+            auto halfEdgeCount = size_t(0);
+            for (size_t p = 0u; p < planeCount; ++p) {
+                auto& indices = faceVertices[p];
+                if (indices.empty()) {
+                    continue;
+                }
+
+                const auto& normal = planes[p].normal;
+                auto center = vm::vec<T,3>::zero();
+                for (const auto c : indices) {
+                    center = center + corners[c].position;
+                }
+                center = center / static_cast<T>(indices.size());
+
+                const auto axis = vm::normalize(corners[indices.front()].position - center);
+                const auto perp = vm::cross(normal, axis);
+                std::vector<std::pair<T, size_t>> angles;
+                angles.reserve(indices.size());
+                for (const auto c : indices) {
+                    const auto v = corners[c].position - center;
+                    angles.emplace_back(std::atan2(vm::dot(v, perp), vm::dot(v, axis)), c);
+                }
+                std::sort(std::begin(angles), std::end(angles));
+
+                const auto count = indices.size();
+                for (size_t n = 0u; n < count; ++n) {
+                    indices[n] = angles[n].second;
+                }
+                for (size_t n = 0u; n < count; ++n) {
+                    const auto& v1 = corners[indices[n]].position;
+                    const auto& v2 = corners[indices[(n + 1u) % count]].position;
+                    const auto& v3 = corners[indices[(n + 2u) % count]].position;
+                    if (vm::dot(vm::cross(v2 - v1, v3 - v2), normal) <= T(0)) {
+                        return std::nullopt;
+                    }
+                }
+
+                ++faceCount;
+                halfEdgeCount += count;
+            }
+
+            const auto vertexCount = static_cast<size_t>(std::count(std::begin(isVertex), std::end(isVertex), true));
+            if (faceCount < 4u || halfEdgeCount % 2u != 0u || vertexCount + faceCount != halfEdgeCount / 2u + 2u) {
+                return std::nullopt;
+            }
+
+            Polyhedron result;
+
+            std::vector<Vertex*> vertices(corners.size(), nullptr);
+            for (size_t c = 0u; c < corners.size(); ++c) {
+                if (isVertex[c]) {
+                    vertices[c] = new Vertex(corners[c].position);
+                    result.m_vertices.push_back(vertices[c]);
+                }
+            }
+
+            std::vector<Face*> faces(planeCount, nullptr);
+            std::map<std::pair<size_t, size_t>, HalfEdge*> halfEdges;
+            for (size_t p = 0u; p < planeCount; ++p) {
+                const auto& indices = faceVertices[p];
+                if (indices.empty()) {
+                    continue;
+                }
+
+                HalfEdgeList boundary;
+                for (size_t n = 0u; n < indices.size(); ++n) {
+                    const auto origin = indices[n];
+                    const auto destination = indices[(n + 1u) % indices.size()];
+                    auto* halfEdge = new HalfEdge(vertices[origin]);
+                    boundary.push_back(halfEdge);
+                    if (!halfEdges.emplace(std::make_pair(origin, destination), halfEdge).second) {
+                        // two faces contain the same edge with the same orientation, e.g. if two planes are equal
+                        return std::nullopt;
+                    }
+                }
+
+                faces[p] = new Face(std::move(boundary), planes[p]);
+                result.m_faces.push_back(faces[p]);
+            }
+
+            for (const auto& [key, halfEdge] : halfEdges) {
+                const auto& [origin, destination] = key;
+                if (origin < destination) {
+                    const auto twin = halfEdges.find(std::make_pair(destination, origin));
+                    if (twin == std::end(halfEdges)) {
+                        return std::nullopt;
+                    }
+                    if (vm::squared_length(corners[destination].position - corners[origin].position) < MinEdgeLength * MinEdgeLength) {
+                        return std::nullopt;
+                    }
+                    result.m_edges.push_back(new Edge(halfEdge, twin->second));
+                }
+            }
+
+            if (result.m_edges.size() != halfEdgeCount / 2u) {
+                return std::nullopt;
+            }
+
+            result.updateBounds();
+            assert(result.checkInvariant());
+
+            planeFaces.insert(std::end(planeFaces), std::begin(faces), std::end(faces));
+            return std::optional<Polyhedron>(std::move(result));
+        }
+    }
+}
@@ -19,8 +19,10 @@
 
 #pragma once
 
+#include "Macros.h"
 #include "Polyhedron.h"
 
+#include <kdl/fixed_size_pool.h>
 #include <kdl/intrusive_circular_list.h>
 
 namespace TrenchBroom {
@@ -50,6 +52,18 @@ m_link(this),
 #endif
             m_payload(VP::defaultValue()) {}
 
+        template <typename T, typename FP, typename VP>
+        void* Polyhedron_Vertex<T,FP,VP>::operator new(const std::size_t size) {
+            assert(size == sizeof(Polyhedron_Vertex<T,FP,VP>));
+            unused(size);
+            return kdl::fixed_size_pool<sizeof(Polyhedron_Vertex<T,FP,VP>), alignof(Polyhedron_Vertex<T,FP,VP>)>::allocate();
+        }
+
+        template <typename T, typename FP, typename VP>
+        void Polyhedron_Vertex<T,FP,VP>::operator delete(void* ptr) noexcept {
+            kdl::fixed_size_pool<sizeof(Polyhedron_Vertex<T,FP,VP>), alignof(Polyhedron_Vertex<T,FP,VP>)>::deallocate(ptr);
+        }
+
         template <typename T, typename FP, typename VP>
         const vm::vec<T,3>& Polyhedron_Vertex<T,FP,VP>::position() const {
             return m_position;
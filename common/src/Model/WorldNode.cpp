@@ -20,16 +20,19 @@
 #include "WorldNode.h"
 
 #include "AABBTree.h"
+#include "FlatAABBTree.h"
 #include "Ensure.h"
 #include "Model/BrushNode.h"
 #include "Model/BrushFace.h"
 #include "Model/EntityNode.h"
 #include "Model/EntityNodeIndex.h"
 #include "Model/GroupNode.h"
+#include "Model/Hit.h"
 #include "Model/IssueGenerator.h"
 #include "Model/IssueGeneratorRegistry.h"
 #include "Model/LayerNode.h"
 #include "Model/PatchNode.h"
+#include "Model/PickResult.h"
 #include "Model/TagVisitor.h"
 
 #include <kdl/overload.h>
@@ -38,6 +41,7 @@
 
 #include <vecmath/bbox_io.h>
 
+#include <limits>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -50,7 +54,9 @@ namespace TrenchBroom {
         m_entityNodeIndex(std::make_unique<EntityNodeIndex>()),
         m_issueGeneratorRegistry(std::make_unique<IssueGeneratorRegistry>()),
         m_nodeTree(std::make_unique<NodeTree>()),
-        m_updateNodeTree(true) {
+        m_updateNodeTree(true),
+        m_nodeTreeChangedSinceLastQuery(false),
+        m_nodeTreeRevision(0u) {
             entity.addOrUpdateProperty(PropertyKeys::Classname, PropertyValues::WorldspawnClassname);
             entity.setPointEntity(false);
             setEntity(std::move(entity));
@@ -67,6 +73,10 @@ namespace TrenchBroom {
             return *m_nodeTree;
         }
 
+        size_t WorldNode::nodeTreeRevision() const {
+            return m_nodeTreeRevision;
+        }
+
         LayerNode* WorldNode::defaultLayer() {
             ensure(m_defaultLayer != nullptr, "defaultLayer is null");
             return m_defaultLayer;
@@ -155,8 +165,8 @@ namespace TrenchBroom {
         }
 
         void WorldNode::registerIssueGenerator(IssueGenerator* issueGenerator) {
+            // the issues of the other generators remain valid, and the new generator is run on demand
             m_issueGeneratorRegistry->registerGenerator(issueGenerator);
-            invalidateAllIssues();
         }
 
         void WorldNode::unregisterAllIssueGenerators() {
@@ -164,6 +174,36 @@ namespace TrenchBroom {
             invalidateAllIssues();
         }
 
+        void WorldNode::pickClosest(const vm::ray3& ray, PickResult& pickResult, const std::function<const Hit&(const PickResult&)>& findHit) {
+            const auto* flatNodeTree = flatNodeTreeForQuery();
+            if (!flatNodeTree) {
+                // don't call pick here, it would query the flat node tree again and build it
+                for (auto* node : m_nodeTree->findIntersectors(ray)) {
+                    node->pick(ray, pickResult);
+                }
+                return;
+            }
+
+            auto hitCount = pickResult.size();
+            auto closestDistance = std::numeric_limits<FloatType>::max();
+            flatNodeTree->findIntersectorsByDistance(ray, [&](Node* node, const FloatType entryDistance) {
+                if (entryDistance > closestDistance) {
+                    return false;
+                }
+
+                node->pick(ray, pickResult);
+                if (pickResult.size() != hitCount) {
+                    hitCount = pickResult.size();
+
+                    const auto& hit = findHit(pickResult);
+                    if (hit.isMatch()) {
+                        closestDistance = hit.distance();
+                    }
+                }
+                return true;
+            });
+        }
+
         void WorldNode::disableNodeTreeUpdates() {
             m_updateNodeTree = false;
         }
@@ -190,6 +230,25 @@ namespace TrenchBroom {
             ));
 
             m_nodeTree->clearAndBuild(nodes, [](const auto* node){ return node->physicalBounds(); });
+
+            // a rebuild is not part of a sequence of edits, so the flat tree can be built on the next query
+            m_flatNodeTree.reset();
+            m_nodeTreeChangedSinceLastQuery = false;
+            ++m_nodeTreeRevision;
+        }
+
+        void WorldNode::nodeTreeDidChange() {
+            m_flatNodeTree.reset();
+            m_nodeTreeChangedSinceLastQuery = true;
+            ++m_nodeTreeRevision;
+        }
+
+        const WorldNode::FlatNodeTree* WorldNode::flatNodeTreeForQuery() {
+            if (!m_flatNodeTree && !m_nodeTreeChangedSinceLastQuery) {
+                m_flatNodeTree = std::make_unique<FlatNodeTree>(*m_nodeTree);
+            }
+            m_nodeTreeChangedSinceLastQuery = false;
+            return m_flatNodeTree.get();
         }
 
         void WorldNode::invalidateAllIssues() {
@@ -279,6 +338,7 @@ namespace TrenchBroom {
                     [&](BrushNode* brush)                      { m_nodeTree->insert(brush->physicalBounds(), brush); },
                     [&](PatchNode* patch)                      { m_nodeTree->insert(patch->physicalBounds(), patch); }
                 ));
+                nodeTreeDidChange();
             }
 
             const auto updatePersistentId = [&](auto* persistentNode) {
@@ -318,6 +378,7 @@ namespace TrenchBroom {
                     [&](BrushNode* brush)                      { doRemove(brush); },
                     [&](PatchNode* patch)                      { doRemove(patch); }
                 ));
+                nodeTreeDidChange();
             }
         }
 
@@ -331,6 +392,7 @@ namespace TrenchBroom {
                     [&](BrushNode* brush)   { m_nodeTree->update(brush->physicalBounds(), brush); },
                     [&](PatchNode* patch)   { m_nodeTree->update(patch->physicalBounds(), patch); }
                 ));
+                nodeTreeDidChange();
             }
         }
 
@@ -339,13 +401,17 @@ namespace TrenchBroom {
         }
 
         void WorldNode::doPick(const vm::ray3& ray, PickResult& pickResult) {
-            for (auto* node : m_nodeTree->findIntersectors(ray)) {
+            const auto* flatNodeTree = flatNodeTreeForQuery();
+            const auto candidates = flatNodeTree ? flatNodeTree->findIntersectors(ray) : m_nodeTree->findIntersectors(ray);
+            for (auto* node : candidates) {
                 node->pick(ray, pickResult);
             }
         }
 
         void WorldNode::doFindNodesContaining(const vm::vec3& point, std::vector<Node*>& result) {
-            for (auto* node : m_nodeTree->findContainers(point)) {
+            const auto* flatNodeTree = flatNodeTreeForQuery();
+            const auto candidates = flatNodeTree ? flatNodeTree->findContainers(point) : m_nodeTree->findContainers(point);
+            for (auto* node : candidates) {
                 node->findNodesContaining(point, result);
             }
         }
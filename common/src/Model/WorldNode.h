@@ -28,15 +28,18 @@
 
 #include <kdl/result_forward.h>
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
 namespace TrenchBroom {
     template <typename T, size_t S, typename U> class AABBTree;
+    template <typename T, size_t S, typename U> class FlatAABBTree;
 
     namespace Model {
         class EntityNodeIndex;
+        class Hit;
         enum class BrushError;
         class BrushFace;
         class IssueGeneratorRegistry;
@@ -55,6 +58,20 @@ namespace TrenchBroom {
             std::unique_ptr<NodeTree> m_nodeTree;
             bool m_updateNodeTree;
 
+            /*
+             * A snapshot of m_nodeTree for picking. It is discarded whenever the node tree changes, and it is only
+             * rebuilt if the node tree was not changed since the previous query, so that interleaved edits and
+             * queries (e.g. when dragging objects) fall back to querying the node tree directly.
+             */
+            using FlatNodeTree = FlatAABBTree<FloatType, 3, Node*>;
+            std::unique_ptr<FlatNodeTree> m_flatNodeTree;
+            bool m_nodeTreeChangedSinceLastQuery;
+
+            /*
+             * Incremented whenever the node tree changes so that clients can cache query results.
+             */
+            size_t m_nodeTreeRevision;
+
             IdType m_nextPersistentId = 1;
         public:
             WorldNode(Entity entity, MapFormat mapFormat);
@@ -63,6 +80,12 @@ namespace TrenchBroom {
             MapFormat mapFormat() const;
 
             const NodeTree& nodeTree() const;
+
+            /**
+             * Returns a number that changes whenever the node tree changes. Query results for the node tree can be
+             * reused as long as this number doesn't change.
+             */
+            size_t nodeTreeRevision() const;
         public: // layer management
             LayerNode* defaultLayer();
 
@@ -117,10 +140,26 @@ namespace TrenchBroom {
             std::vector<IssueQuickFix*> quickFixes(IssueType issueTypes) const;
             void registerIssueGenerator(IssueGenerator* issueGenerator);
             void unregisterAllIssueGenerators();
+        public: // picking
+            /**
+             * Picks the nodes whose bounds are hit by the given ray in the order in which the ray enters their bounds,
+             * and stops once the hit returned by the given function is closer than the bounds of the remaining nodes.
+             *
+             * Since the remaining nodes are not picked, the given function should select the closest matching hit,
+             * e.g. by calling HitQuery::first.
+             *
+             * @param ray the pick ray
+             * @param pickResult the pick result to add the hits to
+             * @param findHit returns the matching hit in the given pick result, or Hit::NoHit
+             */
+            void pickClosest(const vm::ray3& ray, PickResult& pickResult, const std::function<const Hit&(const PickResult&)>& findHit);
         public: // node tree bulk updating
             void disableNodeTreeUpdates();
             void enableNodeTreeUpdates();
             void rebuildNodeTree();
+        private:
+            void nodeTreeDidChange();
+            const FlatNodeTree* flatNodeTreeForQuery();
         private:
             void invalidateAllIssues();
         private: // implement Node interface
@@ -0,0 +1,88 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BrushCuller.h"
+
+#include "Model/BrushNode.h"
+#include "Model/EntityNode.h"
+#include "Model/GroupNode.h"
+#include "Model/LayerNode.h"
+#include "Model/PatchNode.h"
+#include "Model/WorldNode.h"
+#include "Renderer/Camera.h"
+
+#include <kdl/overload.h>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        static std::vector<vm::plane3d> frustumPlanes(const Camera& camera) {
+            vm::plane3f topPlane, rightPlane, bottomPlane, leftPlane;
+            camera.frustumPlanes(topPlane, rightPlane, bottomPlane, leftPlane);
+            return {
+                vm::plane3d(topPlane),
+                vm::plane3d(rightPlane),
+                vm::plane3d(bottomPlane),
+                vm::plane3d(leftPlane)
+            };
+        }
+
+        static bool equalPlanes(const std::vector<vm::plane3d>& lhs, const std::vector<vm::plane3d>& rhs) {
+            if (lhs.size() != rhs.size()) {
+                return false;
+            }
+            for (size_t i = 0u; i < lhs.size(); ++i) {
+                if (lhs[i].normal != rhs[i].normal || lhs[i].distance != rhs[i].distance) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        std::shared_ptr<const BrushCuller::BrushList> BrushCuller::cull(const Model::WorldNode& world, const Camera& camera) {
+            auto planes = frustumPlanes(camera);
+
+            auto& entry = m_entries[&camera];
+            if (entry.visibleBrushes && entry.world == &world && entry.nodeTreeRevision == world.nodeTreeRevision() && equalPlanes(entry.planes, planes)) {
+                return entry.visibleBrushes;
+            }
+
+            auto visibleBrushes = BrushList{};
+            for (auto* node : world.nodeTree().findIntersectorsOfVolume(planes)) {
+                node->accept(kdl::overload(
+                    [](Model::WorldNode*) {},
+                    [](Model::LayerNode*) {},
+                    [](Model::GroupNode*) {},
+                    [](Model::EntityNode*) {},
+                    [&](Model::BrushNode* brush) { visibleBrushes.push_back(brush); },
+                    [](Model::PatchNode*) {}
+                ));
+            }
+
+            entry.planes = std::move(planes);
+            entry.world = &world;
+            entry.nodeTreeRevision = world.nodeTreeRevision();
+            entry.visibleBrushes = std::make_shared<const BrushList>(std::move(visibleBrushes));
+            return entry.visibleBrushes;
+        }
+
+        void BrushCuller::clear() {
+            m_entries.clear();
+        }
+    }
+}
@@ -0,0 +1,73 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FloatType.h"
+
+#include <vecmath/forward.h>
+#include <vecmath/plane.h>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        class BrushNode;
+        class WorldNode;
+    }
+
+    namespace Renderer {
+        class Camera;
+
+        /**
+         * Finds the brushes which intersect with the view volume of a camera and caches the result for each camera.
+         *
+         * Several map views can share one map renderer, so the cached result of one camera must not be replaced by
+         * culling for another camera. A cached result is reused as long as neither the camera's view volume nor the
+         * world's node tree changes, so that the brush renderers can keep the index ranges they derived from it.
+         */
+        class BrushCuller {
+        public:
+            using BrushList = std::vector<const Model::BrushNode*>;
+        private:
+            struct Entry {
+                std::vector<vm::plane3d> planes;
+                const Model::WorldNode* world;
+                size_t nodeTreeRevision;
+                std::shared_ptr<const BrushList> visibleBrushes;
+            };
+
+            std::unordered_map<const Camera*, Entry> m_entries;
+        public:
+            /**
+             * Returns the brushes in the given world which intersect with the view volume of the given camera. The
+             * returned list is the same object as the one returned by the previous call for the given camera unless
+             * the camera's view volume or the world's node tree has changed since.
+             */
+            std::shared_ptr<const BrushList> cull(const Model::WorldNode& world, const Camera& camera);
+
+            /**
+             * Forgets all cached results, e.g. when the world is replaced.
+             */
+            void clear();
+        };
+    }
+}
@@ -31,6 +31,9 @@
 #include "Renderer/BrushRendererBrushCache.h"
 #include "Renderer/RenderContext.h"
 
+#include <kdl/parallel.h>
+
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <vector>
@@ -133,7 +136,8 @@ namespace TrenchBroom {
         m_showOccludedEdges(false),
         m_forceTransparent(false),
         m_transparencyAlpha(1.0f),
-        m_showHiddenBrushes(false) {
+        m_showHiddenBrushes(false),
+        m_indexRangesValid(false) {
             clear();
         }
 
@@ -208,6 +212,7 @@ namespace TrenchBroom {
             m_opaqueFaceRenderer = FaceRenderer(m_vertexArray, m_opaqueFaces, m_faceColor);
             m_transparentFaceRenderer = FaceRenderer(m_vertexArray, m_transparentFaces, m_faceColor);
             m_edgeRenderer = IndexedEdgeRenderer(m_vertexArray, m_edgeIndices);
+            invalidateIndexRanges();
         }
 
         void BrushRenderer::setFaceColor(const Color& faceColor) {
@@ -263,6 +268,13 @@ namespace TrenchBroom {
             }
         }
 
+        void BrushRenderer::setVisibleBrushes(std::shared_ptr<const std::vector<const Model::BrushNode*>> visibleBrushes) {
+            if (visibleBrushes != m_visibleBrushes) {
+                m_visibleBrushes = std::move(visibleBrushes);
+                m_indexRangesValid = false;
+            }
+        }
+
         void BrushRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch) {
             renderOpaque(renderContext, renderBatch);
             renderTransparent(renderContext, renderBatch);
@@ -273,6 +285,9 @@ namespace TrenchBroom {
                 if (!valid()) {
                     validate();
                 }
+                if (!m_indexRangesValid) {
+                    updateIndexRanges();
+                }
                 if (renderContext.showFaces()) {
                     renderOpaqueFaces(renderBatch);
                 }
@@ -287,6 +302,9 @@ namespace TrenchBroom {
                 if (!valid()) {
                     validate();
                 }
+                if (!m_indexRangesValid) {
+                    updateIndexRanges();
+                }
                 if (renderContext.showFaces()) {
                     renderTransparentFaces(renderBatch);
                 }
@@ -315,6 +333,90 @@ namespace TrenchBroom {
             m_edgeRenderer.render(renderBatch, m_edgeColor);
         }
 
+        /**
+         * Sorts the given ranges and merges adjacent ranges so that they can be drawn with as few draw calls as possible.
+         */
+        static void mergeIndexRanges(std::vector<AllocationTracker::Range>& ranges) {
+            if (ranges.empty()) {
+                return;
+            }
+
+            std::sort(std::begin(ranges), std::end(ranges));
+
+            auto last = std::begin(ranges);
+            for (auto it = std::next(last); it != std::end(ranges); ++it) {
+                if (last->pos + last->size == it->pos) {
+                    last->size += it->size;
+                } else {
+                    *(++last) = *it;
+                }
+            }
+            ranges.erase(std::next(last), std::end(ranges));
+        }
+
+        void BrushRenderer::updateIndexRanges() {
+            if (m_visibleBrushes == nullptr) {
+                m_opaqueFaceRenderer.setIndexRanges(nullptr);
+                m_transparentFaceRenderer.setIndexRanges(nullptr);
+                m_edgeRenderer.setIndexRanges(nullptr);
+                m_indexRangesValid = true;
+                return;
+            }
+
+            auto it = std::find_if(std::begin(m_cachedIndexRanges), std::end(m_cachedIndexRanges), [&](const auto& cached) {
+                return cached.visibleBrushes == m_visibleBrushes;
+            });
+
+            if (it == std::end(m_cachedIndexRanges)) {
+                auto opaqueFaceRanges = std::make_shared<FaceRenderer::TextureToIndexRangesMap>();
+                auto transparentFaceRanges = std::make_shared<FaceRenderer::TextureToIndexRangesMap>();
+                auto edgeRanges = std::make_shared<IndexedEdgeRenderer::IndexRanges>();
+
+                for (const auto* brush : *m_visibleBrushes) {
+                    const auto brushIt = m_brushInfo.find(brush);
+                    if (brushIt == std::end(m_brushInfo)) {
+                        // the brush is not rendered by this renderer
+                        continue;
+                    }
+
+                    const auto& info = brushIt->second;
+                    if (info.edgeIndicesKey != nullptr) {
+                        edgeRanges->emplace_back(info.edgeIndicesKey->pos, info.edgeIndicesKey->size);
+                    }
+                    for (const auto& [texture, key] : info.opaqueFaceIndicesKeys) {
+                        (*opaqueFaceRanges)[texture].emplace_back(key->pos, key->size);
+                    }
+                    for (const auto& [texture, key] : info.transparentFaceIndicesKeys) {
+                        (*transparentFaceRanges)[texture].emplace_back(key->pos, key->size);
+                    }
+                }
+
+                for (auto& [texture, ranges] : *opaqueFaceRanges) {
+                    mergeIndexRanges(ranges);
+                }
+                for (auto& [texture, ranges] : *transparentFaceRanges) {
+                    mergeIndexRanges(ranges);
+                }
+                mergeIndexRanges(*edgeRanges);
+
+                if (m_cachedIndexRanges.size() == MaxCachedIndexRanges) {
+                    m_cachedIndexRanges.erase(std::begin(m_cachedIndexRanges));
+                }
+                m_cachedIndexRanges.push_back(CachedIndexRanges{m_visibleBrushes, std::move(opaqueFaceRanges), std::move(transparentFaceRanges), std::move(edgeRanges)});
+                it = std::prev(std::end(m_cachedIndexRanges));
+            }
+
+            m_opaqueFaceRenderer.setIndexRanges(it->opaqueFaceRanges);
+            m_transparentFaceRenderer.setIndexRanges(it->transparentFaceRanges);
+            m_edgeRenderer.setIndexRanges(it->edgeRanges);
+            m_indexRangesValid = true;
+        }
+
+        void BrushRenderer::invalidateIndexRanges() {
+            m_cachedIndexRanges.clear();
+            m_indexRangesValid = false;
+        }
+
         class BrushRenderer::FilterWrapper : public BrushRenderer::Filter {
         private:
             const Filter& m_filter;
@@ -341,8 +443,26 @@ namespace TrenchBroom {
         void BrushRenderer::validate() {
             assert(!valid());
 
-            for (auto brush : m_invalidBrushes) {
-                validateBrush(brush);
+            const auto invalidBrushes = std::vector<const Model::BrushNode*>(std::begin(m_invalidBrushes), std::end(m_invalidBrushes));
+            const FilterWrapper wrapper(*m_filter, m_showHiddenBrushes);
+
+            // Evaluating the filter and building the vertex cache of a brush only touch the brush itself, so this can
+            // be done in parallel. Brushes that the filter skips get no vertex cache. Uploading the caches into the
+            // shared VBOs must happen sequentially.
+            auto settings = std::vector<Filter::RenderSettings>(invalidBrushes.size());
+            kdl::parallel_for(kdl::default_thread_pool(), invalidBrushes.size(), [&](const size_t i) {
+                const auto* brush = invalidBrushes[i];
+                settings[i] = wrapper.markFaces(brush);
+
+                const auto [facePolicy, edgePolicy] = settings[i];
+                if (facePolicy != Filter::FaceRenderPolicy::RenderNone ||
+                    edgePolicy != Filter::EdgeRenderPolicy::RenderNone) {
+                    brush->brushRendererBrushCache().validateVertexCache(brush);
+                }
+            }, 64u);
+
+            for (size_t i = 0u; i < invalidBrushes.size(); ++i) {
+                validateBrush(invalidBrushes[i], settings[i]);
             }
             m_invalidBrushes.clear();
             assert(valid());
@@ -350,6 +470,7 @@ namespace TrenchBroom {
             m_opaqueFaceRenderer = FaceRenderer(m_vertexArray, m_opaqueFaces, m_faceColor);
             m_transparentFaceRenderer = FaceRenderer(m_vertexArray, m_transparentFaces, m_faceColor);
             m_edgeRenderer = IndexedEdgeRenderer(m_vertexArray, m_edgeIndices);
+            invalidateIndexRanges();
         }
 
         static size_t triIndicesCountForPolygon(const size_t vertexCount) {
@@ -438,15 +559,12 @@ namespace TrenchBroom {
             return false;
         }
 
-        void BrushRenderer::validateBrush(const Model::BrushNode* brush) {
+        void BrushRenderer::validateBrush(const Model::BrushNode* brush, const Filter::RenderSettings& settings) {
             assert(m_allBrushes.find(brush) != std::end(m_allBrushes));
             assert(m_invalidBrushes.find(brush) != std::end(m_invalidBrushes));
             assert(m_brushInfo.find(brush) == std::end(m_brushInfo));
 
-            const FilterWrapper wrapper(*m_filter, m_showHiddenBrushes);
-
-            // evaluate filter. only evaluate the filter once per brush.
-            const auto settings = wrapper.markFaces(brush);
+            // the filter was evaluated once for this brush by the caller, and the faces are still marked accordingly
             const auto [facePolicy, edgePolicy] = settings;
 
             if (facePolicy == Filter::FaceRenderPolicy::RenderNone &&
@@ -602,6 +720,9 @@ namespace TrenchBroom {
 
             const BrushInfo& info = it->second;
 
+            // the index ranges of the brush are about to be freed
+            invalidateIndexRanges();
+
             // update Vbo's
             m_vertexArray->deleteVerticesWithKey(info.vertexHolderKey);
             if (info.edgeIndicesKey != nullptr) {
@@ -161,6 +161,28 @@ namespace TrenchBroom {
             float m_transparencyAlpha;
 
             bool m_showHiddenBrushes;
+
+            /**
+             * The brushes to render, or null if all brushes should be rendered. Brushes which are not contained in this
+             * list remain in the VBO, but their index ranges are not submitted for drawing.
+             */
+            std::shared_ptr<const std::vector<const Model::BrushNode*>> m_visibleBrushes;
+            bool m_indexRangesValid;
+
+            /**
+             * The index ranges computed for recently used lists of visible brushes. Each map view culls with its own
+             * camera, so the visible brushes alternate between one list per view. The cached ranges are discarded
+             * whenever the VBO contents change.
+             */
+            struct CachedIndexRanges {
+                std::shared_ptr<const std::vector<const Model::BrushNode*>> visibleBrushes;
+                std::shared_ptr<const FaceRenderer::TextureToIndexRangesMap> opaqueFaceRanges;
+                std::shared_ptr<const FaceRenderer::TextureToIndexRangesMap> transparentFaceRanges;
+                std::shared_ptr<const IndexedEdgeRenderer::IndexRanges> edgeRanges;
+            };
+
+            static constexpr size_t MaxCachedIndexRanges = 4u;
+            std::vector<CachedIndexRanges> m_cachedIndexRanges;
         public:
             template <typename FilterT>
             explicit BrushRenderer(const FilterT& filter) :
@@ -171,7 +193,8 @@ namespace TrenchBroom {
             m_showOccludedEdges(false),
             m_forceTransparent(false),
             m_transparencyAlpha(1.0f),
-            m_showHiddenBrushes(false) {
+            m_showHiddenBrushes(false),
+            m_indexRangesValid(false) {
                 clear();
             }
 
@@ -265,6 +288,15 @@ namespace TrenchBroom {
              * Specifies whether or not brushes which are currently hidden should be rendered regardless.
              */
             void setShowHiddenBrushes(bool showHiddenBrushes);
+
+            /**
+             * Restricts rendering to the given brushes, e.g. the brushes which intersect with the view volume. Brushes
+             * which are not in the given list are not drawn, but they are not removed from the VBO either, so changing
+             * the visible brushes is cheap. If the given pointer is null, all brushes are rendered. The index ranges
+             * are only recomputed if they aren't cached for the given list, so callers should pass the same list
+             * object again as long as the visible brushes don't change.
+             */
+            void setVisibleBrushes(std::shared_ptr<const std::vector<const Model::BrushNode*>> visibleBrushes);
         public: // rendering
             void render(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
@@ -274,6 +306,13 @@ namespace TrenchBroom {
             void renderTransparentFaces(RenderBatch& renderBatch);
             void renderEdges(RenderBatch& renderBatch);
 
+            /**
+             * Collects the index ranges of the visible brushes and passes them to the face and edge renderers. The
+             * ranges are cached for the current list of visible brushes.
+             */
+            void updateIndexRanges();
+            void invalidateIndexRanges();
+
         public:
             /**
              * Only exposed for benchmarking.
@@ -281,7 +320,7 @@ namespace TrenchBroom {
             void validate();
         private:
             bool shouldDrawFaceInTransparentPass(const Model::BrushNode* brush, const Model::BrushFace& face) const;
-            void validateBrush(const Model::BrushNode* brush);
+            void validateBrush(const Model::BrushNode* brush, const Filter::RenderSettings& settings);
             void addBrush(const Model::BrushNode* brush);
             void removeBrush(const Model::BrushNode* brush);
 
@@ -32,10 +32,10 @@ namespace TrenchBroom {
         // DirtyRangeTracker
 
         DirtyRangeTracker::DirtyRangeTracker(const size_t initial_capacity)
-                : m_dirtyPos(0), m_dirtySize(0), m_capacity(initial_capacity) {}
+                : m_dirtySize(0), m_capacity(initial_capacity) {}
 
         DirtyRangeTracker::DirtyRangeTracker()
-                : m_dirtyPos(0), m_dirtySize(0), m_capacity(0) {}
+                : m_dirtySize(0), m_capacity(0) {}
 
         void DirtyRangeTracker::expand(const size_t newcap) {
             if (newcap <= m_capacity) {
@@ -57,23 +57,61 @@ namespace TrenchBroom {
                 throw std::invalid_argument("markDirty provided range out of bounds");
             }
 
-            const size_t newPos = std::min(pos, m_dirtyPos);
-            const size_t newEnd = std::max(pos + size, m_dirtyPos + m_dirtySize);
+            if (size == 0) {
+                return;
+            }
+
+            auto newPos = pos;
+            auto newEnd = pos + size;
+
+            // find the first range that overlaps or touches the new range
+            auto it = m_dirtyRanges.upper_bound(pos);
+            if (it != std::begin(m_dirtyRanges) && std::prev(it)->second >= pos) {
+                --it;
+            }
+
+            // merge all ranges that overlap or touch the new range
+            while (it != std::end(m_dirtyRanges) && it->first <= newEnd) {
+                newPos = std::min(newPos, it->first);
+                newEnd = std::max(newEnd, it->second);
+                m_dirtySize -= it->second - it->first;
+                it = m_dirtyRanges.erase(it);
+            }
 
-            m_dirtyPos = newPos;
-            m_dirtySize = newEnd - newPos;
+            m_dirtyRanges.emplace_hint(it, newPos, newEnd);
+            m_dirtySize += newEnd - newPos;
         }
 
         bool DirtyRangeTracker::clean() const {
             return m_dirtySize == 0;
         }
 
+        size_t DirtyRangeTracker::dirtySize() const {
+            return m_dirtySize;
+        }
+
+        std::vector<DirtyRangeTracker::Range> DirtyRangeTracker::dirtyRanges(const size_t maxGap) const {
+            std::vector<Range> result;
+            for (const auto& [pos, end] : m_dirtyRanges) {
+                if (!result.empty() && pos - (result.back().pos + result.back().size) <= maxGap) {
+                    result.back().size = end - result.back().pos;
+                } else {
+                    result.emplace_back(pos, end - pos);
+                }
+            }
+            return result;
+        }
+
         // IndexHolder
 
-        IndexHolder::IndexHolder() : VboHolder<Index>(VboType::ElementArrayBuffer) {}
+        IndexHolder::IndexHolder() : VboHolder<Index>(VboType::ElementArrayBuffer),
+                                     m_drawCounts(),
+                                     m_drawOffsets() {}
 
         IndexHolder::IndexHolder(std::vector<Index> &elements)
-                : VboHolder<Index>(VboType::ElementArrayBuffer, elements) {}
+                : VboHolder<Index>(VboType::ElementArrayBuffer, elements),
+                  m_drawCounts(),
+                  m_drawOffsets() {}
 
         void IndexHolder::zeroRange(const size_t offsetWithinBlock, const size_t count) {
             Index* dest = getPointerToWriteElementsTo(offsetWithinBlock, count);
@@ -87,6 +125,18 @@ namespace TrenchBroom {
             glAssert(glDrawElements(toGL(primType), renderCount, glType<Index>(), renderOffset));
         }
 
+        void IndexHolder::render(const PrimType primType, const std::vector<AllocationTracker::Range>& ranges) const {
+            m_drawCounts.clear();
+            m_drawOffsets.clear();
+
+            for (const auto& range : ranges) {
+                m_drawCounts.push_back(static_cast<GLsizei>(range.size));
+                m_drawOffsets.push_back(reinterpret_cast<GLvoid*>(m_vbo->offset() + sizeof(Index) * range.pos));
+            }
+
+            glAssert(glMultiDrawElements(toGL(primType), m_drawCounts.data(), glType<Index>(), m_drawOffsets.data(), static_cast<GLsizei>(ranges.size())));
+        }
+
         std::shared_ptr<IndexHolder> IndexHolder::swap(std::vector<IndexHolder::Index> &elements) {
             return std::make_shared<IndexHolder>(elements);
         }
@@ -136,6 +186,13 @@ namespace TrenchBroom {
             m_indexHolder.render(primType, 0, m_indexHolder.size());
         }
 
+        void BrushIndexArray::render(const PrimType primType, const std::vector<AllocationTracker::Range>& ranges) const {
+            assert(m_indexHolder.prepared());
+            if (!ranges.empty()) {
+                m_indexHolder.render(primType, ranges);
+            }
+        }
+
         bool BrushIndexArray::prepared() const {
             return m_indexHolder.prepared();
         }
@@ -30,18 +30,30 @@
 
 #include <vecmath/vec.h>
 
+#include <algorithm>
 #include <cassert>
+#include <map>
 #include <memory>
 #include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
     namespace Renderer {
-        struct DirtyRangeTracker {
-            size_t m_dirtyPos;
+        /**
+         * Tracks the ranges of elements that were modified since the last upload. Overlapping and adjacent ranges are
+         * merged, but distant ranges are kept apart so that they can be uploaded individually.
+         */
+        class DirtyRangeTracker {
+        public:
+            using Range = AllocationTracker::Range;
+        private:
+            /**
+             * Maps the start of each dirty range to its end. The ranges are disjoint and not adjacent.
+             */
+            std::map<size_t, size_t> m_dirtyRanges;
             size_t m_dirtySize;
             size_t m_capacity;
-
+        public:
             /**
              * New trackers are initially clean.
              */
@@ -55,6 +67,17 @@ namespace TrenchBroom {
             size_t capacity() const;
             void markDirty(size_t pos, size_t size);
             bool clean() const;
+
+            /**
+             * Returns the total number of dirty elements.
+             */
+            size_t dirtySize() const;
+
+            /**
+             * Returns the dirty ranges ordered by their position. Ranges which are separated by at most `maxGap` clean
+             * elements are merged, trading a few redundant elements for fewer uploads.
+             */
+            std::vector<Range> dirtyRanges(size_t maxGap = 0u) const;
         };
 
         /**
@@ -63,8 +86,9 @@ namespace TrenchBroom {
          * Non-copyable; meant to be held in a std::shared_ptr.
          * Able to be resized, and handles copying edits made in the local std::vector to the VBO.
          *
-         * Currently uses a single range to track the modified region which might upload much more than necessary;
-         * it might be worth mapping the VBO and editing it directly.
+         * Only the modified ranges are uploaded, unless they cover most of the buffer. In that case, the entire
+         * buffer is replaced at once, which lets the driver orphan the old storage instead of waiting until pending
+         * draw calls are done with it.
          */
         template<typename T>
         class VboHolder {
@@ -182,14 +206,21 @@ namespace TrenchBroom {
 
                 // otherwise, it's an incremental update of the dirty ranges.
 
-                if (!m_dirtyRange.clean()) {
-                    const size_t pos = m_dirtyRange.m_dirtyPos;
-                    const size_t size = m_dirtyRange.m_dirtySize;
+                // uploading a few clean elements is cheaper than issuing another call
+                constexpr auto maxGap = std::max(size_t(1), size_t(4096) / sizeof(T));
+                const auto ranges = m_dirtyRange.dirtyRanges(maxGap);
+
+                auto uploadSize = size_t(0);
+                for (const auto& range : ranges) {
+                    uploadSize += range.size;
+                }
 
-                    const size_t bytesFromStart = pos * sizeof(T);
-                    m_vbo->writeArray(bytesFromStart,
-                                      m_snapshot.data() + pos,
-                                      size);
+                if (2u * uploadSize > m_snapshot.size()) {
+                    m_vbo->replaceElements(m_snapshot);
+                } else {
+                    for (const auto& range : ranges) {
+                        m_vbo->writeArray(range.pos * sizeof(T), m_snapshot.data() + range.pos, range.size);
+                    }
                 }
 
                 m_dirtyRange = DirtyRangeTracker(m_snapshot.size());
@@ -216,7 +247,11 @@ namespace TrenchBroom {
         class IndexHolder : public VboHolder<GLuint> {
         public:
             using Index = GLuint;
-
+        private:
+            // scratch buffers for the arguments of glMultiDrawElements, kept to avoid allocating them every frame
+            mutable std::vector<GLsizei> m_drawCounts;
+            mutable std::vector<const GLvoid*> m_drawOffsets;
+        public:
             IndexHolder();
             /**
              * NOTE: This destructively moves the contents of `elements` into the Holder.
@@ -224,6 +259,10 @@ namespace TrenchBroom {
             explicit IndexHolder(std::vector<Index>& elements);
             void zeroRange(size_t offsetWithinBlock, size_t count);
             void render(PrimType primType, size_t offset, size_t count) const;
+            /**
+             * Renders the given ranges of indices with a single draw call.
+             */
+            void render(PrimType primType, const std::vector<AllocationTracker::Range>& ranges) const;
 
             static std::shared_ptr<IndexHolder> swap(std::vector<Index>& elements);
         };
@@ -260,6 +299,11 @@ namespace TrenchBroom {
             void zeroElementsWithKey(AllocationTracker::Block* key);
 
             void render(const PrimType primType) const;
+            /**
+             * Renders only the given ranges of indices, e.g. the ranges belonging to the brushes which are inside the
+             * view volume.
+             */
+            void render(const PrimType primType, const std::vector<AllocationTracker::Range>& ranges) const;
             bool prepared() const;
             void prepare(VboManager& vboManager);
 
@@ -20,11 +20,13 @@
 #pragma once
 
 #include "Color.h"
+#include "Renderer/AllocationTracker.h"
 #include "Renderer/IndexRangeMap.h"
 #include "Renderer/Renderable.h"
 #include "Renderer/VertexArray.h"
 
 #include <memory>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Renderer {
@@ -100,13 +102,16 @@ namespace TrenchBroom {
         };
 
         class IndexedEdgeRenderer : public EdgeRenderer {
+        public:
+            using IndexRanges = std::vector<AllocationTracker::Range>;
         private:
             class Render : public RenderBase, public IndexedRenderable {
             private:
                 std::shared_ptr<BrushVertexArray> m_vertexArray;
                 std::shared_ptr<BrushIndexArray> m_indexArray;
+                std::shared_ptr<const IndexRanges> m_indexRanges;
             public:
-                Render(const Params& params, std::shared_ptr<BrushVertexArray> vertexArray, std::shared_ptr<BrushIndexArray> indexArray);
+                Render(const Params& params, std::shared_ptr<BrushVertexArray> vertexArray, std::shared_ptr<BrushIndexArray> indexArray, std::shared_ptr<const IndexRanges> indexRanges);
             private:
                 void prepareVerticesAndIndices(VboManager& vboManager) override;
                 void doRender(RenderContext& renderContext) override;
@@ -115,6 +120,7 @@ namespace TrenchBroom {
         private:
             std::shared_ptr<BrushVertexArray> m_vertexArray;
             std::shared_ptr<BrushIndexArray> m_indexArray;
+            std::shared_ptr<const IndexRanges> m_indexRanges;
         public:
             IndexedEdgeRenderer();
             IndexedEdgeRenderer(std::shared_ptr<BrushVertexArray> vertexArray, std::shared_ptr<BrushIndexArray> indexArray);
@@ -123,6 +129,12 @@ namespace TrenchBroom {
             IndexedEdgeRenderer& operator=(IndexedEdgeRenderer other);
 
             friend void swap(IndexedEdgeRenderer& left, IndexedEdgeRenderer& right);
+
+            /**
+             * Restricts rendering to the given ranges of the index array. If the given pointer is null, the index array
+             * is rendered in full.
+             */
+            void setIndexRanges(std::shared_ptr<const IndexRanges> indexRanges);
         private:
             void doRender(RenderBatch& renderBatch, const EdgeRenderer::Params& params) override;
         };
@@ -32,26 +32,67 @@
 #include "Renderer/Shaders.h"
 #include "Renderer/ShaderManager.h"
 
+#include <optional>
+#include <string>
+
 namespace TrenchBroom {
     namespace Renderer {
+        /**
+         * Remembers the value of a uniform variable so that setting it to the same value again does not cause any
+         * calls to OpenGL. Only meant to be used while a single shader is active.
+         */
+        template <typename T>
+        class CachedUniform {
+        private:
+            std::string m_name;
+            std::optional<T> m_value;
+        public:
+            explicit CachedUniform(std::string name) :
+            m_name(std::move(name)) {}
+
+            void set(ActiveShader& shader, const T& value) {
+                if (!m_value || !(*m_value == value)) {
+                    shader.set(m_name, value);
+                    m_value = value;
+                }
+            }
+        };
+
         struct FaceRenderer::RenderFunc : public TextureRenderFunc {
             ActiveShader& shader;
             bool applyTexture;
             const Color& defaultColor;
 
+            // most textures share these values, so they are only set when they change
+            CachedUniform<bool> applyTextureUniform;
+            CachedUniform<Color> colorUniform;
+            CachedUniform<vm::vec3f> gridColorUniform;
+            CachedUniform<bool> enableMaskedUniform;
+
             RenderFunc(ActiveShader& i_shader, const bool i_applyTexture, const Color& i_defaultColor) :
             shader(i_shader),
             applyTexture(i_applyTexture),
-            defaultColor(i_defaultColor) {}
+            defaultColor(i_defaultColor),
+            applyTextureUniform("ApplyTexture"),
+            colorUniform("Color"),
+            gridColorUniform("GridColor"),
+            enableMaskedUniform("EnableMasked") {}
 
             void before(const Assets::Texture* texture) override {
+                const bool enableMasked = texture != nullptr && texture->masked() && texture->isPrepared();
+
+                // set any per-texture uniforms
+                gridColorUniform.set(shader, gridColorForTexture(texture));
+                enableMaskedUniform.set(shader, enableMasked);
+
                 if (texture != nullptr) {
                     texture->activate();
-                    shader.set("ApplyTexture", applyTexture);
-                    shader.set("Color", texture->averageColor());
+                    // textures which have not been uploaded yet are rendered using their average color
+                    applyTextureUniform.set(shader, applyTexture && texture->isPrepared());
+                    colorUniform.set(shader, texture->averageColor());
                 } else {
-                    shader.set("ApplyTexture", false);
-                    shader.set("Color", defaultColor);
+                    applyTextureUniform.set(shader, false);
+                    colorUniform.set(shader, defaultColor);
                 }
             }
 
@@ -79,6 +120,7 @@ namespace TrenchBroom {
         IndexedRenderable(other),
         m_vertexArray(other.m_vertexArray),
         m_indexArrayMap(other.m_indexArrayMap),
+        m_indexRanges(other.m_indexRanges),
         m_faceColor(other.m_faceColor),
         m_grayscale(other.m_grayscale),
         m_tint(other.m_tint),
@@ -95,6 +137,7 @@ namespace TrenchBroom {
             using std::swap;
             swap(left.m_vertexArray, right.m_vertexArray);
             swap(left.m_indexArrayMap, right.m_indexArrayMap);
+            swap(left.m_indexRanges, right.m_indexRanges);
             swap(left.m_faceColor, right.m_faceColor);
             swap(left.m_grayscale, right.m_grayscale);
             swap(left.m_tint, right.m_tint);
@@ -118,6 +161,10 @@ namespace TrenchBroom {
             m_alpha = alpha;
         }
 
+        void FaceRenderer::setIndexRanges(std::shared_ptr<const TextureToIndexRangesMap> indexRanges) {
+            m_indexRanges = std::move(indexRanges);
+        }
+
         void FaceRenderer::render(RenderBatch& renderBatch) {
             renderBatch.add(this);
         }
@@ -149,7 +196,6 @@ namespace TrenchBroom {
                 shader.set("RenderGrid", context.showGrid());
                 shader.set("GridSize", static_cast<float>(context.gridSize()));
                 shader.set("GridAlpha", prefs.get(Preferences::GridAlpha));
-                shader.set("ApplyTexture", applyTexture);
                 shader.set("Texture", 0);
                 shader.set("ApplyTinting", m_tint);
                 if (m_tint)
@@ -159,7 +205,6 @@ namespace TrenchBroom {
                 shader.set("ShadeFaces", shadeFaces);
                 shader.set("ShowFog", showFog);
                 shader.set("Alpha", m_alpha);
-                shader.set("EnableMasked", false);
                 shader.set("ShowSoftMapBounds", !context.softMapBounds().is_empty());
                 shader.set("SoftMapBoundsMin", context.softMapBounds().min);
                 shader.set("SoftMapBoundsMax", context.softMapBounds().max);
@@ -177,15 +222,22 @@ namespace TrenchBroom {
                         continue;
                     }
 
-                    const bool enableMasked = texture != nullptr && texture->masked();
-                    
-                    // set any per-texture uniforms
-                    shader.set("GridColor", gridColorForTexture(texture));
-                    shader.set("EnableMasked", enableMasked);
+                    const std::vector<AllocationTracker::Range>* ranges = nullptr;
+                    if (m_indexRanges != nullptr) {
+                        const auto it = m_indexRanges->find(texture);
+                        if (it == std::end(*m_indexRanges)) {
+                            continue;
+                        }
+                        ranges = &it->second;
+                    }
 
                     func.before(texture);
                     brushIndexHolderPtr->setupIndices();
-                    brushIndexHolderPtr->render(PrimType::Triangles);
+                    if (ranges != nullptr) {
+                        brushIndexHolderPtr->render(PrimType::Triangles, *ranges);
+                    } else {
+                        brushIndexHolderPtr->render(PrimType::Triangles);
+                    }
                     brushIndexHolderPtr->cleanupIndices();
                     func.after(texture);
                 }
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Color.h"
+#include "Renderer/AllocationTracker.h"
 #include "Renderer/Renderable.h"
 
 #include <vecmath/forward.h>
@@ -27,6 +28,7 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Assets {
@@ -39,6 +41,8 @@ namespace TrenchBroom {
         class RenderBatch;
 
         class FaceRenderer : public IndexedRenderable {
+        public:
+            using TextureToIndexRangesMap = std::unordered_map<const Assets::Texture*, std::vector<AllocationTracker::Range>>;
         private:
             struct RenderFunc;
 
@@ -46,6 +50,7 @@ namespace TrenchBroom {
 
             std::shared_ptr<BrushVertexArray> m_vertexArray;
             std::shared_ptr<TextureToBrushIndicesMap> m_indexArrayMap;
+            std::shared_ptr<const TextureToIndexRangesMap> m_indexRanges;
             Color m_faceColor;
             bool m_grayscale;
             bool m_tint;
@@ -64,6 +69,12 @@ namespace TrenchBroom {
             void setTintColor(const Color& color);
             void setAlpha(float alpha);
 
+            /**
+             * Restricts rendering to the given ranges of the index arrays. Textures which are not contained in the given
+             * map are skipped entirely. If the given pointer is null, the index arrays are rendered in full.
+             */
+            void setIndexRanges(std::shared_ptr<const TextureToIndexRangesMap> indexRanges);
+
             void render(RenderBatch& renderBatch);
         private:
             void prepareVerticesAndIndices(VboManager& vboManager) override;
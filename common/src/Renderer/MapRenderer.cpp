@@ -32,6 +32,7 @@
 #include "Model/Node.h"
 #include "Model/PatchNode.h"
 #include "Model/WorldNode.h"
+#include "Renderer/BrushCuller.h"
 #include "Renderer/BrushRenderer.h"
 #include "Renderer/EntityLinkRenderer.h"
 #include "Renderer/GroupLinkRenderer.h"
@@ -46,6 +47,7 @@
 #include <kdl/overload.h>
 #include <kdl/vector_set.h>
 
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -133,7 +135,8 @@ namespace TrenchBroom {
         m_selectionRenderer(createSelectionRenderer(m_document)),
         m_lockedRenderer(createLockRenderer(m_document)),
         m_entityLinkRenderer(std::make_unique<EntityLinkRenderer>(m_document)),
-        m_groupLinkRenderer(std::make_unique<GroupLinkRenderer>(m_document)) {
+        m_groupLinkRenderer(std::make_unique<GroupLinkRenderer>(m_document)),
+        m_brushCuller(std::make_unique<BrushCuller>()) {
             bindObservers();
             setupRenderers();
         }
@@ -171,6 +174,7 @@ namespace TrenchBroom {
             m_defaultRenderer->clear();
             m_selectionRenderer->clear();
             m_lockedRenderer->clear();
+            m_brushCuller->clear();
             m_entityLinkRenderer->invalidate();
             m_groupLinkRenderer->invalidate();
         }
@@ -192,6 +196,7 @@ namespace TrenchBroom {
 
         void MapRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch) {
             commitPendingChanges();
+            cullBrushes(renderContext);
             setupGL(renderBatch);
             renderDefaultOpaque(renderContext, renderBatch);
             renderLockedOpaque(renderContext, renderBatch);
@@ -210,6 +215,20 @@ namespace TrenchBroom {
             document->commitPendingAssets();
         }
 
+        void MapRenderer::cullBrushes(RenderContext& renderContext) {
+            auto document = kdl::mem_lock(m_document);
+            const auto* world = document->world();
+            if (world == nullptr) {
+                return;
+            }
+
+            // each view has its own camera, so the culled brushes are cached per camera
+            const auto visibleBrushes = m_brushCuller->cull(*world, renderContext.camera());
+            m_defaultRenderer->setVisibleBrushes(visibleBrushes);
+            m_selectionRenderer->setVisibleBrushes(visibleBrushes);
+            m_lockedRenderer->setVisibleBrushes(visibleBrushes);
+        }
+
         class SetupGL : public Renderable {
         private:
             void doRender(RenderContext&) override {
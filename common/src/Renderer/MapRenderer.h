@@ -47,6 +47,7 @@ namespace TrenchBroom {
     }
 
     namespace Renderer {
+        class BrushCuller;
         class EntityLinkRenderer;
         class GroupLinkRenderer;
         class ObjectRenderer;
@@ -68,6 +69,7 @@ namespace TrenchBroom {
             std::unique_ptr<ObjectRenderer> m_lockedRenderer;
             std::unique_ptr<EntityLinkRenderer> m_entityLinkRenderer;
             std::unique_ptr<GroupLinkRenderer> m_groupLinkRenderer;
+            std::unique_ptr<BrushCuller> m_brushCuller;
         public:
             explicit MapRenderer(std::weak_ptr<View::MapDocument> document);
             ~MapRenderer();
@@ -85,6 +87,12 @@ namespace TrenchBroom {
             void render(RenderContext& renderContext, RenderBatch& renderBatch);
         private:
             void commitPendingChanges();
+            /**
+             * Finds the brushes which intersect with the view volume of the current camera using the world's node tree,
+             * and restricts the object renderers to these brushes. The result is cached for each camera because all map
+             * views share this renderer.
+             */
+            void cullBrushes(RenderContext& renderContext);
             void setupGL(RenderBatch& renderBatch);
             void renderDefaultOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderDefaultTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
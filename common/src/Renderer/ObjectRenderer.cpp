@@ -147,6 +147,10 @@ namespace TrenchBroom {
             m_brushRenderer.setShowHiddenBrushes(showHiddenObjects);
         }
 
+        void ObjectRenderer::setVisibleBrushes(std::shared_ptr<const std::vector<const Model::BrushNode*>> visibleBrushes) {
+            m_brushRenderer.setVisibleBrushes(std::move(visibleBrushes));
+        }
+
         void ObjectRenderer::renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch) {
             m_brushRenderer.renderOpaque(renderContext, renderBatch);
             m_patchRenderer.render(renderContext, renderBatch);
@@ -24,6 +24,7 @@
 #include "Renderer/GroupRenderer.h"
 #include "Renderer/PatchRenderer.h"
 
+#include <memory>
 #include <vector>
 
 namespace TrenchBroom {
@@ -93,6 +94,8 @@ namespace TrenchBroom {
             void setBrushEdgeColor(const Color& brushEdgeColor);
 
             void setShowHiddenObjects(bool showHiddenObjects);
+
+            void setVisibleBrushes(std::shared_ptr<const std::vector<const Model::BrushNode*>> visibleBrushes);
         public: // rendering
             void renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
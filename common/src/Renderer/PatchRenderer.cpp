@@ -247,7 +247,8 @@ namespace TrenchBroom {
                     shader.set("GridColor", gridColorForTexture(texture));
                     if (texture != nullptr) {
                         texture->activate();
-                        shader.set("ApplyTexture", applyTexture);
+                        // textures which have not been uploaded yet are rendered using their average color
+                        shader.set("ApplyTexture", applyTexture && texture->isPrepared());
                         shader.set("Color", texture->averageColor());
                     } else {
                         shader.set("ApplyTexture", false);
@@ -48,10 +48,14 @@ namespace TrenchBroom {
         }
 
         void SpikeGuideRenderer::add(const vm::ray3& ray, const FloatType length, std::shared_ptr<View::MapDocument> document) {
+            const auto findHit = [](const Model::PickResult& pickResult) -> const Model::Hit& {
+                return pickResult.query().pickable().type(Model::BrushNode::BrushHitType).occluded().minDistance(1.0).first();
+            };
+
             Model::PickResult pickResult = Model::PickResult::byDistance(document->editorContext());
-            document->pick(ray, pickResult);
+            document->pickClosest(ray, pickResult, findHit);
 
-            const Model::Hit& hit = pickResult.query().pickable().type(Model::BrushNode::BrushHitType).occluded().minDistance(1.0).first();
+            const Model::Hit& hit = findHit(pickResult);
             if (hit.isMatch()) {
                 if (hit.distance() <= length)
                     addPoint(vm::point_at_distance(ray, hit.distance() - 0.01));
@@ -27,7 +27,8 @@ namespace TrenchBroom {
     namespace Renderer {
         Vbo::Vbo(GLenum type, const size_t capacity, const GLenum usage) :
         m_type(type),
-        m_capacity(capacity) {
+        m_capacity(capacity),
+        m_usage(usage) {
             assert(m_type == GL_ELEMENT_ARRAY_BUFFER
                    || m_type == GL_ARRAY_BUFFER);
 
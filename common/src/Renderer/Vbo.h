@@ -39,6 +39,7 @@ namespace TrenchBroom {
              */
             GLenum m_type;
             size_t m_capacity;
+            GLenum m_usage;
             GLuint m_bufferId;
 
             /**
@@ -100,6 +101,36 @@ namespace TrenchBroom {
 
                 return size;
             }
+
+            template <typename T>
+            size_t replaceElements(const std::vector<T>& elements) {
+                return replaceArray(elements.data(), elements.size());
+            }
+
+            /**
+             * Replaces the entire contents of the VBO block with the given C array. Unlike writing the array, this
+             * allows the driver to allocate new storage instead of waiting until the GPU is done with the old one.
+             *
+             * @tparam T        element type
+             * @param array     elements to write
+             * @param count     number of elements to write, must fill the entire block
+             * @return          number of bytes written
+             */
+            template <typename T>
+            size_t replaceArray(const T* array, const size_t count) {
+                const size_t size = count * sizeof(T);
+                assert(size == m_capacity);
+
+                static_assert(std::is_trivially_copyable<T>::value);
+                static_assert(std::is_standard_layout<T>::value);
+
+                const GLvoid* ptr = static_cast<const GLvoid*>(array);
+                const GLsizeiptr sizei = static_cast<GLsizeiptr>(size);
+                glAssert(glBindBuffer(m_type, m_bufferId));
+                glAssert(glBufferData(m_type, sizei, ptr, m_usage));
+
+                return size;
+            }
         };
     }
 }
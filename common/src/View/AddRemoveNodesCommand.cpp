@@ -21,6 +21,7 @@
 
 #include "Ensure.h"
 #include "Macros.h"
+#include "Model/ModelUtils.h"
 #include "Model/Node.h"
 #include "Model/UpdateLinkedGroupsError.h"
 #include "View/MapDocumentCommandFacade.h"
@@ -58,7 +59,8 @@ namespace TrenchBroom {
         AddRemoveNodesCommand::AddRemoveNodesCommand(const Action action, const std::map<Model::Node*, std::vector<Model::Node*>>& nodes, std::vector<std::pair<const Model::GroupNode*, std::vector<Model::GroupNode*>>> linkedGroupsToUpdate) :
         UndoableCommand(Type, makeName(action), true),
         m_action(action),
-        m_updateLinkedGroupsHelper(std::move(linkedGroupsToUpdate)) {
+        m_updateLinkedGroupsHelper(std::move(linkedGroupsToUpdate)),
+        m_memorySize(0u) {
             switch (m_action) {
                 case Action::Add:
                     m_nodesToAdd = nodes;
@@ -89,12 +91,15 @@ namespace TrenchBroom {
                     undoAction(document);
                 });
 
+            updateMemorySize();
             return std::make_unique<CommandResult>(success);
         }
 
         std::unique_ptr<CommandResult> AddRemoveNodesCommand::doPerformUndo(MapDocumentCommandFacade* document) {
             undoAction(document);
             m_updateLinkedGroupsHelper.undoLinkedGroupUpdates(*document);
+
+            updateMemorySize();
             return std::make_unique<CommandResult>(true);
         }
 
@@ -130,5 +135,14 @@ namespace TrenchBroom {
         bool AddRemoveNodesCommand::doCollateWith(UndoableCommand*) {
             return false;
         }
+
+        size_t AddRemoveNodesCommand::doGetMemorySize() const {
+            return m_memorySize;
+        }
+
+        void AddRemoveNodesCommand::updateMemorySize() {
+            // the nodes to add are not part of the document, see doAction and undoAction
+            m_memorySize = Model::estimateMemorySize(Model::collectChildren(m_nodesToAdd)) + m_updateLinkedGroupsHelper.memorySize();
+        }
     }
 }
@@ -47,6 +47,7 @@ namespace TrenchBroom {
             std::map<Model::Node*, std::vector<Model::Node*>> m_nodesToAdd;
             std::map<Model::Node*, std::vector<Model::Node*>> m_nodesToRemove;
             UpdateLinkedGroupsHelper m_updateLinkedGroupsHelper;
+            size_t m_memorySize;
         public:
             static std::unique_ptr<AddRemoveNodesCommand> add(Model::Node* parent, const std::vector<Model::Node*>& children, std::vector<std::pair<const Model::GroupNode*, std::vector<Model::GroupNode*>>> linkedGroupsToUpdate);
             static std::unique_ptr<AddRemoveNodesCommand> add(const std::map<Model::Node*, std::vector<Model::Node*>>& nodes, std::vector<std::pair<const Model::GroupNode*, std::vector<Model::GroupNode*>>> linkedGroupsToUpdate);
@@ -65,6 +66,12 @@ namespace TrenchBroom {
 
             bool doCollateWith(UndoableCommand* command) override;
 
+            /**
+             * The nodes that are not part of the document are owned by this command, so they are counted.
+             */
+            size_t doGetMemorySize() const override;
+            void updateMemorySize();
+
             deleteCopyAndMove(AddRemoveNodesCommand)
         };
     }
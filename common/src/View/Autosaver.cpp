@@ -22,17 +22,31 @@
 #include "Exceptions.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/DiskIO.h"
+#include "IO/PathQt.h"
+#include "Model/BrushNode.h"
+#include "Model/EntityNode.h"
+#include "Model/Game.h"
+#include "Model/GroupNode.h"
+#include "Model/LayerNode.h"
+#include "Model/PatchNode.h"
+#include "Model/WorldNode.h"
 #include "View/MapDocument.h"
 
 #include <kdl/memory_utils.h>
+#include <kdl/overload.h>
 #include <kdl/string_compare.h>
 #include <kdl/string_format.h>
 #include <kdl/string_utils.h>
 
 #include <algorithm> // for std::sort
 #include <cassert>
+#include <exception>
 #include <limits>
 #include <memory>
+#include <sstream>
+#include <string>
+
+#include <QSaveFile>
 
 namespace TrenchBroom {
     namespace View {
@@ -69,11 +83,25 @@ namespace TrenchBroom {
         m_lastSaveTime(Clock::now()),
         m_lastModificationCount(kdl::mem_lock(m_document)->modificationCount()) {}
 
+        Autosaver::~Autosaver() {
+            if (m_pendingBackup.valid()) {
+                m_pendingBackup.wait();
+            }
+        }
+
         void Autosaver::triggerAutosave(Logger& logger) {
             if (kdl::mem_expired(m_document)) {
                 return;
             }
 
+            if (m_pendingBackup.valid()) {
+                if (m_pendingBackup.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                    // the previous backup is still being written, try again later
+                    return;
+                }
+                finishPendingBackup(logger);
+            }
+
             const auto currentTime = Clock::now();
 
             auto document = kdl::mem_lock(m_document);
@@ -98,6 +126,109 @@ namespace TrenchBroom {
             autosave(logger, document);
         }
 
+        void Autosaver::waitForPendingBackup(Logger& logger) {
+            if (m_pendingBackup.valid()) {
+                finishPendingBackup(logger);
+            }
+        }
+
+        /**
+         * Copies the persistent IDs of the given original layers and groups to their clones. The clones are expected to
+         * have the same structure as the originals.
+         */
+        static void copyPersistentIds(const Model::Node* original, Model::Node* clone) {
+            assert(original->childCount() == clone->childCount());
+
+            original->accept(kdl::overload(
+                [] (const Model::WorldNode*)  {},
+                [&](const Model::LayerNode* layer) {
+                    if (const auto& persistentId = layer->persistentId()) {
+                        static_cast<Model::LayerNode*>(clone)->setPersistentId(*persistentId);
+                    }
+                },
+                [&](const Model::GroupNode* group) {
+                    if (const auto& persistentId = group->persistentId()) {
+                        static_cast<Model::GroupNode*>(clone)->setPersistentId(*persistentId);
+                    }
+                },
+                [] (const Model::EntityNode*) {},
+                [] (const Model::BrushNode*)  {},
+                [] (const Model::PatchNode*)  {}
+            ));
+
+            for (size_t i = 0; i < original->childCount(); ++i) {
+                copyPersistentIds(original->children()[i], clone->children()[i]);
+            }
+        }
+
+        /**
+         * Resets all asset references held by the given node and its descendants. Asset usage counts are not thread
+         * safe, so a snapshot must not reference any assets before it is handed to another thread.
+         */
+        static void detachAssets(Model::Node* node) {
+            node->accept(kdl::overload(
+                [] (auto&& thisLambda, Model::WorldNode* world)   { world->setDefinition(nullptr); world->visitChildren(thisLambda); },
+                [] (auto&& thisLambda, Model::LayerNode* layer)   { layer->visitChildren(thisLambda); },
+                [] (auto&& thisLambda, Model::GroupNode* group)   { group->visitChildren(thisLambda); },
+                [] (auto&& thisLambda, Model::EntityNode* entity) {
+                    entity->setDefinition(nullptr);
+                    entity->setModelFrame(nullptr);
+                    entity->visitChildren(thisLambda);
+                },
+                [] (Model::BrushNode* brush) {
+                    for (size_t i = 0; i < brush->brush().faceCount(); ++i) {
+                        brush->setFaceTexture(i, nullptr);
+                    }
+                },
+                [] (Model::PatchNode* patch) { patch->setTexture(nullptr); }
+            ));
+        }
+
+        /**
+         * Creates a copy of the given world that can be serialized on another thread. The copy retains the persistent
+         * IDs of the original layers and groups, but it does not reference any assets and its node tree is not built.
+         */
+        static std::unique_ptr<Model::WorldNode> snapshotWorld(const Model::WorldNode& world, const vm::bbox3& worldBounds) {
+            auto snapshot = std::unique_ptr<Model::WorldNode>(static_cast<Model::WorldNode*>(world.clone(worldBounds)));
+            snapshot->disableNodeTreeUpdates();
+
+            const auto* defaultLayer = world.defaultLayer();
+            auto* snapshotDefaultLayer = snapshot->defaultLayer();
+            snapshotDefaultLayer->setLayer(defaultLayer->layer());
+            snapshotDefaultLayer->setVisibilityState(defaultLayer->visibilityState());
+            snapshotDefaultLayer->setLockState(defaultLayer->lockState());
+
+            for (const auto* child : defaultLayer->children()) {
+                snapshotDefaultLayer->addChild(child->cloneRecursively(worldBounds));
+            }
+            for (const auto* layer : world.customLayers()) {
+                snapshot->addChild(layer->cloneRecursively(worldBounds));
+            }
+
+            copyPersistentIds(&world, snapshot.get());
+            detachAssets(snapshot.get());
+
+            return snapshot;
+        }
+
+        /**
+         * Serializes the given snapshot and writes it to a temporary file which replaces the backup file once it was
+         * written completely, so that a backup file is never left partially written.
+         */
+        static IO::Path writeBackup(std::shared_ptr<Model::Game> game, std::unique_ptr<Model::WorldNode> snapshot, const IO::Path& backupFilePath) {
+            auto stream = std::stringstream{};
+            game->writeMapToStream(*snapshot, stream);
+            const auto mapData = stream.str();
+
+            QSaveFile file(IO::pathAsQString(backupFilePath));
+            if (!file.open(QIODevice::WriteOnly | QIODevice::Text)
+                || file.write(mapData.data(), static_cast<qint64>(mapData.size())) != static_cast<qint64>(mapData.size())
+                || !file.commit()) {
+                throw FileSystemException("Cannot write file " + backupFilePath.asString() + ": " + file.errorString().toStdString());
+            }
+            return backupFilePath;
+        }
+
         void Autosaver::autosave(Logger& logger, std::shared_ptr<MapDocument> document) {
             const auto& mapPath = document->path();
             assert(IO::Disk::fileExists(IO::Disk::fixPath(mapPath)));
@@ -117,12 +248,23 @@ namespace TrenchBroom {
 
                 const auto backupFilePath = fs.makeAbsolute(makeBackupName(mapBasename, backupNo));
 
+                // Copying the nodes is much cheaper than serializing them, so only the snapshot is taken on this thread.
+                // The snapshot is serialized and written on a background thread, which does not access the document.
+                auto snapshot = snapshotWorld(*document->world(), document->worldBounds());
+
                 m_lastSaveTime = Clock::now();
                 m_lastModificationCount = document->modificationCount();
-                document->saveDocumentTo(backupFilePath);
+                m_pendingBackup = std::async(std::launch::async, writeBackup, document->game(), std::move(snapshot), backupFilePath);
+            } catch (const FileSystemException& e) {
+                logger.error() << "Aborting autosave: " << e.what();
+            }
+        }
 
+        void Autosaver::finishPendingBackup(Logger& logger) {
+            try {
+                const auto backupFilePath = m_pendingBackup.get();
                 logger.info() << "Created autosave backup at " << backupFilePath;
-            } catch (const FileSystemException& e) {
+            } catch (const std::exception& e) {
                 logger.error() << "Aborting autosave: " << e.what();
             }
         }
@@ -22,7 +22,9 @@
 #include "IO/Path.h"
 
 #include <chrono>
+#include <future>
 #include <memory>
+#include <vector>
 
 namespace TrenchBroom {
     class Logger;
@@ -69,13 +71,25 @@ namespace TrenchBroom {
              * The modification count that was last recorded.
              */
             size_t m_lastModificationCount;
-            
+
+            /**
+             * The backup that is currently being written on a background thread, if any. Yields the path of the backup
+             * file, or throws an exception if the file could not be written.
+             */
+            std::future<IO::Path> m_pendingBackup;
         public:
             explicit Autosaver(std::weak_ptr<MapDocument> document, std::chrono::milliseconds saveInterval = std::chrono::milliseconds(10 * 60 * 1000), size_t maxBackups = 50);
+            ~Autosaver();
 
             void triggerAutosave(Logger& logger);
+
+            /**
+             * Waits until the backup that is currently being written, if any, is written and logs the result.
+             */
+            void waitForPendingBackup(Logger& logger);
         private:
             void autosave(Logger& logger, std::shared_ptr<View::MapDocument> document);
+            void finishPendingBackup(Logger& logger);
             IO::WritableDiskFileSystem createBackupFileSystem(Logger& logger, const IO::Path& mapPath) const;
             std::vector<IO::Path> collectBackups(const IO::WritableDiskFileSystem& fs, const IO::Path& mapBasename) const;
             void thinBackups(Logger& logger, IO::WritableDiskFileSystem& fs, std::vector<IO::Path>& backups) const;
@@ -22,6 +22,7 @@
 #include "Exceptions.h"
 #include "Notifier.h"
 #include "View/Command.h"
+#include "View/MapDocumentCommandFacade.h"
 #include "View/UndoableCommand.h"
 
 #include <kdl/set_temp.h>
@@ -108,13 +109,28 @@ namespace TrenchBroom {
             bool doCollateWith(UndoableCommand*) override {
                 return false;
             }
+
+            size_t doGetMemorySize() const override {
+                auto result = size_t(0);
+                for (const auto& command : m_commands) {
+                    result += command->memorySize();
+                }
+                return result;
+            }
+
+            void doCompact(MapDocumentCommandFacade* document) override {
+                for (auto& command : m_commands) {
+                    command->compact(document);
+                }
+            }
         };
 
         const Command::CommandType CommandProcessor::TransactionCommand::Type = Command::freeType();
 
-        CommandProcessor::CommandProcessor(MapDocumentCommandFacade* document, const std::chrono::milliseconds collationInterval) :
+        CommandProcessor::CommandProcessor(MapDocumentCommandFacade* document, const std::chrono::milliseconds collationInterval, const std::optional<size_t> undoMemoryBudget) :
         m_document(document),
         m_collationInterval(collationInterval),
+        m_undoMemoryBudget(undoMemoryBudget),
         m_lastCommandTimestamp(std::chrono::time_point<std::chrono::system_clock>()) {}
 
         CommandProcessor::~CommandProcessor() = default;
@@ -315,14 +331,44 @@ namespace TrenchBroom {
             if (collatable(collate, timestamp)) {
                 auto& lastCommand = m_undoStack.back();
                 if (lastCommand->collateWith(command.get())) {
+                    trimUndoStack();
                     return false;
                 }
             }
 
+            if (!m_undoStack.empty()) {
+                m_undoStack.back()->compact(m_document);
+            }
             m_undoStack.push_back(std::move(command));
+            trimUndoStack();
             return true;
         }
 
+        void CommandProcessor::trimUndoStack() {
+            if (!m_undoMemoryBudget) {
+                return;
+            }
+
+            auto memorySize = size_t(0);
+            for (const auto& command : m_undoStack) {
+                memorySize += command->memorySize();
+            }
+
+            // always keep the most recent command so that it can be undone
+            auto count = size_t(0);
+            while (memorySize > *m_undoMemoryBudget && count + 1u < m_undoStack.size()) {
+                memorySize -= m_undoStack[count]->memorySize();
+                ++count;
+            }
+
+            if (count > 0u) {
+                m_undoStack.erase(std::begin(m_undoStack), std::next(std::begin(m_undoStack), static_cast<std::ptrdiff_t>(count)));
+                if (m_document) {
+                    m_document->info() << "Discarded the " << count << " oldest undo steps to stay within the undo memory budget";
+                }
+            }
+        }
+
         std::unique_ptr<UndoableCommand> CommandProcessor::popFromUndoStack() {
             assert(m_transactionStack.empty());
             assert(!m_undoStack.empty());
@@ -336,6 +382,9 @@ namespace TrenchBroom {
 
         void CommandProcessor::pushToRedoStack(std::unique_ptr<UndoableCommand> command) {
             assert(m_transactionStack.empty());
+            if (!m_redoStack.empty()) {
+                m_redoStack.back()->compact(m_document);
+            }
             m_redoStack.push_back(std::move(command));
         }
 
@@ -23,6 +23,7 @@
 
 #include <chrono>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -59,6 +60,12 @@ namespace TrenchBroom {
              */
             std::chrono::milliseconds m_collationInterval;
 
+            /**
+             * If set, the oldest commands are removed from the undo stack whenever the estimated memory used by the
+             * commands on the undo stack exceeds this number of bytes. The most recent command is always kept.
+             */
+            std::optional<size_t> m_undoMemoryBudget;
+
             /**
              * Holds the commands that were executed so far, with the most recently executed command at the
              * end of the vector.
@@ -91,8 +98,11 @@ namespace TrenchBroom {
              * executed or undone.
              *
              * @param document the document to pass to commands, may be null
+             * @param collationInterval the maximum time between two commands that can be collated
+             * @param undoMemoryBudget the maximum estimated memory used by the undo stack in bytes, or nothing if the
+             * undo stack should not be limited
              */
-            explicit CommandProcessor(MapDocumentCommandFacade* document, std::chrono::milliseconds collationInterval = std::chrono::milliseconds(1000));
+            explicit CommandProcessor(MapDocumentCommandFacade* document, std::chrono::milliseconds collationInterval = std::chrono::milliseconds(1000), std::optional<size_t> undoMemoryBudget = std::nullopt);
 
             ~CommandProcessor();
 
@@ -323,7 +333,7 @@ namespace TrenchBroom {
             /**
              * Pushes the given command onto the undo stack, unless it can be collated with the topmost command on the
              * undo stack. Takes ownership of the given command, so if it isn't stored on the undo stack, the command is
-             * deleted.
+             * deleted. If the given command is stored, the previously topmost command is compacted.
              *
              * @param command the command to push
              * @param collate whether or not it should be attempted to collate the given command with the topmost command
@@ -332,6 +342,12 @@ namespace TrenchBroom {
              */
             bool pushToUndoStack(std::unique_ptr<UndoableCommand> command, bool collate);
 
+            /**
+             * Removes the oldest commands from the undo stack until the estimated memory used by the remaining commands
+             * does not exceed the undo memory budget. Does nothing if no budget is set.
+             */
+            void trimUndoStack();
+
             /**
              * Pops the topmost command from the undo stack and returns it.
              *
@@ -344,7 +360,8 @@ namespace TrenchBroom {
             bool collatable(bool collate, std::chrono::system_clock::time_point timestamp) const;
 
             /**
-             * Pushes the given command onto the redo stack. Takes ownership of the given command.
+             * Pushes the given command onto the redo stack and compacts the previously topmost command. Takes ownership
+             * of the given command.
              *
              * @param command the command to push
              */
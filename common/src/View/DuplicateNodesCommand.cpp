@@ -19,6 +19,7 @@
 
 #include "DuplicateNodesCommand.h"
 
+#include "Model/ModelUtils.h"
 #include "Model/Node.h"
 #include "Model/LayerNode.h"
 #include "View/MapDocumentCommandFacade.h"
@@ -36,7 +37,8 @@ namespace TrenchBroom {
 
         DuplicateNodesCommand::DuplicateNodesCommand() :
         UndoableCommand(Type, "Duplicate Objects", true),
-        m_firstExecution(true) {}
+        m_firstExecution(true),
+        m_memorySize(0u) {}
 
         DuplicateNodesCommand::~DuplicateNodesCommand() {
             if (state() == CommandState::Default) {
@@ -86,6 +88,8 @@ namespace TrenchBroom {
             document->performAddNodes(m_addedNodes);
             document->performDeselectAll();
             document->performSelect(m_nodesToSelect);
+
+            m_memorySize = 0u;
             return std::make_unique<CommandResult>(true);
         }
 
@@ -93,6 +97,8 @@ namespace TrenchBroom {
             document->performDeselectAll();
             document->performRemoveNodes(m_addedNodes);
             document->performSelect(m_previouslySelectedNodes);
+
+            m_memorySize = Model::estimateMemorySize(Model::collectChildren(m_addedNodes));
             return std::make_unique<CommandResult>(true);
         }
 
@@ -114,5 +120,9 @@ namespace TrenchBroom {
         bool DuplicateNodesCommand::doCollateWith(UndoableCommand*) {
             return false;
         }
+
+        size_t DuplicateNodesCommand::doGetMemorySize() const {
+            return m_memorySize;
+        }
     }
 }
@@ -40,6 +40,7 @@ namespace TrenchBroom {
             std::vector<Model::Node*> m_nodesToSelect;
             std::map<Model::Node*, std::vector<Model::Node*>> m_addedNodes;
             bool m_firstExecution;
+            size_t m_memorySize;
         public:
             static std::unique_ptr<DuplicateNodesCommand> duplicate();
 
@@ -53,6 +54,11 @@ namespace TrenchBroom {
 
             bool doCollateWith(UndoableCommand* command) override;
 
+            /**
+             * The duplicates are owned by this command while it is undone, so they are only counted then.
+             */
+            size_t doGetMemorySize() const override;
+
             deleteCopyAndMove(DuplicateNodesCommand)
         };
     }
@@ -32,9 +32,13 @@
 
 #include <kdl/memory_utils.h>
 #include <kdl/overload.h>
+#include <kdl/parallel.h>
 #include <kdl/vector_utils.h>
 #include <kdl/vector_set.h>
 
+#include <algorithm>
+#include <chrono>
+#include <iterator>
 #include <vector>
 
 #include <QHBoxLayout>
@@ -50,7 +54,8 @@ namespace TrenchBroom {
         m_document(document),
         m_hiddenGenerators(0),
         m_showHiddenIssues(false),
-        m_valid(false) {
+        m_valid(false),
+        m_resumeValidation(false) {
             createGui();
             bindEvents();
         }
@@ -114,32 +119,67 @@ namespace TrenchBroom {
             document->select(nodes);
         }
 
-        void IssueBrowserView::updateIssues() {
+        // the time to spend generating issues before the list is updated and control returns to the event loop
+        static constexpr auto ValidationTimeBudget = std::chrono::milliseconds(50);
+        static constexpr auto ValidationBatchSize = size_t(512);
+
+        bool IssueBrowserView::updateIssues() {
             auto document = kdl::mem_lock(m_document);
-            if (document->world() != nullptr) {
-                const auto& issueGenerators = document->world()->registeredIssueGenerators();
-                
+            if (document->world() == nullptr) {
+                m_tableModel->setIssues({});
+                return true;
+            }
+
+            const auto& issueGenerators = document->world()->registeredIssueGenerators();
+
+            // collect the nodes in document order so that the issues are always listed in the same order, regardless
+            // of how the validation was split into batches and threads
+            auto nodes = std::vector<Model::Node*>{};
+            document->world()->accept(kdl::overload(
+                [&](auto&& thisLambda, Model::WorldNode* world)   { nodes.push_back(world); world->visitChildren(thisLambda); },
+                [&](auto&& thisLambda, Model::LayerNode* layer)   { nodes.push_back(layer); layer->visitChildren(thisLambda); },
+                [&](auto&& thisLambda, Model::GroupNode* group)   { nodes.push_back(group); group->visitChildren(thisLambda); },
+                [&](auto&& thisLambda, Model::EntityNode* entity) { nodes.push_back(entity); entity->visitChildren(thisLambda); },
+                [&](Model::BrushNode* brush)                      { nodes.push_back(brush); },
+                [&](Model::PatchNode* patch)                      { nodes.push_back(patch); }
+            ));
+
+            const auto collectIssuesOf = [&](const std::vector<Model::Node*>& nodesToCollect) {
                 auto issues = std::vector<Model::Issue*>{};
-                const auto collectIssues = [&](auto* node) {
+                for (auto* node : nodesToCollect) {
                     for (auto* issue : node->issues(issueGenerators)) {
                         if (m_showHiddenIssues || (!issue->hidden() && (issue->type() & m_hiddenGenerators) == 0)) {
                             issues.push_back(issue);
                         }
                     }
-                };
-
-                document->world()->accept(kdl::overload(
-                    [&](auto&& thisLambda, Model::WorldNode* world)   { collectIssues(world); world->visitChildren(thisLambda); },
-                    [&](auto&& thisLambda, Model::LayerNode* layer)   { collectIssues(layer); layer->visitChildren(thisLambda); },
-                    [&](auto&& thisLambda, Model::GroupNode* group)   { collectIssues(group); group->visitChildren(thisLambda); },
-                    [&](auto&& thisLambda, Model::EntityNode* entity) { collectIssues(entity); entity->visitChildren(thisLambda); },
-                    [&](Model::BrushNode* brush)                      { collectIssues(brush); },
-                    [&](Model::PatchNode* patch)                      { collectIssues(patch); }
-                ));
-
-                issues = kdl::vec_sort(std::move(issues), [](const auto* lhs, const auto* rhs) { return lhs->seqId() > rhs->seqId(); });
-                m_tableModel->setIssues(std::move(issues));
+                }
+                return issues;
+            };
+
+            auto invalidNodes = kdl::vec_filter(nodes, [&](const auto* node) { return !node->issuesValid(issueGenerators); });
+            if (!m_resumeValidation) {
+                // Start a new pass with the issues of the nodes that are already valid. The issues of the remaining
+                // nodes are appended as they are validated, so the table is not reset while the validation goes on.
+                m_tableModel->setIssues(collectIssuesOf(kdl::vec_filter(nodes, [&](const auto* node) { return node->issuesValid(issueGenerators); })));
             }
+
+            // Validate the nodes in batches until the time budget is used up. The remaining nodes are validated when
+            // this function is called again, so that the issues found so far can be shown in the meantime.
+            const auto deadline = std::chrono::steady_clock::now() + ValidationTimeBudget;
+            auto validatedCount = size_t(0);
+            while (validatedCount < invalidNodes.size() && std::chrono::steady_clock::now() < deadline) {
+                const auto batchSize = std::min(ValidationBatchSize, invalidNodes.size() - validatedCount);
+                kdl::parallel_for(batchSize, [&](const size_t i) {
+                    invalidNodes[validatedCount + i]->validateIssues(issueGenerators);
+                });
+                validatedCount += batchSize;
+            }
+
+            const auto allValidated = validatedCount == invalidNodes.size();
+            invalidNodes.resize(validatedCount);
+            m_tableModel->appendIssues(collectIssuesOf(invalidNodes));
+
+            return allValidated;
         }
 
         void IssueBrowserView::applyQuickFix(const Model::IssueQuickFix* quickFix) {
@@ -259,6 +299,7 @@ namespace TrenchBroom {
 
         void IssueBrowserView::invalidate() {
             m_valid = false;
+            m_resumeValidation = false;
 
             QMetaObject::invokeMethod(this, "validate", Qt::QueuedConnection);
         }
@@ -267,7 +308,14 @@ namespace TrenchBroom {
             if (!m_valid) {
                 m_valid = true;
 
-                updateIssues();
+                if (!updateIssues()) {
+                    // show the issues found so far and continue with the remaining nodes later
+                    m_valid = false;
+                    m_resumeValidation = true;
+                    QMetaObject::invokeMethod(this, "validate", Qt::QueuedConnection);
+                } else {
+                    m_resumeValidation = false;
+                }
             }
         }
 
@@ -283,6 +331,18 @@ namespace TrenchBroom {
             endResetModel();
         }
 
+        void IssueBrowserModel::appendIssues(std::vector<Model::Issue*> issues) {
+            if (issues.empty()) {
+                return;
+            }
+
+            const auto first = static_cast<int>(m_issues.size());
+            const auto last = first + static_cast<int>(issues.size()) - 1;
+            beginInsertRows(QModelIndex(), first, last);
+            m_issues = kdl::vec_concat(std::move(m_issues), std::move(issues));
+            endInsertRows();
+        }
+
         const std::vector<Model::Issue*>& IssueBrowserModel::issues() {
             return m_issues;
         }
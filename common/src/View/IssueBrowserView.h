@@ -49,6 +49,7 @@ namespace TrenchBroom {
             bool m_showHiddenIssues;
 
             bool m_valid;
+            bool m_resumeValidation;
 
             QTableView* m_tableView;
             IssueBrowserModel* m_tableModel;
@@ -63,7 +64,14 @@ namespace TrenchBroom {
             void reload();
             void deselectAll();
         private:
-            void updateIssues();
+            /**
+             * Updates the list of issues. Generating the issues of a large map can take a while, so this only spends a
+             * limited amount of time on generating issues and returns false if some nodes have not been validated yet.
+             *
+             * The first call of a validation pass replaces the list with the issues of the nodes that are already
+             * valid, and every call appends the issues of the nodes it validated, in document order.
+             */
+            bool updateIssues();
 
             std::vector<Model::Issue*> collectIssues(const QList<QModelIndex>& indices) const;
             std::vector<Model::IssueQuickFix*> collectQuickFixes(const QList<QModelIndex>& indices) const;
@@ -87,8 +95,8 @@ namespace TrenchBroom {
         };
 
         /**
-         * Trivial QAbstractTableModel subclass, when the issues list changes,
-         * it just refreshes the entire list with beginResetModel()/endResetModel().
+         * Trivial QAbstractTableModel subclass. Setting the issues refreshes the entire list with
+         * beginResetModel()/endResetModel(), while appending issues only inserts the new rows.
          */
         class IssueBrowserModel : public QAbstractTableModel {
             Q_OBJECT
@@ -98,6 +106,7 @@ namespace TrenchBroom {
             explicit IssueBrowserModel(QObject* parent);
 
             void setIssues(std::vector<Model::Issue*> issues);
+            void appendIssues(std::vector<Model::Issue*> issues);
             const std::vector<Model::Issue*>& issues();
         public: // QAbstractTableModel overrides
             int rowCount(const QModelIndex& parent) const override;
@@ -521,6 +521,12 @@ namespace TrenchBroom {
             m_game->writeMap(*m_world, path);
         }
 
+        void MapDocument::saveDocumentToStream(std::ostream& stream) {
+            ensure(m_game.get() != nullptr, "game is null");
+            ensure(m_world != nullptr, "world is null");
+            m_game->writeMapToStream(*m_world, stream);
+        }
+
         void MapDocument::exportDocumentAs(const Model::ExportFormat format, const IO::Path& path) {
             m_game->exportMap(*m_world, format, path);
         }
@@ -900,7 +906,7 @@ namespace TrenchBroom {
 
         void MapDocument::selectTouching(const bool del) {
             const auto nodes = kdl::vec_filter(
-                Model::collectTouchingNodes(std::vector<Model::Node*>{m_world.get()}, m_selectedNodes.brushes()),
+                Model::collectTouchingNodes(*m_world, m_selectedNodes.brushes()),
                 [&](Model::Node* node) { return m_editorContext->selectable(node); });
 
             Transaction transaction(this, "Select Touching");
@@ -913,7 +919,7 @@ namespace TrenchBroom {
 
         void MapDocument::selectInside(const bool del) {
             const auto nodes = kdl::vec_filter(
-                Model::collectContainedNodes(std::vector<Model::Node*>{m_world.get()}, m_selectedNodes.brushes()),
+                Model::collectContainedNodes(*m_world, m_selectedNodes.brushes()),
                 [&](Model::Node* node) { return m_editorContext->selectable(node); });
 
             Transaction transaction(this, "Select Inside");
@@ -1040,7 +1046,7 @@ namespace TrenchBroom {
                 deleteObjects();
 
                 const auto nodesToSelect = kdl::vec_filter(
-                    Model::collectContainedNodes(std::vector<Model::Node*>{world()}, kdl::vec_transform(tallBrushes, [](const auto& b) { return b.get(); })), 
+                    Model::collectContainedNodes(*world(), kdl::vec_transform(tallBrushes, [](const auto& b) { return b.get(); })), 
                     [&](const auto* node) { return editorContext().selectable(node); });
                 select(nodesToSelect);
             }).handle_errors([&](const Model::BrushError& e) {
@@ -2203,7 +2209,11 @@ namespace TrenchBroom {
 
             for (auto* minuendNode : minuendNodes) {
                 const Model::Brush& minuend = minuendNode->brush();
-                auto currentSubtractionResults = minuend.subtract(m_world->mapFormat(), m_worldBounds, currentTextureName(), subtrahends);
+                // subtracting a disjoint brush has no effect, but it is expensive
+                const auto intersectingSubtrahends = kdl::vec_filter(subtrahends, [&](const auto* subtrahend) {
+                    return subtrahend->bounds().intersects(minuend.bounds());
+                });
+                auto currentSubtractionResults = minuend.subtract(m_world->mapFormat(), m_worldBounds, currentTextureName(), intersectingSubtrahends);
                 auto currentBrushes = kdl::collect_values(std::move(currentSubtractionResults), [&](const Model::BrushError& e) { 
                     error() << "Could not create brush: " << e;
                 });
@@ -2935,11 +2945,21 @@ namespace TrenchBroom {
             m_textureManager->commitChanges();
         }
 
+        bool MapDocument::hasPendingAssets() const {
+            return m_textureManager->hasPendingChanges();
+        }
+
         void MapDocument::pick(const vm::ray3& pickRay, Model::PickResult& pickResult) const {
             if (m_world != nullptr)
                 m_world->pick(pickRay, pickResult);
         }
 
+        void MapDocument::pickClosest(const vm::ray3& pickRay, Model::PickResult& pickResult, const std::function<const Model::Hit&(const Model::PickResult&)>& findHit) const {
+            if (m_world != nullptr) {
+                m_world->pickClosest(pickRay, pickResult, findHit);
+            }
+        }
+
         std::vector<Model::Node*> MapDocument::findNodesContaining(const vm::vec3& point) const {
             std::vector<Model::Node*> result;
             if (m_world != nullptr) {
@@ -3029,6 +3049,9 @@ namespace TrenchBroom {
             Notifier<>::NotifyBeforeAndAfter notifyEntityDefinitions(entityDefinitionsWillChangeNotifier, entityDefinitionsDidChangeNotifier);
 
             info("Reloading entity definitions");
+
+            // pick up definition and model files that were added, removed or renamed since they were first looked up
+            m_game->invalidateFileSystemCaches();
         }
 
         void MapDocument::loadAssets() {
@@ -3215,6 +3238,7 @@ namespace TrenchBroom {
         void MapDocument::reloadEntityDefinitionsInternal() {
             unloadEntityDefinitions();
             clearEntityModels();
+            m_game->invalidateFileSystemCaches();
             loadEntityDefinitions();
             setEntityDefinitions();
             setEntityModels();
@@ -3225,23 +3249,33 @@ namespace TrenchBroom {
             m_entityModelManager->clear();
         }
 
-        static auto makeSetEntityModelsVisitor(Logger& logger, Assets::EntityModelManager& manager) {
+        static auto makeCollectEntityNodesVisitor(std::vector<Model::EntityNode*>& entityNodes) {
             return kdl::overload(
                 [] (auto&& thisLambda, Model::WorldNode* world) { world->visitChildren(thisLambda); },
                 [] (auto&& thisLambda, Model::LayerNode* layer) { layer->visitChildren(thisLambda); },
                 [] (auto&& thisLambda, Model::GroupNode* group) { group->visitChildren(thisLambda); },
-                [&](Model::EntityNode* entityNode)                  {
-                    const auto modelSpec = Assets::safeGetModelSpecification(logger, entityNode->entity().classname(), [&]() {
-                        return entityNode->entity().modelSpecification();
-                    });
-                    const auto* frame = manager.frame(modelSpec);
-                    entityNode->setModelFrame(frame);
-                },
+                [&](Model::EntityNode* entityNode)                  { entityNodes.push_back(entityNode); },
                 [] (Model::BrushNode*) {},
                 [] (Model::PatchNode*) {}
             );
         }
 
+        static void setModelFrames(Logger& logger, Assets::EntityModelManager& manager, const std::vector<Model::EntityNode*>& entityNodes) {
+            const auto modelSpecs = kdl::vec_transform(entityNodes, [&](const Model::EntityNode* entityNode) {
+                return Assets::safeGetModelSpecification(logger, entityNode->entity().classname(), [&]() {
+                    return entityNode->entity().modelSpecification();
+                });
+            });
+
+            // load all models at once so that they can be loaded in parallel
+            manager.loadModels(modelSpecs);
+
+            for (size_t i = 0u; i < entityNodes.size(); ++i) {
+                const auto* frame = manager.frame(modelSpecs[i]);
+                entityNodes[i]->setModelFrame(frame);
+            }
+        }
+
         static auto makeUnsetEntityModelsVisitor() {
             return kdl::overload(
                 [](auto&& thisLambda, Model::WorldNode* world) { world->visitChildren(thisLambda); },
@@ -3254,11 +3288,15 @@ namespace TrenchBroom {
         }
 
         void MapDocument::setEntityModels() {
-            m_world->accept(makeSetEntityModelsVisitor(*this, *m_entityModelManager));
+            auto entityNodes = std::vector<Model::EntityNode*>{};
+            m_world->accept(makeCollectEntityNodesVisitor(entityNodes));
+            setModelFrames(*this, *m_entityModelManager, entityNodes);
         }
 
         void MapDocument::setEntityModels(const std::vector<Model::Node*>& nodes) {
-            Model::Node::visitAll(nodes, makeSetEntityModelsVisitor(*this, *m_entityModelManager));
+            auto entityNodes = std::vector<Model::EntityNode*>{};
+            Model::Node::visitAll(nodes, makeCollectEntityNodesVisitor(entityNodes));
+            setModelFrames(*this, *m_entityModelManager, entityNodes);
         }
 
         void MapDocument::unsetEntityModels() {
@@ -32,6 +32,8 @@
 #include <vecmath/bbox.h>
 #include <vecmath/util.h>
 
+#include <functional>
+#include <iosfwd>
 #include <map>
 #include <memory>
 #include <optional>
@@ -60,6 +62,7 @@ namespace TrenchBroom {
         class Entity;
         enum class ExportFormat;
         class Game;
+        class Hit;
         class Issue;
         enum class MapFormat;
         class PickResult;
@@ -261,6 +264,7 @@ namespace TrenchBroom {
             void saveDocument();
             void saveDocumentAs(const IO::Path& path);
             void saveDocumentTo(const IO::Path& path);
+            void saveDocumentToStream(std::ostream& stream);
             void exportDocumentAs(Model::ExportFormat format, const IO::Path& path);
         private:
             void doSaveDocument(const IO::Path& path);
@@ -508,8 +512,10 @@ namespace TrenchBroom {
             virtual std::unique_ptr<CommandResult> doExecuteAndStore(std::unique_ptr<UndoableCommand>&& command) = 0;
         public: // asset state management
             void commitPendingAssets();
+            bool hasPendingAssets() const;
         public: // picking
             void pick(const vm::ray3& pickRay, Model::PickResult& pickResult) const;
+            void pickClosest(const vm::ray3& pickRay, Model::PickResult& pickResult, const std::function<const Model::Hit&(const Model::PickResult&)>& findHit) const;
             std::vector<Model::Node*> findNodesContaining(const vm::vec3& point) const;
         private: // world management
             void createWorld(Model::MapFormat mapFormat, const vm::bbox3& worldBounds, std::shared_ptr<Model::Game> game);
@@ -54,6 +54,7 @@
 #include <vecmath/segment.h>
 #include <vecmath/polygon.h>
 
+#include <chrono>
 #include <map>
 #include <memory>
 #include <string>
@@ -66,8 +67,11 @@ namespace TrenchBroom {
             return std::shared_ptr<MapDocument>(new MapDocumentCommandFacade());
         }
 
+        // The oldest undo steps are dropped when the undo history is estimated to use more memory than this.
+        static constexpr auto UndoMemoryBudget = size_t(1024u * 1024u * 1024u);
+
         MapDocumentCommandFacade::MapDocumentCommandFacade() :
-        m_commandProcessor(std::make_unique<CommandProcessor>(this)) {
+        m_commandProcessor(std::make_unique<CommandProcessor>(this, std::chrono::milliseconds(1000), UndoMemoryBudget)) {
             bindObservers();
         }
 
@@ -186,7 +186,9 @@ namespace TrenchBroom {
 
             // let's trigger a final autosave before releasing the document
             NullLogger logger;
+            m_autosaver->waitForPendingBackup(logger);
             m_autosaver->triggerAutosave(logger);
+            m_autosaver->waitForPendingBackup(logger);
 
             m_document->setViewEffectsService(nullptr);
             m_document.reset();
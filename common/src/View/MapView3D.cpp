@@ -215,11 +215,15 @@ namespace TrenchBroom {
             if (QRect(0, 0, width(), height()).contains(clientCoords)) {
                 const auto pickRay = vm::ray3(m_camera->pickRay(static_cast<float>(clientCoords.x()), static_cast<float>(clientCoords.y())));
 
+                const auto findHit = [](const Model::PickResult& pickResult) -> const Model::Hit& {
+                    return pickResult.query().pickable().type(Model::BrushNode::BrushHitType).occluded().first();
+                };
+
                 const auto& editorContext = document->editorContext();
                 auto pickResult = Model::PickResult::byDistance(editorContext);
 
-                document->pick(pickRay, pickResult);
-                const auto& hit = pickResult.query().pickable().type(Model::BrushNode::BrushHitType).occluded().first();
+                document->pickClosest(pickRay, pickResult, findHit);
+                const auto& hit = findHit(pickResult);
                 if (const auto faceHandle = Model::hitToFaceHandle(hit)) {
                     const auto& face = faceHandle->face();
                     return grid.moveDeltaForBounds(face.boundary(), bounds, document->worldBounds(), pickRay);
@@ -876,6 +876,11 @@ namespace TrenchBroom {
             renderFPS(renderContext, renderBatch);
 
             renderBatch.render(renderContext);
+
+            if (document->hasPendingAssets()) {
+                // render another frame to upload the remaining textures
+                update();
+            }
         }
 
         void MapViewBase::setupGL(Renderer::RenderContext& context) {
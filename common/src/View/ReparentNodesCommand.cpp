@@ -36,7 +36,8 @@ namespace TrenchBroom {
         UndoableCommand(Type, "Reparent Objects", true),
         m_nodesToAdd(std::move(nodesToAdd)),
         m_nodesToRemove(std::move(nodesToRemove)),
-        m_updateLinkedGroupsHelper(std::move(linkedGroupsToUpdate)) {}
+        m_updateLinkedGroupsHelper(std::move(linkedGroupsToUpdate)),
+        m_memorySize(0u) {}
 
         std::unique_ptr<CommandResult> ReparentNodesCommand::doPerformDo(MapDocumentCommandFacade* document) {
             doAction(document);
@@ -47,12 +48,15 @@ namespace TrenchBroom {
                     undoAction(document);
                 });
 
+            m_memorySize = m_updateLinkedGroupsHelper.memorySize();
             return std::make_unique<CommandResult>(success);
         }
 
         std::unique_ptr<CommandResult> ReparentNodesCommand::doPerformUndo(MapDocumentCommandFacade* document) {
             undoAction(document);
             m_updateLinkedGroupsHelper.undoLinkedGroupUpdates(*document);
+
+            m_memorySize = m_updateLinkedGroupsHelper.memorySize();
             return std::make_unique<CommandResult>(true);
         }
 
@@ -69,5 +73,9 @@ namespace TrenchBroom {
         bool ReparentNodesCommand::doCollateWith(UndoableCommand*) {
             return false;
         }
+
+        size_t ReparentNodesCommand::doGetMemorySize() const {
+            return m_memorySize;
+        }
     }
 }
@@ -41,6 +41,7 @@ namespace TrenchBroom {
             std::map<Model::Node*, std::vector<Model::Node*>> m_nodesToAdd;
             std::map<Model::Node*, std::vector<Model::Node*>> m_nodesToRemove;
             UpdateLinkedGroupsHelper m_updateLinkedGroupsHelper;
+            size_t m_memorySize;
         public:
             static std::unique_ptr<ReparentNodesCommand> reparent(std::map<Model::Node*, std::vector<Model::Node*>> nodesToAdd, std::map<Model::Node*, std::vector<Model::Node*>> nodesToRemove, std::vector<std::pair<const Model::GroupNode*, std::vector<Model::GroupNode*>>> linkedGroupsToUpdate);
 
@@ -54,6 +55,12 @@ namespace TrenchBroom {
 
             bool doCollateWith(UndoableCommand* command) override;
 
+            /**
+             * The reparented nodes remain part of the document, so only the nodes replaced by linked group updates
+             * are counted.
+             */
+            size_t doGetMemorySize() const override;
+
             deleteCopyAndMove(ReparentNodesCommand)
         };
     }
@@ -19,15 +19,20 @@
 
 #include "SwapNodeContentsCommand.h"
 
+#include "Ensure.h"
 #include "Model/Brush.h"
 #include "Model/Entity.h"
+#include "Model/ModelUtils.h"
 #include "Model/Node.h"
 #include "Model/UpdateLinkedGroupsError.h"
 #include "View/MapDocumentCommandFacade.h"
 
+#include <kdl/parallel.h>
 #include <kdl/result.h>
 #include <kdl/vector_utils.h>
 
+#include <variant>
+
 namespace TrenchBroom {
     namespace View {
         const Command::CommandType SwapNodeContentsCommand::Type = Command::freeType();
@@ -35,11 +40,13 @@ namespace TrenchBroom {
         SwapNodeContentsCommand::SwapNodeContentsCommand(const std::string& name, std::vector<std::pair<Model::Node*, Model::NodeContents>> nodes, std::vector<std::pair<const Model::GroupNode*, std::vector<Model::GroupNode*>>> linkedGroupsToUpdate) :
         UndoableCommand(Type, name, true),
         m_nodes(std::move(nodes)),
-        m_updateLinkedGroupsHelper(std::move(linkedGroupsToUpdate)) {}
+        m_updateLinkedGroupsHelper(std::move(linkedGroupsToUpdate)),
+        m_memorySize(0u) {}
 
         SwapNodeContentsCommand::~SwapNodeContentsCommand() = default;
 
         std::unique_ptr<CommandResult> SwapNodeContentsCommand::doPerformDo(MapDocumentCommandFacade* document) {
+            restoreBrushGeometries(document->worldBounds());
             document->performSwapNodeContents(m_nodes);
 
             const auto success = m_updateLinkedGroupsHelper.applyLinkedGroupUpdates(*document)
@@ -48,12 +55,16 @@ namespace TrenchBroom {
                     document->performSwapNodeContents(m_nodes);
                 });
 
+            updateMemorySize();
             return std::make_unique<CommandResult>(success);
         }
 
         std::unique_ptr<CommandResult> SwapNodeContentsCommand::doPerformUndo(MapDocumentCommandFacade* document) {
+            restoreBrushGeometries(document->worldBounds());
             document->performSwapNodeContents(m_nodes);
             m_updateLinkedGroupsHelper.undoLinkedGroupUpdates(*document);
+
+            updateMemorySize();
             return std::make_unique<CommandResult>(true);
         }
 
@@ -68,10 +79,48 @@ namespace TrenchBroom {
             
             if (myNodes == theirNodes) {
                 m_updateLinkedGroupsHelper.collateWith(other->m_updateLinkedGroupsHelper);
+                updateMemorySize();
                 return true;
             }
 
             return false;
         }
+
+        size_t SwapNodeContentsCommand::doGetMemorySize() const {
+            return m_memorySize;
+        }
+
+        void SwapNodeContentsCommand::doCompact(MapDocumentCommandFacade* /* document */) {
+            discardBrushGeometries();
+            updateMemorySize();
+        }
+
+        void SwapNodeContentsCommand::discardBrushGeometries() {
+            kdl::parallel_for(m_nodes.size(), [&](const size_t i) {
+                auto* brush = std::get_if<Model::Brush>(&m_nodes[i].second.get());
+                if (brush != nullptr && brush->hasGeometry()) {
+                    brush->discardGeometry();
+                }
+            });
+        }
+
+        void SwapNodeContentsCommand::restoreBrushGeometries(const vm::bbox3& worldBounds) {
+            kdl::parallel_for(m_nodes.size(), [&](const size_t i) {
+                auto* brush = std::get_if<Model::Brush>(&m_nodes[i].second.get());
+                if (brush != nullptr && !brush->hasGeometry()) {
+                    // cannot fail because the geometry is only discarded if it can be restored
+                    const auto success = brush->restoreGeometry(worldBounds).is_success();
+                    ensure(success, "brush geometry was restored");
+                }
+            });
+        }
+
+        void SwapNodeContentsCommand::updateMemorySize() {
+            m_memorySize = 0u;
+            for (const auto& [node, contents] : m_nodes) {
+                m_memorySize += Model::estimateMemorySize(contents);
+            }
+            m_memorySize += m_updateLinkedGroupsHelper.memorySize();
+        }
     }
 }
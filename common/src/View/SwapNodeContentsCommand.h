@@ -24,6 +24,8 @@
 #include "View/UndoableCommand.h"
 #include "View/UpdateLinkedGroupsHelper.h"
 
+#include <vecmath/forward.h>
+
 #include <memory>
 #include <string>
 #include <tuple>
@@ -44,6 +46,8 @@ namespace TrenchBroom {
         protected:
             std::vector<std::pair<Model::Node*, Model::NodeContents>> m_nodes;
             UpdateLinkedGroupsHelper m_updateLinkedGroupsHelper;
+        private:
+            size_t m_memorySize;
         public:
             SwapNodeContentsCommand(const std::string& name, std::vector<std::pair<Model::Node*, Model::NodeContents>> nodes, std::vector<std::pair<const Model::GroupNode*, std::vector<Model::GroupNode*>>> linkedGroupsToUpdate);
             ~SwapNodeContentsCommand();
@@ -52,6 +56,20 @@ namespace TrenchBroom {
             std::unique_ptr<CommandResult> doPerformUndo(MapDocumentCommandFacade* document) override;
 
             bool doCollateWith(UndoableCommand* command) override;
+        private:
+            size_t doGetMemorySize() const override;
+
+            /**
+             * The contents stored in this command are not part of the document, so once this command is no longer the
+             * most recent command, the geometry of the brushes among them is discarded. It is restored before swapping
+             * again. This significantly reduces the memory used by the undo history without rebuilding the brushes
+             * when a command is collated with others, e.g. while dragging.
+             */
+            void doCompact(MapDocumentCommandFacade* document) override;
+
+            void discardBrushGeometries();
+            void restoreBrushGeometries(const vm::bbox3& worldBounds);
+            void updateMemorySize();
 
             deleteCopyAndMove(SwapNodeContentsCommand)
         };
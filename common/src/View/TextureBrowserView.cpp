@@ -301,6 +301,11 @@ namespace TrenchBroom {
             renderBounds(layout, y, height);
             renderTextures(layout, y, height);
             renderNames(layout, y, height);
+
+            if (doc->textureManager().hasPendingChanges()) {
+                // render another frame to upload the remaining textures
+                update();
+            }
         }
 
         bool TextureBrowserView::doShouldRenderFocusIndicator() const {
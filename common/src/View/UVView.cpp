@@ -181,6 +181,11 @@ namespace TrenchBroom {
                 renderTextureAxes(renderContext, renderBatch);
 
                 renderBatch.render(renderContext);
+
+                if (document->hasPendingAssets()) {
+                    // render another frame to upload the remaining textures
+                    update();
+                }
             }
         }
 
@@ -64,5 +64,19 @@ namespace TrenchBroom {
             }
             return false;
         }
+
+        size_t UndoableCommand::memorySize() const {
+            return doGetMemorySize();
+        }
+
+        void UndoableCommand::compact(MapDocumentCommandFacade* document) {
+            doCompact(document);
+        }
+
+        size_t UndoableCommand::doGetMemorySize() const {
+            return 0u;
+        }
+
+        void UndoableCommand::doCompact(MapDocumentCommandFacade*) {}
     }
 }
@@ -41,11 +41,27 @@ namespace TrenchBroom {
             virtual std::unique_ptr<CommandResult> performUndo(MapDocumentCommandFacade* document);
 
             virtual bool collateWith(UndoableCommand* command);
+
+            /**
+             * Returns an estimate of the memory used by the state this command keeps for undoing or redoing itself,
+             * in bytes.
+             */
+            size_t memorySize() const;
+
+            /**
+             * Reduces the memory used by the state this command keeps for undoing or redoing itself, at the cost of
+             * making the next undo or redo more expensive. This is called once the command is no longer the most
+             * recent command on the undo or redo stack.
+             */
+            void compact(MapDocumentCommandFacade* document);
         private:
             virtual std::unique_ptr<CommandResult> doPerformUndo(MapDocumentCommandFacade* document) = 0;
 
             virtual bool doCollateWith(UndoableCommand* command) = 0;
 
+            virtual size_t doGetMemorySize() const;
+            virtual void doCompact(MapDocumentCommandFacade* document);
+
             deleteCopyAndMove(UndoableCommand)
         };
     }
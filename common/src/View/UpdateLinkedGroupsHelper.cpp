@@ -128,6 +128,21 @@ namespace TrenchBroom {
             });
         }
 
+        size_t UpdateLinkedGroupsHelper::memorySize() const {
+            return std::visit(kdl::overload(
+                [] (const LinkedGroupsToUpdate&) {
+                    return size_t(0);
+                },
+                [] (const LinkedGroupUpdates& linkedGroupUpdates) {
+                    auto result = size_t(0);
+                    for (const auto& [groupNode, children] : linkedGroupUpdates) {
+                        result += Model::estimateMemorySize(kdl::vec_transform(children, [](const auto& child) { return child.get(); }));
+                    }
+                    return result;
+                }
+            ), m_state);
+        }
+
         void UpdateLinkedGroupsHelper::doApplyOrUndoLinkedGroupUpdates(MapDocumentCommandFacade& document) {
             std::visit(kdl::overload(
                 [] (const LinkedGroupsToUpdate&) {},
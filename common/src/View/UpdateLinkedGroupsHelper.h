@@ -67,6 +67,12 @@ namespace TrenchBroom {
             kdl::result<void, Model::UpdateLinkedGroupsError> applyLinkedGroupUpdates(MapDocumentCommandFacade& document);
             void undoLinkedGroupUpdates(MapDocumentCommandFacade& document);
             void collateWith(UpdateLinkedGroupsHelper& other);
+
+            /**
+             * Returns an estimate of the memory used by the nodes that this helper keeps for undoing or redoing the
+             * linked group updates, in bytes.
+             */
+            size_t memorySize() const;
         private:
             kdl::result<void, Model::UpdateLinkedGroupsError> computeLinkedGroupUpdates(MapDocumentCommandFacade& document);
             static kdl::result<LinkedGroupUpdates, Model::UpdateLinkedGroupsError> computeLinkedGroupUpdates(const LinkedGroupsToUpdate& linkedGroupsToUpdate, const vm::bbox3& worldBounds);
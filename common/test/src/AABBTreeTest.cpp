@@ -21,7 +21,10 @@
 
 #include <vecmath/vec.h>
 #include <vecmath/ray.h>
+#include <vecmath/plane.h>
 
+#include <algorithm>
+#include <random>
 #include <set>
 #include <sstream>
 
@@ -32,6 +35,7 @@ namespace TrenchBroom {
     using BOX = AABB::Box;
     using RAY = vm::ray<AABB::FloatType, AABB::Components>;
     using VEC = vm::vec<AABB::FloatType, AABB::Components>;
+    using PLANE = vm::plane<AABB::FloatType, AABB::Components>;
 
 
     static void assertTree(const std::string& exp, const AABB& actual) {
@@ -49,6 +53,24 @@ namespace TrenchBroom {
         CHECK(actual == expected);
     }
 
+    static void assertIntersectorsOfVolume(const AABB& tree, const std::vector<PLANE>& planes, std::initializer_list<AABB::DataType> items) {
+        const std::set<AABB::DataType> expected(items);
+        std::set<AABB::DataType> actual;
+
+        tree.findIntersectorsOfVolume(planes, std::inserter(actual, std::end(actual)));
+
+        CHECK(actual == expected);
+    }
+
+    static void assertIntersectorsOfBox(const AABB& tree, const BOX& box, std::initializer_list<AABB::DataType> items) {
+        const std::set<AABB::DataType> expected(items);
+        std::set<AABB::DataType> actual;
+
+        tree.findIntersectors(box, std::inserter(actual, std::end(actual)));
+
+        CHECK(actual == expected);
+    }
+
     static void assertTreeContains(const AABB& tree, const BOX& box, AABB::DataType data) {
         CHECK(tree.contains(data));
 
@@ -529,6 +551,95 @@ L [ ( -1 -1 -1 ) ( 1 1 1 ) ]: 1
         assertIntersectors(tree, RAY(VEC(0.0,  0.0,  0.0), VEC::pos_x()), { 2u });
     }
 
+    TEST_CASE("AABBTreeTest.findIntersectorsOfVolume", "[AABBTreeTest]") {
+        AABB tree;
+        assertIntersectorsOfVolume(tree, { PLANE(VEC::zero(), VEC::pos_x()) }, {});
+
+        tree.insert(BOX(VEC(-4.0, -1.0, -1.0), VEC(-2.0, +1.0, +1.0)), 1u);
+        tree.insert(BOX(VEC(+2.0, -1.0, -1.0), VEC(+4.0, +1.0, +1.0)), 2u);
+        tree.insert(BOX(VEC(-1.0, -1.0, +2.0), VEC(+1.0, +1.0, +4.0)), 3u);
+
+        // no planes, everything is inside
+        assertIntersectorsOfVolume(tree, {}, { 1u, 2u, 3u });
+
+        // half spaces
+        assertIntersectorsOfVolume(tree, { PLANE(VEC::zero(), VEC::pos_x()) }, { 1u, 3u });
+        assertIntersectorsOfVolume(tree, { PLANE(VEC::zero(), VEC::neg_x()) }, { 2u, 3u });
+        assertIntersectorsOfVolume(tree, { PLANE(VEC(-3.0, 0.0, 0.0), VEC::pos_x()) }, { 1u });
+        assertIntersectorsOfVolume(tree, { PLANE(VEC(0.0, 0.0, 2.0), VEC::neg_z()) }, { 3u });
+        assertIntersectorsOfVolume(tree, { PLANE(VEC(0.0, 0.0, 5.0), VEC::neg_z()) }, {});
+
+        // a slab between two parallel planes, like the frustum of an orthographic camera
+        assertIntersectorsOfVolume(tree, {
+            PLANE(VEC(+1.5, 0.0, 0.0), VEC::pos_x()),
+            PLANE(VEC(-1.5, 0.0, 0.0), VEC::neg_x()),
+        }, { 3u });
+
+        // a pyramid looking along the positive X axis from the origin, like the frustum of a perspective camera
+        const auto n1 = normalize(VEC(-1.0, 0.0, +1.0));
+        const auto n2 = normalize(VEC(-1.0, 0.0, -1.0));
+        const auto n3 = normalize(VEC(-1.0, +1.0, 0.0));
+        const auto n4 = normalize(VEC(-1.0, -1.0, 0.0));
+        assertIntersectorsOfVolume(tree, {
+            PLANE(VEC::zero(), n1),
+            PLANE(VEC::zero(), n2),
+            PLANE(VEC::zero(), n3),
+            PLANE(VEC::zero(), n4),
+        }, { 2u });
+    }
+
+    TEST_CASE("AABBTreeTest.findIntersectorsOfVolumeGrid", "[AABBTreeTest]") {
+        std::vector<BOX> bounds;
+        std::vector<size_t> items;
+        for (size_t x = 0; x < 10u; ++x) {
+            for (size_t y = 0; y < 10u; ++y) {
+                const auto min = VEC(static_cast<double>(x), static_cast<double>(y), 0.0) * 2.0;
+                bounds.push_back(BOX(min, min + VEC(1.0, 1.0, 1.0)));
+                items.push_back(10u * x + y);
+            }
+        }
+
+        AABB tree;
+        tree.clearAndBuild(items, [&](const size_t i) { return bounds[i]; });
+
+        // the boxes with x in [4, 7] and y in [2, 3]
+        const auto planes = std::vector<PLANE>{
+            PLANE(VEC(15.0, 0.0, 0.0), VEC::pos_x()),
+            PLANE(VEC(7.5, 0.0, 0.0), VEC::neg_x()),
+            PLANE(VEC(0.0, 7.5, 0.0), VEC::pos_y()),
+            PLANE(VEC(0.0, 3.5, 0.0), VEC::neg_y()),
+        };
+        assertIntersectorsOfVolume(tree, planes, { 42u, 43u, 52u, 53u, 62u, 63u, 72u, 73u });
+    }
+
+    TEST_CASE("AABBTreeTest.findIntersectorsOfBox", "[AABBTreeTest]") {
+        AABB tree;
+        assertIntersectorsOfBox(tree, BOX(VEC(-1.0, -1.0, -1.0), VEC(1.0, 1.0, 1.0)), {});
+
+        tree.insert(BOX(VEC(-4.0, -1.0, -1.0), VEC(-2.0, +1.0, +1.0)), 1u);
+        tree.insert(BOX(VEC(+2.0, -1.0, -1.0), VEC(+4.0, +1.0, +1.0)), 2u);
+        tree.insert(BOX(VEC(-1.0, -1.0, +2.0), VEC(+1.0, +1.0, +4.0)), 3u);
+
+        // between the boxes
+        assertIntersectorsOfBox(tree, BOX(VEC(-1.0, -1.0, -1.0), VEC(1.0, 1.0, 1.0)), {});
+
+        // overlapping
+        assertIntersectorsOfBox(tree, BOX(VEC(-3.0, -1.0, -1.0), VEC(-1.0, 1.0, 1.0)), { 1u });
+        assertIntersectorsOfBox(tree, BOX(VEC(0.0, 0.0, 0.0), VEC(3.0, 3.0, 3.0)), { 2u, 3u });
+        assertIntersectorsOfBox(tree, BOX(VEC(-5.0, -5.0, -5.0), VEC(5.0, 5.0, 5.0)), { 1u, 2u, 3u });
+
+        // contained in a box
+        assertIntersectorsOfBox(tree, BOX(VEC(2.5, -0.5, -0.5), VEC(3.5, 0.5, 0.5)), { 2u });
+
+        // touching
+        assertIntersectorsOfBox(tree, BOX(VEC(-2.0, -1.0, -1.0), VEC(2.0, 1.0, 1.0)), { 1u, 2u });
+        assertIntersectorsOfBox(tree, BOX(VEC(-1.0, -1.0, 1.0), VEC(1.0, 1.0, 2.0)), { 3u });
+
+        CHECK_THAT(tree.findIntersectors(BOX(VEC(-3.0, -1.0, -1.0), VEC(3.0, 1.0, 1.0))), Catch::UnorderedEquals(std::vector<size_t>{
+            1u, 2u
+        }));
+    }
+
     TEST_CASE("AABBTreeTest.clear", "[AABBTreeTest]") {
         const BOX bounds1(VEC(0.0, 0.0, 0.0), VEC(2.0, 1.0, 1.0));
         const BOX bounds2(VEC(-1.0, -1.0, -1.0), VEC(1.0, 1.0, 1.0));
@@ -550,4 +661,132 @@ L [ ( -1 -1 -1 ) ( 1 1 1 ) ]: 1
         CHECK_FALSE(tree.contains(2u));
         REQUIRE_THAT(tree.findContainers(vm::vec3d{0.5, 0.5, 0.5}), Catch::UnorderedEquals(std::vector<size_t>{}));
     }
+
+    TEST_CASE("AABBTreeTest.clearAndBuild", "[AABBTreeTest]") {
+        const BOX bounds1(VEC(0.0, 0.0, 0.0), VEC(2.0, 1.0, 1.0));
+        const BOX bounds2(VEC(-1.0, -1.0, -1.0), VEC(1.0, 1.0, 1.0));
+        const BOX bounds3(VEC(-2.0, -2.0, -1.0), VEC(0.0, 0.0, 1.0));
+        const std::vector<BOX> bounds{ bounds1, bounds2, bounds3 };
+
+        AABB tree;
+        tree.insert(BOX(VEC(8.0, 8.0, 8.0), VEC(9.0, 9.0, 9.0)), 4u);
+
+        tree.clearAndBuild(std::vector<size_t>{ 0u, 1u, 2u }, [&](const size_t i) { return bounds[i]; });
+
+        CHECK_FALSE(tree.empty());
+        CHECK_FALSE(tree.contains(4u));
+        CHECK(tree.bounds() == merge(merge(bounds1, bounds2), bounds3));
+        CHECK(tree.height() == 3u);
+        assertTreeContains(tree, bounds1, 0u);
+        assertTreeContains(tree, bounds2, 1u);
+        assertTreeContains(tree, bounds3, 2u);
+
+        tree.clearAndBuild(std::vector<size_t>{}, [&](const size_t i) { return bounds[i]; });
+        CHECK(tree.empty());
+    }
+
+    TEST_CASE("AABBTreeTest.clearAndBuildWithDuplicates", "[AABBTreeTest]") {
+        const BOX bounds(VEC(0.0, 0.0, 0.0), VEC(2.0, 1.0, 1.0));
+
+        AABB tree;
+        CHECK_THROWS_AS(tree.clearAndBuild(std::vector<size_t>{ 1u, 2u, 1u }, [&](const size_t) { return bounds; }), NodeTreeException);
+        CHECK(tree.empty());
+        CHECK_FALSE(tree.contains(1u));
+    }
+
+    TEST_CASE("AABBTreeTest.clearAndBuildWithIdenticalBounds", "[AABBTreeTest]") {
+        const BOX bounds(VEC(0.0, 0.0, 0.0), VEC(2.0, 1.0, 1.0));
+
+        std::vector<size_t> data;
+        for (size_t i = 0; i < 100u; ++i) {
+            data.push_back(i);
+        }
+
+        AABB tree;
+        tree.clearAndBuild(data, [&](const size_t) { return bounds; });
+
+        CHECK(tree.height() == 8u);
+        REQUIRE_THAT(tree.findContainers(bounds.center()), Catch::UnorderedEquals(data));
+    }
+
+    TEST_CASE("AABBTreeTest.clearAndBuildWithCoincidentCentersIsOrderIndependent", "[AABBTreeTest]") {
+        // nested boxes around the same center, some of them with identical bounds
+        std::vector<BOX> bounds;
+        std::vector<size_t> data;
+        for (size_t i = 0; i < 64u; ++i) {
+            const auto size = static_cast<double>(i % 8u + 1u);
+            data.push_back(bounds.size());
+            bounds.emplace_back(VEC(-size, -size, -size), VEC(size, size, size));
+        }
+
+        const auto getBounds = [&](const size_t i) { return bounds[i]; };
+        const auto printTree = [](const AABB& t) {
+            std::stringstream str;
+            t.print(str);
+            return str.str();
+        };
+
+        AABB tree;
+        tree.clearAndBuild(data, getBounds);
+
+        std::vector<size_t> reversedData(data.rbegin(), data.rend());
+        AABB reversedTree;
+        reversedTree.clearAndBuild(reversedData, getBounds);
+        CHECK(printTree(reversedTree) == printTree(tree));
+
+        std::vector<size_t> shuffledData = data;
+        std::shuffle(std::begin(shuffledData), std::end(shuffledData), std::mt19937(0u));
+        AABB shuffledTree;
+        shuffledTree.clearAndBuild(shuffledData, getBounds);
+        CHECK(printTree(shuffledTree) == printTree(tree));
+    }
+
+    TEST_CASE("AABBTreeTest.clearAndBuildGrid", "[AABBTreeTest]") {
+        // build a 3D grid of unit cubes large enough to be built in parallel
+        constexpr size_t GridSize = 20;
+
+        std::vector<BOX> bounds;
+        std::vector<size_t> data;
+        for (size_t x = 0; x < GridSize; ++x) {
+            for (size_t y = 0; y < GridSize; ++y) {
+                for (size_t z = 0; z < GridSize; ++z) {
+                    const auto min = VEC(static_cast<double>(x), static_cast<double>(y), static_cast<double>(z)) * 2.0;
+                    data.push_back(bounds.size());
+                    bounds.emplace_back(min, min + VEC(1.0, 1.0, 1.0));
+                }
+            }
+        }
+
+        const auto getBounds = [&](const size_t i) { return bounds[i]; };
+
+        AABB tree;
+        tree.clearAndBuild(data, getBounds);
+
+        // the result must not depend on the order of the input
+        std::vector<size_t> reversedData(data.rbegin(), data.rend());
+        std::vector<size_t> shuffledData = data;
+        std::shuffle(std::begin(shuffledData), std::end(shuffledData), std::mt19937(0u));
+
+        const auto printTree = [](const AABB& t) {
+            std::stringstream str;
+            t.print(str);
+            return str.str();
+        };
+
+        AABB reversedTree;
+        reversedTree.clearAndBuild(reversedData, getBounds);
+        CHECK(printTree(reversedTree) == printTree(tree));
+
+        AABB shuffledTree;
+        shuffledTree.clearAndBuild(shuffledData, getBounds);
+        CHECK(printTree(shuffledTree) == printTree(tree));
+
+        CHECK(tree.height() <= 16u);
+        for (const size_t i : data) {
+            CHECK(tree.contains(i));
+            CHECK(tree.findContainers(bounds[i].center()) == std::vector<size_t>{ i });
+        }
+
+        assertIntersectors(tree, RAY(VEC(-1.0, 0.5, 0.5), VEC::pos_x()), { 0u, 400u, 800u, 1200u, 1600u, 2000u, 2400u, 2800u, 3200u, 3600u, 4000u, 4400u, 4800u, 5200u, 5600u, 6000u, 6400u, 6800u, 7200u, 7600u });
+    }
 }
@@ -0,0 +1,76 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/ModelDefinition.h"
+#include "EL/Expression.h"
+#include "EL/Value.h"
+#include "EL/VariableStore.h"
+#include "IO/ELParser.h"
+#include "IO/Path.h"
+
+#include <string>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace Assets {
+        TEST_CASE("ModelDefinitionTest.modelSpecification", "[ModelDefinitionTest]") {
+            const auto expression = IO::ELParser::parseStrict(R"({{ spawnflags == 1 -> { 'path': 'maps/b_shell1.bsp', 'skin': skin }, { 'path': 'maps/b_shell0.bsp', 'skin': skin } }})");
+            const auto modelDefinition = ModelDefinition(expression);
+
+            const auto variables = [](const int spawnflags, const int skin, const std::string& message) {
+                return EL::VariableTable({
+                    {"spawnflags", EL::Value(spawnflags)},
+                    {"skin", EL::Value(skin)},
+                    {"message", EL::Value(message)}
+                });
+            };
+
+            // a new definition has its own cache, so it evaluates the expression
+            const auto evaluate = [&](const EL::VariableStore& variableStore) {
+                return ModelDefinition(expression).modelSpecification(variableStore);
+            };
+
+            const auto shell0Skin0 = variables(0, 0, "a");
+            const auto shell0Skin1 = variables(0, 1, "a");
+            const auto shell1Skin0 = variables(1, 0, "a");
+            const auto shell1Skin0OtherMessage = variables(1, 0, "b");
+
+            CHECK(modelDefinition.modelSpecification(shell0Skin0) == ModelSpecification(IO::Path("maps/b_shell0.bsp"), 0u, 0u));
+            CHECK(modelDefinition.modelSpecification(shell0Skin1) == ModelSpecification(IO::Path("maps/b_shell0.bsp"), 1u, 0u));
+            CHECK(modelDefinition.modelSpecification(shell1Skin0) == ModelSpecification(IO::Path("maps/b_shell1.bsp"), 0u, 0u));
+
+            // repeated and unreferenced values return the cached result, which matches direct evaluation
+            for (const auto* variableStore : {&shell0Skin0, &shell0Skin1, &shell1Skin0, &shell1Skin0OtherMessage}) {
+                CHECK(modelDefinition.modelSpecification(*variableStore) == evaluate(*variableStore));
+                CHECK(modelDefinition.modelSpecification(*variableStore) == evaluate(*variableStore));
+            }
+
+            // changing a referenced value changes the result
+            CHECK(modelDefinition.modelSpecification(shell0Skin0) != modelDefinition.modelSpecification(shell0Skin1));
+            CHECK(modelDefinition.modelSpecification(shell0Skin0) != modelDefinition.modelSpecification(shell1Skin0));
+            CHECK(modelDefinition.modelSpecification(shell1Skin0) == modelDefinition.modelSpecification(shell1Skin0OtherMessage));
+
+            // copies share the cache
+            const auto copy = modelDefinition;
+            CHECK(copy.modelSpecification(shell0Skin1) == ModelSpecification(IO::Path("maps/b_shell0.bsp"), 1u, 0u));
+            CHECK(copy.modelSpecification(shell1Skin0) == ModelSpecification(IO::Path("maps/b_shell1.bsp"), 0u, 0u));
+        }
+    }
+}
@@ -27,6 +27,7 @@
 #include "IO/ELParser.h"
 
 #include <string>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -341,5 +342,24 @@ namespace TrenchBroom {
             evaluateAndAssert("true && true -> false", false);
             evaluateAndAssert("2 + 3 < 2 + 4 -> 6 % 5", 1);
         }
+
+        TEST_CASE("ExpressionTest.testSwitchExpression", "[ExpressionTest]") {
+            assertOptimizable("{{ false -> 1, 2 }}");
+            assertOptimizable("{{ false -> x }}");
+            assertNotOptimizable("{{ x -> 1, 2 }}");
+
+            auto expression = IO::ELParser::parseStrict("{{ false -> 1, x -> 2, 3, y -> 4 }}");
+            CHECK_FALSE(expression.optimize());
+            CHECK(expression.variableNames() == std::vector<std::string>{"x"});
+            evaluateAndAssert("{{ false -> 1, x -> 2, 3, y -> 4 }}", 2, "x", true);
+            evaluateAndAssert("{{ false -> 1, x -> 2, 3, y -> 4 }}", 3, "x", false);
+        }
+
+        TEST_CASE("ExpressionTest.testVariableNames", "[ExpressionTest]") {
+            CHECK(IO::ELParser::parseStrict("1 + 2").variableNames().empty());
+            CHECK(IO::ELParser::parseStrict("{ 'path': x, 'skin': y + x }").variableNames() == std::vector<std::string>{"x", "y"});
+            CHECK(IO::ELParser::parseStrict("{{ z -> [a, b], c }}").variableNames() == std::vector<std::string>{"a", "b", "c", "z"});
+            CHECK(IO::ELParser::parseStrict("x[1..]").variableNames() == std::vector<std::string>{"x"});
+        }
     }
 }
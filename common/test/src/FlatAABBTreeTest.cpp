@@ -0,0 +1,121 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AABBTree.h"
+#include "FlatAABBTree.h"
+
+#include <vecmath/vec.h>
+#include <vecmath/ray.h>
+
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    using AABB = AABBTree<double, 3, size_t>;
+    using FLAT = FlatAABBTree<double, 3, size_t>;
+    using BOX = AABB::Box;
+    using RAY = vm::ray<AABB::FloatType, AABB::Components>;
+    using VEC = vm::vec<AABB::FloatType, AABB::Components>;
+
+    TEST_CASE("FlatAABBTreeTest.createEmptyTree", "[FlatAABBTreeTest]") {
+        const AABB tree;
+        const FLAT flatTree(tree);
+
+        CHECK(flatTree.empty());
+        CHECK(flatTree.nodeCount() == 0u);
+        CHECK(flatTree.findIntersectors(RAY(VEC::zero(), VEC::pos_x())).empty());
+        CHECK(flatTree.findContainers(VEC::zero()).empty());
+    }
+
+    TEST_CASE("FlatAABBTreeTest.findIntersectorsOfTreeWithTwoNodes", "[FlatAABBTreeTest]") {
+        AABB tree;
+        tree.insert(BOX(VEC(-2.0, -1.0, -1.0), VEC(-1.0, +1.0, +1.0)), 1u);
+        tree.insert(BOX(VEC(+1.0, -1.0, -1.0), VEC(+2.0, +1.0, +1.0)), 2u);
+
+        const FLAT flatTree(tree);
+        CHECK(flatTree.nodeCount() == 3u);
+
+        using V = std::vector<size_t>;
+        CHECK_THAT(flatTree.findIntersectors(RAY(VEC(+3.0,  0.0,  0.0), VEC::pos_x())), Catch::UnorderedEquals(V{}));
+        CHECK_THAT(flatTree.findIntersectors(RAY(VEC(-3.0,  0.0,  0.0), VEC::neg_x())), Catch::UnorderedEquals(V{}));
+        CHECK_THAT(flatTree.findIntersectors(RAY(VEC( 0.0,  0.0,  0.0), VEC::pos_z())), Catch::UnorderedEquals(V{}));
+        CHECK_THAT(flatTree.findIntersectors(RAY(VEC( 0.0,  0.0,  0.0), VEC::pos_x())), Catch::UnorderedEquals(V{ 2u }));
+        CHECK_THAT(flatTree.findIntersectors(RAY(VEC( 0.0,  0.0,  0.0), VEC::neg_x())), Catch::UnorderedEquals(V{ 1u }));
+        CHECK_THAT(flatTree.findIntersectors(RAY(VEC(-3.0,  0.0,  0.0), VEC::pos_x())), Catch::UnorderedEquals(V{ 1u, 2u }));
+        CHECK_THAT(flatTree.findIntersectors(RAY(VEC(+3.0,  0.0,  0.0), VEC::neg_x())), Catch::UnorderedEquals(V{ 1u, 2u }));
+        CHECK_THAT(flatTree.findIntersectors(RAY(VEC(-1.5, -2.0,  0.0), VEC::pos_y())), Catch::UnorderedEquals(V{ 1u }));
+        CHECK_THAT(flatTree.findIntersectors(RAY(VEC(+1.5, -2.0,  0.0), VEC::pos_y())), Catch::UnorderedEquals(V{ 2u }));
+        CHECK_THAT(flatTree.findIntersectors(RAY(VEC(-1.5,  0.0,  0.0), VEC::pos_y())), Catch::UnorderedEquals(V{ 1u }));
+
+        CHECK_THAT(flatTree.findContainers(VEC(-1.5, 0.0, 0.0)), Catch::UnorderedEquals(V{ 1u }));
+        CHECK_THAT(flatTree.findContainers(VEC( 0.0, 0.0, 0.0)), Catch::UnorderedEquals(V{}));
+    }
+
+    TEST_CASE("FlatAABBTreeTest.matchesTree", "[FlatAABBTreeTest]") {
+        auto rng = std::mt19937(0u);
+        auto coord = std::uniform_real_distribution<double>(-64.0, 64.0);
+        auto extent = std::uniform_real_distribution<double>(0.0, 8.0);
+
+        AABB tree;
+        for (size_t i = 0; i < 500u; ++i) {
+            const auto min = VEC(coord(rng), coord(rng), coord(rng));
+            const auto max = min + VEC(extent(rng), extent(rng), extent(rng));
+            tree.insert(BOX(min, max), i);
+        }
+
+        const FLAT flatTree(tree);
+        CHECK(flatTree.nodeCount() == 999u);
+
+        auto direction = std::uniform_real_distribution<double>(-1.0, 1.0);
+        for (size_t i = 0; i < 100u; ++i) {
+            const auto origin = VEC(coord(rng), coord(rng), coord(rng));
+            const auto ray = RAY(origin, VEC(direction(rng), direction(rng), direction(rng)));
+            CHECK_THAT(flatTree.findIntersectors(ray), Catch::UnorderedEquals(tree.findIntersectors(ray)));
+            CHECK_THAT(flatTree.findContainers(origin), Catch::UnorderedEquals(tree.findContainers(origin)));
+        }
+    }
+
+    TEST_CASE("FlatAABBTreeTest.findIntersectorsByDistance", "[FlatAABBTreeTest]") {
+        AABB tree;
+        tree.insert(BOX(VEC(+4.0, -1.0, -1.0), VEC(+5.0, +1.0, +1.0)), 1u);
+        tree.insert(BOX(VEC(-1.0, -1.0, -1.0), VEC(+1.0, +1.0, +1.0)), 2u);
+        tree.insert(BOX(VEC(+2.0, -1.0, -1.0), VEC(+3.0, +1.0, +1.0)), 3u);
+        tree.insert(BOX(VEC(+2.0, +2.0, -1.0), VEC(+3.0, +3.0, +1.0)), 4u);
+
+        const FLAT flatTree(tree);
+        const auto ray = RAY(VEC(0.0, 0.0, 0.0), VEC::pos_x());
+
+        std::vector<std::pair<size_t, double>> hits;
+        flatTree.findIntersectorsByDistance(ray, [&](const size_t data, const double distance) {
+            hits.emplace_back(data, distance);
+            return true;
+        });
+        CHECK(hits == std::vector<std::pair<size_t, double>>{ { 2u, 0.0 }, { 3u, 2.0 }, { 1u, 4.0 } });
+
+        hits.clear();
+        flatTree.findIntersectorsByDistance(ray, [&](const size_t data, const double distance) {
+            hits.emplace_back(data, distance);
+            return distance < 1.0;
+        });
+        CHECK(hits == std::vector<std::pair<size_t, double>>{ { 2u, 0.0 }, { 3u, 2.0 } });
+    }
+}
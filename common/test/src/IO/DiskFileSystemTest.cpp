@@ -147,6 +147,19 @@ namespace TrenchBroom {
             CHECK_THROWS_AS(Disk::openFile(env.dir() + Path("does_not_exist.txt")), FileNotFoundException);
             CHECK(Disk::openFile(env.dir() + Path("test.txt")) != nullptr);
             CHECK(Disk::openFile(env.dir() + Path("anotherDir/subDirTest/test2.map")) != nullptr);
+
+            const auto file = Disk::openFile(env.dir() + Path("test.txt"));
+            CHECK(file->size() == 12u);
+            CHECK(file->reader().buffer().stringView() == "some content");
+        }
+
+        TEST_CASE("DiskTest.openEmptyFile", "[DiskTest]") {
+            FSTestEnvironment env;
+            env.createFile(Path("empty.txt"), "");
+
+            const auto file = Disk::openFile(env.dir() + Path("empty.txt"));
+            CHECK(file->size() == 0u);
+            CHECK(file->reader().buffer().stringView().empty());
         }
 
         TEST_CASE("DiskTest.resolvePath", "[DiskTest]") {
@@ -326,6 +339,29 @@ namespace TrenchBroom {
             checkOpenFile(Path("anotherDir/../anotherDir/./test3.map"));
         }
 
+        TEST_CASE("DiskFileSystemTest.invalidateCaches", "[DiskFileSystemTest]") {
+            FSTestEnvironment env;
+            DiskFileSystem fs(env.dir());
+
+            CHECK_FALSE(fs.fileExists(Path("anotherDir/newFile.txt")));
+            CHECK_FALSE(fs.directoryExists(Path("anotherDir/newDir")));
+
+            env.createFile(Path("anotherDir/newFile.txt"), "some content");
+            env.createDirectory(Path("anotherDir/newDir"));
+            fs.invalidateCaches();
+
+            CHECK(fs.fileExists(Path("anotherDir/newFile.txt")));
+            CHECK(fs.fileExists(Path("ANOTHERDIR/NEWFILE.TXT")));
+            CHECK(fs.directoryExists(Path("anotherDir/NewDir")));
+            CHECK(fs.openFile(Path("anotherdir/newfile.txt")) != nullptr);
+            CHECK_THAT(fs.getDirectoryContents(Path("ANOTHERDIR")), Catch::UnorderedEquals(std::vector<Path>{
+                Path("subDirTest"),
+                Path("test3.map"),
+                Path("newFile.txt"),
+                Path("newDir"),
+            }));
+        }
+
         TEST_CASE("WritableDiskFileSystemTest.createWritableDiskFileSystem", "[WritableDiskFileSystemTest]") {
             FSTestEnvironment env;
 
@@ -19,10 +19,15 @@
 
 #include "Exceptions.h"
 #include "IO/DiskIO.h"
+#include "IO/File.h"
 #include "IO/FileMatcher.h"
 #include "IO/IdPakFileSystem.h"
+#include "IO/Reader.h"
+
+#include <kdl/string_compare.h>
 
 #include <algorithm>
+#include <memory>
 
 #include "Catch2.h"
 
@@ -137,5 +142,16 @@ namespace TrenchBroom {
 
             CHECK(fs.openFile(Path("amnet.cfg")) != nullptr);
         }
+
+        TEST_CASE("IdPakFileSystemTest.openFileOutlivesFileSystem", "[IdPakFileSystemTest]") {
+            const Path pakPath = Disk::getCurrentWorkingDir() + Path("fixture/test/IO/Pak/pak1.pak");
+
+            auto fs = std::make_unique<IdPakFileSystem>(pakPath);
+            const auto file = fs->openFile(Path("amnet.cfg"));
+            fs.reset();
+
+            CHECK(file->size() == 447u);
+            CHECK(kdl::cs::str_is_prefix(file->reader().buffer().stringView(), "//\r\n// my stuff\r\n"));
+        }
     }
 }
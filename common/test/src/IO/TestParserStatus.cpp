@@ -20,6 +20,7 @@
 #include "TestParserStatus.h"
 
 #include <string>
+#include <vector>
 
 namespace TrenchBroom {
     namespace IO {
@@ -43,7 +44,13 @@ namespace TrenchBroom {
             return it->second;
         }
 
-        void TestParserStatus::doProgress(const double) {}
+        const std::vector<double>& TestParserStatus::progressReports() const {
+            return m_progressReports;
+        }
+
+        void TestParserStatus::doProgress(const double progress) {
+            m_progressReports.push_back(progress);
+        }
 
         void TestParserStatus::doLog(const LogLevel level, const std::string& str) {
             m_messages[level].push_back(str);
@@ -19,14 +19,20 @@
 
 #include "Logger.h"
 #include "Assets/Texture.h"
+#include "Assets/TextureCollection.h"
 #include "Assets/TextureManager.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/DiskIO.h"
+#include "IO/FileMatcher.h"
 #include "IO/Path.h"
 #include "IO/TextureLoader.h"
+#include "IO/WadFileSystem.h"
 #include "Model/GameConfig.h"
 
+#include <kdl/vector_utils.h>
+
 #include <string>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -144,5 +150,36 @@ namespace TrenchBroom {
                 CHECK(texture->height() == height);
             }
         }
+
+        TEST_CASE("TextureLoaderTest.testLoadPreservesOrder", "[TextureLoaderTest]") {
+            const auto path = Path("fixture/test/IO/Wad/cr8_czg.wad");
+
+            const IO::Path root = IO::Disk::getCurrentWorkingDir();
+            const std::vector<IO::Path> fileSearchPaths{ root };
+            const IO::DiskFileSystem fileSystem(root, true);
+
+            const Model::TextureConfig textureConfig(
+                Model::TexturePackageConfig(
+                    Model::PackageFormatConfig("wad", "idmip")),
+                    Model::PackageFormatConfig("D", "idmip"),
+                    IO::Path("fixture/test/palette.lmp"),
+                    "wad",
+                    IO::Path(),
+                    {});
+
+            auto logger = NullLogger();
+
+            // the textures are read in parallel, but must appear in the same order as in the file system
+            const WadFileSystem wadFS(root + path, logger);
+            const auto expectedNames = kdl::vec_transform(wadFS.findItems(Path(""), FileExtensionMatcher("D")), [](const auto& p) {
+                return p.lastComponent().deleteExtension().asString();
+            });
+
+            IO::TextureLoader textureLoader(fileSystem, fileSearchPaths, textureConfig, logger);
+            const auto collection = textureLoader.loadTextureCollection(path);
+
+            CHECK(collection.loaded());
+            CHECK(kdl::vec_transform(collection.textures(), [](const auto& t) { return t.name(); }) == expectedNames);
+        }
     }
 }
@@ -39,6 +39,7 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <string>
 
 #include "Catch2.h"
@@ -1701,6 +1702,161 @@ common/caulk
             }
         }
 
+        static void collectNodePositions(const Model::Node* node, std::vector<std::string>& result) {
+            result.push_back(fmt::format("{} {} {}", node->name(), node->lineNumber(), node->childCount()));
+            for (const auto* child : node->children()) {
+                collectNodePositions(child, result);
+            }
+        }
+
+        TEST_CASE("WorldReaderTest.parseInParallel", "[WorldReaderTest]") {
+            const auto data = std::string{R"(// Game: Quake
+// Format: Standard
+// entity 0
+{
+"classname" "worldspawn"
+"message" "{ braces } in a value"
+// brush 0
+{
+( -64 -64 -16 ) ( -64 -63 -16 ) ( -64 -64 -15 ) __TB_empty 0 0 0 1 1
+( -64 -64 -16 ) ( -64 -64 -15 ) ( -63 -64 -16 ) __TB_empty 0 0 0 1 1
+( -64 -64 -16 ) ( -63 -64 -16 ) ( -64 -63 -16 ) __TB_empty 0 0 0 1 1
+( 64 64 16 ) ( 64 65 16 ) ( 65 64 16 ) __TB_empty 0 0 0 1 1
+( 64 64 16 ) ( 65 64 16 ) ( 64 64 17 ) __TB_empty 0 0 0 1 1
+( 64 64 16 ) ( 64 64 17 ) ( 64 65 16 ) __TB_empty 0 0 0 1 1
+}
+}
+// entity 1
+{
+"classname" "light"
+"origin" "0 0 0"
+"origin" "1 1 1"
+}
+; entity 2 {
+{
+"classname" "func_wall"
+"path" "trailing\"
+// brush 0
+{
+( -64 -64 -16 ) ( -64 -63 -16 ) ( -64 -64 -15 ) {fence 0 0 0 1 1
+( -64 -64 -16 ) ( -64 -64 -15 ) ( -63 -64 -16 ) {fence 0 0 0 1 1
+( -64 -64 -16 ) ( -63 -64 -16 ) ( -64 -63 -16 ) {fence 0 0 0 1 1
+( 64 64 16 ) ( 64 65 16 ) ( 65 64 16 ) {fence 0 0 0 1 1
+( 64 64 16 ) ( 65 64 16 ) ( 64 64 17 ) {fence 0 0 0 1 1
+( 64 64 16 ) ( 64 64 17 ) ( 64 65 16 ) {fence 0 0 0 1 1
+}
+// brush 1
+{
+( 0 0 0 ) ( 0 0 0 ) ( 0 0 0 ) __TB_empty 0 0 0 1 1
+( 64 64 16 ) ( 64 65 16 ) ( 65 64 16 ) __TB_empty 0 0 0 1 1
+}
+}
+// entity 3
+{
+"classname" "func_group"
+"_tb_type" "_tb_group"
+"_tb_name" "group"
+"_tb_id" "1"
+}
+// entity 4
+{
+"classname" "info_player_start"
+"_tb_group" "1"
+}
+)"};
+
+            const vm::bbox3 worldBounds(8192.0);
+
+            IO::TestParserStatus sequentialStatus;
+            WorldReader sequentialReader(data, Model::MapFormat::Standard);
+            sequentialReader.setParallelParsingThreshold(data.size() + 1u);
+            auto sequentialWorld = sequentialReader.read(worldBounds, sequentialStatus);
+
+            IO::TestParserStatus parallelStatus;
+            WorldReader parallelReader(data, Model::MapFormat::Standard);
+            parallelReader.setParallelParsingThreshold(0u);
+            auto parallelWorld = parallelReader.read(worldBounds, parallelStatus);
+
+            REQUIRE(sequentialWorld != nullptr);
+            REQUIRE(parallelWorld != nullptr);
+
+            auto sequentialNodes = std::vector<std::string>{};
+            collectNodePositions(sequentialWorld.get(), sequentialNodes);
+            auto parallelNodes = std::vector<std::string>{};
+            collectNodePositions(parallelWorld.get(), parallelNodes);
+            CHECK(parallelNodes == sequentialNodes);
+
+            const auto* funcWall = dynamic_cast<Model::EntityNode*>(parallelWorld->defaultLayer()->children()[2]);
+            REQUIRE(funcWall != nullptr);
+            CHECK(funcWall->entity().classname() == "func_wall");
+            CHECK(funcWall->lineNumber() == 24u);
+            REQUIRE(funcWall->childCount() == 1u);
+            CHECK(static_cast<Model::BrushNode*>(funcWall->children().front())->brush().face(0).attributes().textureName() == "{fence");
+
+            for (const auto level : { LogLevel::Debug, LogLevel::Info, LogLevel::Warn, LogLevel::Error }) {
+                CHECK(parallelStatus.messages(level) == sequentialStatus.messages(level));
+            }
+            CHECK(parallelStatus.countStatus(LogLevel::Warn) == 1u);
+            CHECK(parallelStatus.countStatus(LogLevel::Error) == 2u);
+
+            // progress is reported once per parsed chunk
+            const auto& progressReports = parallelStatus.progressReports();
+            REQUIRE(progressReports.size() > 1u);
+            CHECK(std::is_sorted(std::begin(progressReports), std::end(progressReports)));
+            CHECK(progressReports.front() > 0.0);
+            CHECK(progressReports.back() == 1.0);
+        }
+
+        TEST_CASE("WorldReaderTest.parseInParallelWithError", "[WorldReaderTest]") {
+            const auto data = std::string{R"(
+{
+"classname" "worldspawn"
+}
+{
+"classname" "light"
+"origin" "1 1 1"
+"origin" "2 2 2"
+}
+{
+"classname" "func_wall"
+{
+( -64 -64 -16 ) ( -64 -63 -16 ) ( -64 -64 -15 ) __TB_empty 0 0 0 1
+}
+}
+{
+"classname" "light"
+}
+)"};
+
+            const vm::bbox3 worldBounds(8192.0);
+
+            IO::TestParserStatus sequentialStatus;
+            WorldReader sequentialReader(data, Model::MapFormat::Standard);
+            sequentialReader.setParallelParsingThreshold(data.size() + 1u);
+            std::string sequentialError;
+            try {
+                sequentialReader.read(worldBounds, sequentialStatus);
+            } catch (const ParserException& e) {
+                sequentialError = e.what();
+            }
+
+            IO::TestParserStatus parallelStatus;
+            WorldReader parallelReader(data, Model::MapFormat::Standard);
+            parallelReader.setParallelParsingThreshold(0u);
+            std::string parallelError;
+            try {
+                parallelReader.read(worldBounds, parallelStatus);
+            } catch (const ParserException& e) {
+                parallelError = e.what();
+            }
+
+            CHECK_FALSE(sequentialError.empty());
+            CHECK(parallelError == sequentialError);
+            for (const auto level : { LogLevel::Debug, LogLevel::Info, LogLevel::Warn, LogLevel::Error }) {
+                CHECK(parallelStatus.messages(level) == sequentialStatus.messages(level));
+            }
+        }
+
         TEST_CASE("WorldReaderTest.parseUnknownFormatEmptyMap", "[WorldReaderTest]") {
             const auto data = R"(
 {
@@ -20,9 +20,13 @@
 #include "Exceptions.h"
 #include "IO/DiskIO.h"
 #include "IO/DiskFileSystem.h"
+#include "IO/File.h"
 #include "IO/FileMatcher.h"
+#include "IO/Reader.h"
 #include "IO/ZipFileSystem.h"
 
+#include <kdl/string_compare.h>
+
 #include <algorithm>
 #include <cassert>
 
@@ -138,6 +142,27 @@ namespace TrenchBroom {
             CHECK_THROWS_AS(fs.openFile(Path("/textures")), FileSystemException);
 
             CHECK(fs.openFile(Path("amnet.cfg")) != nullptr);
+
+            const auto file = fs.openFile(Path("amnet.cfg"));
+            CHECK(file->size() == 447u);
+            CHECK(kdl::cs::str_is_prefix(file->reader().buffer().stringView(), "//\r\n// my stuff\r\n"));
+
+            // decompressed files are cached
+            CHECK(fs.openFile(Path("amnet.cfg")) == file);
+        }
+
+        TEST_CASE("ZipFileSystemTest.prefetchFiles", "[ZipFileSystemTest]") {
+            const Path zipPath = Disk::getCurrentWorkingDir() + Path("fixture/test/IO/Zip/zip_test.zip");
+
+            const ZipFileSystem fs(zipPath);
+            CHECK_NOTHROW(fs.prefetchFiles({Path("bear.cfg"), Path("pics/tag1.pcx"), Path("pics"), Path("does_not_exist.cfg"), Path("/bear.cfg")}));
+
+            const auto bearFile = fs.openFile(Path("bear.cfg"));
+            CHECK(bearFile->size() == 1489u);
+            CHECK(fs.openFile(Path("bear.cfg")) == bearFile);
+
+            const auto tagFile = fs.openFile(Path("pics/tag1.pcx"));
+            CHECK(tagFile->size() == 4993u);
         }
     }
 }
@@ -42,7 +42,16 @@ namespace TrenchBroom {
                                                                                 {0, 0.5, 0.375}, {0.5, 0.5, 0.75},  {1, 0.5, 0.875}, {1.5, 0.5, 0.75},  {2, 0.5, 0.375}, 
                                                                                 {0, 1,   0.5},   {0.5, 1,   0.875}, {1, 1,   1},     {1.5, 1,   0.875}, {2, 1,   0.5}, 
                                                                                 {0, 1.5, 0.375}, {0.5, 1.5, 0.75},  {1, 1.5, 0.875}, {1.5, 1.5, 0.75},  {2, 1.5, 0.375}, 
-                                                                                {0, 2,   0},     {0.5, 2,   0.375}, {1, 2,   0.5},   {1.5, 2,   0.375}, {2, 2,   0} } }
+                                                                                {0, 2,   0},     {0.5, 2,   0.375}, {1, 2,   0.5},   {1.5, 2,   0.375}, {2, 2,   0} } },
+                       {  3,  5, { {0, 0, 0}, {1, 0, 1}, {2, 0, 0}, {3, 0, 1}, {4, 0, 0},
+                                   {0, 1, 1}, {1, 1, 2}, {2, 1, 1}, {3, 1, 2}, {4, 1, 1},
+                                   {0, 2, 0}, {1, 2, 1}, {2, 2, 0}, {3, 2, 1}, {4, 2, 0} }, 0,    { {0, 0,   0},                       {2, 0,   0},                       {4, 0,   0},
+                                                                                {0, 2,   0},                       {2, 2,   0},                       {4, 2,   0} } },
+                       {  3,  5, { {0, 0, 0}, {1, 0, 1}, {2, 0, 0}, {3, 0, 1}, {4, 0, 0},
+                                   {0, 1, 1}, {1, 1, 2}, {2, 1, 1}, {3, 1, 2}, {4, 1, 1},
+                                   {0, 2, 0}, {1, 2, 1}, {2, 2, 0}, {3, 2, 1}, {4, 2, 0} }, 1,    { {0, 0,   0},     {1, 0,   0.5},     {2, 0,   0},     {3, 0,   0.5},     {4, 0,   0},
+                                                                                {0, 1,   0.5},   {1, 1,   1},       {2, 1,   0.5},   {3, 1,   1},       {4, 1,   0.5},
+                                                                                {0, 2,   0},     {1, 2,   0.5},     {2, 2,   0},     {3, 2,   0.5},     {4, 2,   0} } }
             }));
 
             const auto patch = BezierPatch{w, h, controlPoints, ""};
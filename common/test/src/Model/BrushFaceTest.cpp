@@ -120,6 +120,66 @@ namespace TrenchBroom {
             CHECK(texture2.usageCount() == 0u);
         }
 
+        TEST_CASE("BrushFaceTest.sharedAttributes", "[BrushFaceTest]") {
+            BrushFaceAttributes attribs("texture");
+            attribs.setXOffset(8.0f);
+
+            const BrushFaceAttributes copy1 = attribs;
+            const BrushFaceAttributes copy2 = attribs;
+            CHECK(copy1.sharesDataWith(copy2));
+            CHECK_FALSE(copy1.sharesDataWith(attribs));
+            CHECK(copy1 == attribs);
+
+            // equal attributes created independently share their values, too
+            BrushFaceAttributes other("texture");
+            other.setXOffset(8.0f);
+            const BrushFaceAttributes copy3 = other;
+            CHECK(copy3.sharesDataWith(copy1));
+
+            // modifying a copy does not affect the others
+            BrushFaceAttributes copy4 = copy1;
+            CHECK(copy4.setYScale(2.0f));
+            CHECK_FALSE(copy4.sharesDataWith(copy1));
+            CHECK(copy4.yScale() == 2.0f);
+            CHECK(copy1.yScale() == 1.0f);
+            CHECK(copy2.yScale() == 1.0f);
+
+            // setting an unchanged value does not unshare the values
+            BrushFaceAttributes copy5 = copy1;
+            CHECK_FALSE(copy5.setXOffset(8.0f));
+            CHECK(copy5.sharesDataWith(copy1));
+
+            const BrushFaceAttributes renamed("other", copy1);
+            CHECK(renamed.textureName() == "other");
+            CHECK(renamed.xOffset() == 8.0f);
+            CHECK(copy1.textureName() == "texture");
+
+            // moving does not intern the values, and moved interned values remain shared
+            const BrushFaceAttributes moved1 = std::move(attribs);
+            CHECK_FALSE(moved1.sharesDataWith(copy1));
+            CHECK(moved1 == copy1);
+
+            const BrushFaceAttributes moved2 = std::move(copy5);
+            CHECK(moved2.sharesDataWith(copy1));
+
+            // moved-from attributes can still be used and do not share values with the attributes they were moved to
+            CHECK(attribs.textureName().empty());
+            attribs.setXOffset(4.0f);
+            CHECK(attribs.xOffset() == 4.0f);
+            CHECK(moved1.xOffset() == copy1.xOffset());
+
+            copy5 = attribs;
+            CHECK(copy5 == attribs);
+            CHECK(moved2.sharesDataWith(copy1));
+
+            BrushFaceAttributes target("target");
+            target = std::move(copy4);
+            CHECK(target.yScale() == 2.0f);
+            CHECK(copy4.textureName().empty());
+            CHECK(copy4.setYScale(3.0f));
+            CHECK(target.yScale() == 2.0f);
+        }
+
         TEST_CASE("BrushFaceTest.projectedArea") {
             const auto worldBounds = vm::bbox3{8192.0};
             const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
@@ -24,6 +24,7 @@
 #include "IO/DiskIO.h"
 #include "IO/NodeReader.h"
 #include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
 #include "Model/Brush.h"
 #include "Model/BrushError.h"
 #include "Model/BrushFace.h"
@@ -31,20 +32,28 @@
 #include "Model/BrushGeometry.h"
 #include "Model/BrushBuilder.h"
 #include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Model/GroupNode.h"
+#include "Model/LayerNode.h"
+#include "Model/PatchNode.h"
 #include "Model/Polyhedron.h"
+#include "Model/WorldNode.h"
 
 #include <kdl/intrusive_circular_list.h>
+#include <kdl/overload.h>
 #include <kdl/result.h>
 #include <kdl/result_for_each.h>
 #include <kdl/vector_utils.h>
 
 #include <vecmath/approx.h>
+#include <vecmath/mat_ext.h>
 #include <vecmath/polygon.h>
 #include <vecmath/ray.h>
 #include <vecmath/segment.h>
 #include <vecmath/vec.h>
 #include <vecmath/vec_ext.h>
 
+#include <algorithm>
 #include <fstream>
 #include <string>
 #include <vector>
@@ -505,6 +514,39 @@ namespace TrenchBroom {
             CHECK(brush1.expand(worldBounds, -64, true).is_error());
         }
 
+        TEST_CASE("BrushTest.discardAndRestoreGeometry", "[BrushTest]") {
+            const vm::bbox3 worldBounds(8192.0);
+            const BrushBuilder builder(MapFormat::Standard, worldBounds);
+
+            const Brush original = builder.createCuboid(vm::bbox3(vm::vec3(-64, -64, -64), vm::vec3(64, 64, 64)), "texture").value();
+            Brush brush = original;
+            REQUIRE(brush.hasGeometry());
+
+            CHECK(brush.discardGeometry());
+            CHECK_FALSE(brush.hasGeometry());
+            CHECK(brush.faces() == original.faces());
+
+            const Brush copy = brush;
+            CHECK_FALSE(copy.hasGeometry());
+
+            CHECK(brush.restoreGeometry(worldBounds).is_success());
+            CHECK(brush.hasGeometry());
+            CHECK(brush == original);
+            CHECK(brush.bounds() == original.bounds());
+            CHECK_THAT(brush.vertexPositions(), Catch::UnorderedEquals(original.vertexPositions()));
+
+            // the geometry is not discarded if a face was dropped when it was built
+            auto faces = original.faces();
+            auto redundantFace = faces[*original.findFace(vm::vec3::pos_x())];
+            REQUIRE(redundantFace.transform(vm::translation_matrix(vm::vec3(64, 0, 0)), false).is_success());
+            faces.push_back(std::move(redundantFace));
+
+            Brush withRedundantFace = Brush::create(worldBounds, std::move(faces)).value();
+            REQUIRE(withRedundantFace.faceCount() == original.faceCount());
+            CHECK_FALSE(withRedundantFace.discardGeometry());
+            CHECK(withRedundantFace.hasGeometry());
+        }
+
         TEST_CASE("BrushTest.moveVertex", "[BrushTest]") {
             const vm::bbox3 worldBounds(4096.0);
 
@@ -3587,5 +3629,85 @@ namespace TrenchBroom {
 
             kdl::col_delete_all(nodes);
         }
+
+        TEST_CASE("BrushTest.buildGeometryFromPlanesMatchesClipping", "[BrushTest]") {
+            const auto mapPath = GENERATE(values<std::string>({
+                "fixture/test/IO/Map/rtz_q1.map",
+                "fixture/test/IO/Map/mapobject.map",
+                "fixture/test/Model/Brush/curvetut-crash.map",
+                "fixture/test/Model/Brush/subtrahend.map",
+                "fixture/test/Model/Brush/weirdcurvemerge.map",
+                "fixture/test/Model/PortalFile/portaltest.map",
+                "fixture/test/View/MapDocumentTest/csgHollow.map",
+                "fixture/test/View/MapDocumentTest/csgSubtractFailure.map",
+                "fixture/test/View/ResizeBrushesToolTest/splitBrushes.map",
+                "fixture/test/View/ResizeBrushesToolTest/findDragFaces_twoCoplanarFaces.map",
+            }));
+
+            CAPTURE(mapPath);
+
+            const vm::bbox3 worldBounds(8192.0);
+
+            const auto path = IO::Disk::getCurrentWorkingDir() + IO::Path(mapPath);
+            const std::string data = IO::Disk::readTextFile(path);
+            REQUIRE(!data.empty());
+
+            IO::TestParserStatus status;
+            const auto world = IO::WorldReader::tryRead(data, { MapFormat::Standard, MapFormat::Valve }, worldBounds, status);
+            REQUIRE(world != nullptr);
+
+            std::vector<const BrushNode*> brushNodes;
+            world->accept(kdl::overload(
+                [] (auto&& thisLambda, const WorldNode* worldNode)   { worldNode->visitChildren(thisLambda); },
+                [] (auto&& thisLambda, const LayerNode* layerNode)   { layerNode->visitChildren(thisLambda); },
+                [] (auto&& thisLambda, const GroupNode* groupNode)   { groupNode->visitChildren(thisLambda); },
+                [] (auto&& thisLambda, const EntityNode* entityNode) { entityNode->visitChildren(thisLambda); },
+                [&](const BrushNode* brushNode)                      { brushNodes.push_back(brushNode); },
+                [] (const PatchNode*)                                {}
+            ));
+            REQUIRE(!brushNodes.empty());
+
+            for (const BrushNode* brushNode : brushNodes) {
+                CAPTURE(brushNode->lineNumber());
+
+                std::vector<vm::plane3> planes;
+                for (const BrushFace& face : brushNode->brush().faces()) {
+                    planes.push_back(face.boundary());
+                }
+
+                std::vector<BrushFaceGeometry*> planeFaces;
+                const auto direct = BrushGeometry::fromPlanes(planes, planeFaces);
+                if (!direct) {
+                    continue;
+                }
+
+                // build the geometry like Brush did before it could build geometry from planes
+                BrushGeometry clipped(worldBounds);
+                for (size_t i = 0u; i < planes.size(); ++i) {
+                    const auto result = clipped.clip(planes[i]);
+                    if (result.success()) {
+                        result.face()->setPayload(i);
+                    }
+                    REQUIRE(!result.empty());
+                }
+                clipped.correctVertexPositions();
+                REQUIRE(clipped.healEdges());
+
+                CHECK(*direct == clipped);
+                CHECK(direct->bounds() == clipped.bounds());
+
+                REQUIRE(planeFaces.size() == planes.size());
+                const auto directFaceCount = std::count_if(std::begin(planeFaces), std::end(planeFaces), [](const auto* f) { return f != nullptr; });
+                CHECK(static_cast<size_t>(directFaceCount) == clipped.faceCount());
+
+                for (const BrushFaceGeometry* clippedFace : clipped.faces()) {
+                    const auto faceIndex = clippedFace->payload();
+                    REQUIRE(faceIndex.has_value());
+                    REQUIRE(planeFaces[*faceIndex] != nullptr);
+                    CHECK(planeFaces[*faceIndex]->plane() == clippedFace->plane());
+                    CHECK(planeFaces[*faceIndex]->hasVertexPositions(clippedFace->vertexPositions()));
+                }
+            }
+        }
     }
 }
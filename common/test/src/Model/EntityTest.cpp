@@ -31,6 +31,8 @@
 #include <vecmath/vec.h>
 #include <vecmath/vec_io.h>
 
+#include <thread>
+
 #include "Catch2.h"
 
 namespace TrenchBroom {
@@ -44,6 +46,34 @@ namespace TrenchBroom {
             CHECK(entity.rotation() == vm::mat4x4::identity());
         }
 
+        TEST_CASE("EntityTest.internedPropertyKeys") {
+            const auto& key = internPropertyKey("some_key");
+            CHECK(key == "some_key");
+            CHECK(&internPropertyKey(std::string("some_key")) == &key);
+            CHECK(&internPropertyKey("other_key") != &key);
+
+            auto property1 = EntityProperty("some_key", "value");
+            const auto property2 = EntityProperty(std::string("some_") + "key", "value");
+            CHECK(&property1.key() == &key);
+            CHECK(&property2.key() == &key);
+            CHECK(property1 == property2);
+
+            property1.setKey("other_key");
+            CHECK(&property1.key() == &internPropertyKey("other_key"));
+            CHECK(property1 != property2);
+            CHECK(property1 < property2);
+
+            // keys interned on other threads are shared, too
+            const std::string* otherThreadKey = nullptr;
+            const std::string* otherThreadNewKey = nullptr;
+            std::thread([&]() {
+                otherThreadKey = &internPropertyKey("some_key");
+                otherThreadNewKey = &internPropertyKey("third_key");
+            }).join();
+            CHECK(otherThreadKey == &key);
+            CHECK(otherThreadNewKey == &internPropertyKey("third_key"));
+        }
+
         TEST_CASE("EntityTest.definitionBounds") {
             auto pointEntityDefinition = Assets::PointEntityDefinition("some_name", Color(), vm::bbox3(32.0), "", {}, {});
             Entity entity;
@@ -31,6 +31,7 @@
 #include "Model/Layer.h"
 #include "Model/LayerNode.h"
 #include "Model/MapFormat.h"
+#include "Model/NodeContents.h"
 #include "Model/PatchNode.h"
 #include "Model/WorldNode.h"
 
@@ -45,6 +46,9 @@
 #include <vecmath/vec.h>
 #include <vecmath/vec_io.h>
 
+#include <memory>
+#include <vector>
+
 #include "TestUtils.h"
 #include "Catch2.h"
 
@@ -380,6 +384,69 @@ namespace TrenchBroom {
             }));
         }
 
+        TEST_CASE("ModelUtils.collectTouchingAndContainedNodesInWorld") {
+            constexpr auto worldBounds = vm::bbox3d{8192.0};
+            constexpr auto mapFormat = MapFormat::Quake3;
+
+            auto worldNode = WorldNode{Entity{}, mapFormat};
+            auto builder = BrushBuilder{mapFormat, worldBounds};
+
+            auto* groupNode = new GroupNode{Group{"group"}};
+            auto* groupedEntityNode = new EntityNode{Entity{}};
+            auto* entityNode = new EntityNode{Entity{}};
+            auto* brushNode = new BrushNode{builder.createCube(64.0, "texture").value()};
+            auto* farBrushNode = new BrushNode{builder.createCube(64.0, "texture").value()};
+            auto* patchNode = new PatchNode{BezierPatch{3, 3, {
+                {0, 0, 0}, {1, 0, 1}, {2, 0, 0},
+                {0, 1, 1}, {1, 1, 2}, {2, 1, 1},
+                {0, 2, 0}, {1, 2, 1}, {2, 2, 0} }, "texture"}};
+
+            transformNode(*farBrushNode, vm::translation_matrix(vm::vec3d{1024, 0, 0}), worldBounds);
+
+            groupNode->addChild(groupedEntityNode);
+            worldNode.defaultLayer()->addChildren({groupNode, entityNode, brushNode, farBrushNode, patchNode});
+
+            auto smallCube = BrushNode{builder.createCube(8.0, "texture").value()};
+            auto largeCube = BrushNode{builder.createCube(128.0, "texture").value()};
+            auto farCube = BrushNode{largeCube.brush()};
+            transformNode(farCube, vm::translation_matrix(vm::vec3d{1024, 0, 0}), worldBounds);
+            auto nowhereCube = BrushNode{largeCube.brush()};
+            transformNode(nowhereCube, vm::translation_matrix(vm::vec3d{0, 1024, 0}), worldBounds);
+
+            const auto queries = std::vector<std::vector<BrushNode*>>{
+                {&smallCube},
+                {&largeCube},
+                {&farCube},
+                {&nowhereCube},
+                {&smallCube, &farCube},
+                {&largeCube, &farCube}
+            };
+
+            for (const auto& brushes : queries) {
+                CAPTURE(brushes.size());
+                CHECK_THAT(collectTouchingNodes(worldNode, brushes), Catch::Matchers::Equals(collectTouchingNodes(std::vector<Node*>{&worldNode}, brushes)));
+                CHECK_THAT(collectContainedNodes(worldNode, brushes), Catch::Matchers::Equals(collectContainedNodes(std::vector<Node*>{&worldNode}, brushes)));
+            }
+
+            CHECK_THAT(collectTouchingNodes(worldNode, {&farCube}), Catch::Matchers::Equals(std::vector<Node*>{
+                farBrushNode
+            }));
+
+            CHECK_THAT(collectContainedNodes(worldNode, {&largeCube, &farCube}), Catch::Matchers::Equals(std::vector<Node*>{
+                groupNode,
+                entityNode,
+                brushNode,
+                farBrushNode,
+                patchNode
+            }));
+
+            CHECK_THAT(collectTouchingNodes(worldNode, {brushNode}), Catch::Matchers::Equals(std::vector<Node*>{
+                groupNode,
+                entityNode,
+                patchNode
+            }));
+        }
+
         TEST_CASE("ModelUtils.collectSelectedNodes") {
             constexpr auto worldBounds = vm::bbox3d{8192.0};
             constexpr auto mapFormat = MapFormat::Quake3;
@@ -571,5 +638,32 @@ namespace TrenchBroom {
                 CHECK(filterEntityNodes({&worldNode, &layerNode, &groupNode, &entityNode, &brushNode, &patchNode}) == std::vector<Model::EntityNode*>{&entityNode});
             }
         }
+   
+        TEST_CASE("ModelUtils.estimateMemorySize") {
+            constexpr auto worldBounds = vm::bbox3d{8192.0};
+            constexpr auto mapFormat = MapFormat::Quake3;
+
+            auto brush = BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "texture").value();
+            const auto brushSize = estimateMemorySize(NodeContents{brush});
+            CHECK(brushSize > sizeof(Brush));
+
+            REQUIRE(brush.discardGeometry());
+            CHECK(estimateMemorySize(NodeContents{brush}) < brushSize);
+
+            auto* groupNode = new GroupNode{Group{"group"}};
+            auto* brushNode = new BrushNode{BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "texture").value()};
+
+            auto entity = Entity{};
+            entity.addOrUpdateProperty("some_key", "some_value");
+            auto* entityNode = new EntityNode{std::move(entity)};
+
+            const auto brushNodeSize = estimateMemorySize(std::vector<Node*>{brushNode});
+            CHECK(brushNodeSize >= brushSize);
+
+            groupNode->addChildren({brushNode, entityNode});
+            auto groupNodeWithChildren = std::unique_ptr<GroupNode>{groupNode};
+
+            CHECK(estimateMemorySize(std::vector<Node*>{groupNode}) > brushNodeSize + sizeof(GroupNode) + sizeof(EntityNode));
+        }
     }
 }
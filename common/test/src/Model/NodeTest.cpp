@@ -25,8 +25,12 @@
 #include "Model/BrushFace.h"
 #include "Model/BrushFaceAttributes.h"
 #include "Model/EditorContext.h"
+#include "Model/EmptyPropertyKeyIssueGenerator.h"
+#include "Model/EmptyPropertyValueIssueGenerator.h"
+#include "Model/Entity.h"
 #include "Model/EntityNode.h"
 #include "Model/GroupNode.h"
+#include "Model/Issue.h"
 #include "Model/LayerNode.h"
 #include "Model/MapFormat.h"
 #include "Model/Node.h"
@@ -737,5 +741,40 @@ namespace TrenchBroom {
             CHECK(child1_1.resolvePath(NodePath{{0}}) == &child1_1_1);
             CHECK(child1_1_1.resolvePath(NodePath{{}}) == &child1_1_1);
         }
+
+        TEST_CASE("NodeTest.validateIssues", "[NodeTest]") {
+            auto emptyKeyGenerator = EmptyPropertyKeyIssueGenerator{};
+            auto emptyValueGenerator = EmptyPropertyValueIssueGenerator{};
+
+            const auto oneGenerator = std::vector<IssueGenerator*>{&emptyKeyGenerator};
+            const auto bothGenerators = std::vector<IssueGenerator*>{&emptyKeyGenerator, &emptyValueGenerator};
+
+            auto entityNode = EntityNode{Entity{{EntityProperty{"", "value"}, EntityProperty{"key", ""}}}};
+
+            CHECK_FALSE(entityNode.issuesValid(oneGenerator));
+
+            entityNode.validateIssues(oneGenerator);
+            CHECK(entityNode.issuesValid(oneGenerator));
+            CHECK_FALSE(entityNode.issuesValid(bothGenerators));
+
+            REQUIRE(entityNode.issues(oneGenerator).size() == 1u);
+            const auto* emptyKeyIssue = entityNode.issues(oneGenerator).front();
+            CHECK(emptyKeyIssue->type() == emptyKeyGenerator.type());
+
+            SECTION("Adding a generator keeps the issues of the other generators") {
+                const auto& issues = entityNode.issues(bothGenerators);
+                REQUIRE(issues.size() == 2u);
+                CHECK(issues[0] == emptyKeyIssue);
+                CHECK(issues[1]->type() == emptyValueGenerator.type());
+                CHECK(entityNode.issuesValid(bothGenerators));
+            }
+
+            SECTION("Invalidating the issues discards the issues of all generators") {
+                entityNode.invalidateIssues();
+                CHECK_FALSE(entityNode.issuesValid(oneGenerator));
+                CHECK_FALSE(entityNode.issuesValid(bothGenerators));
+                CHECK(entityNode.issues(bothGenerators).size() == 2u);
+            }
+        }
     }
 }
@@ -30,6 +30,8 @@
 #include <vecmath/vec.h>
 #include <vecmath/vec_io.h>
 
+#include <memory>
+
 #include "Catch2.h"
 
 namespace vm {
@@ -144,6 +146,55 @@ namespace TrenchBroom {
             CHECK(makePatchGrid(BezierPatch{r, c, controlPoints, "texture"}, sd).points == kdl::vec_transform(expectedPoints, [](const auto& p) { return vm::approx{p}; }));
         }
 
+        TEST_CASE("PatchNode.grid") {
+            using P = BezierPatch::Point;
+            const auto flatPatch = BezierPatch{3, 5, {
+                P{0.0, 2.0, 0.0, 0.0, 0.0}, P{1.0, 2.0, 0.0, 0.25, 0.0}, P{2.0, 2.0, 0.0, 0.5, 0.0}, P{3.0, 2.0, 0.0, 0.75, 0.0}, P{4.0, 2.0, 0.0, 1.0, 0.0},
+                P{0.0, 1.0, 0.0, 0.0, 0.5}, P{1.0, 1.0, 0.0, 0.25, 0.5}, P{2.0, 1.0, 0.0, 0.5, 0.5}, P{3.0, 1.0, 0.0, 0.75, 0.5}, P{4.0, 1.0, 0.0, 1.0, 0.5},
+                P{0.0, 0.0, 0.0, 0.0, 1.0}, P{1.0, 0.0, 0.0, 0.25, 1.0}, P{2.0, 0.0, 0.0, 0.5, 1.0}, P{3.0, 0.0, 0.0, 0.75, 1.0}, P{4.0, 0.0, 0.0, 1.0, 1.0},
+            }, "texture"};
+
+            const auto curvedPatch = BezierPatch{3, 3, {
+                P{0.0, 0.0, 0.0}, P{1.0, 0.0, 1.0}, P{2.0, 0.0, 0.0},
+                P{0.0, 1.0, 1.0}, P{1.0, 1.0, 2.0}, P{2.0, 1.0, 1.0},
+                P{0.0, 2.0, 0.0}, P{1.0, 2.0, 1.0}, P{2.0, 2.0, 0.0},
+            }, "texture"};
+
+            SECTION("Flat patches are subdivided like curved patches") {
+                const auto patchNode = PatchNode{flatPatch};
+                CHECK(patchNode.grid().pointRowCount == 9u);
+                CHECK(patchNode.grid().pointColumnCount == 17u);
+                CHECK(patchNode.grid().points == makePatchGrid(flatPatch, 3u).points);
+            }
+
+            SECTION("Curved patches are subdivided") {
+                const auto patchNode = PatchNode{curvedPatch};
+                CHECK(patchNode.grid().pointRowCount == 9u);
+                CHECK(patchNode.grid().pointColumnCount == 9u);
+                CHECK(patchNode.grid().points == makePatchGrid(curvedPatch, 3u).points);
+            }
+
+            SECTION("Clones have the same grid") {
+                const auto worldBounds = vm::bbox3{8192.0};
+                const auto patchNode = PatchNode{curvedPatch};
+                const auto clone = std::unique_ptr<PatchNode>{static_cast<PatchNode*>(patchNode.clone(worldBounds))};
+                CHECK(clone->grid().points == patchNode.grid().points);
+            }
+
+            SECTION("Setting a patch updates the grid") {
+                auto patchNode = PatchNode{curvedPatch};
+
+                auto retexturedPatch = curvedPatch;
+                retexturedPatch.setTextureName("other");
+                patchNode.setPatch(retexturedPatch);
+                CHECK(patchNode.grid().points == makePatchGrid(curvedPatch, 3u).points);
+
+                patchNode.setPatch(flatPatch);
+                CHECK(patchNode.grid().pointColumnCount == 17u);
+                CHECK(patchNode.grid().points == makePatchGrid(flatPatch, 3u).points);
+            }
+        }
+
         TEST_CASE("PatchNode.pickFlatPatch") {
             using P = BezierPatch::Point;
             auto patchNode = PatchNode{BezierPatch{5, 5, {
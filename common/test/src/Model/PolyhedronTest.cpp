@@ -1304,6 +1304,97 @@ TEST_CASE("PolyhedronTest.testWeaveSimpleCap", "[PolyhedronTest]") {
             return false;
         }
 
+        TEST_CASE("PolyhedronTest.fromPlanesCube", "[PolyhedronTest]") {
+            const vm::bbox3d bounds(vm::vec3d(-64.0, -32.0, -16.0), vm::vec3d(64.0, 32.0, 16.0));
+            const std::vector<vm::plane3d> planes {
+                vm::plane3d(bounds.max, vm::vec3d::pos_x()),
+                vm::plane3d(bounds.min, vm::vec3d::neg_x()),
+                vm::plane3d(bounds.max, vm::vec3d::pos_y()),
+                vm::plane3d(bounds.min, vm::vec3d::neg_y()),
+                vm::plane3d(bounds.max, vm::vec3d::pos_z()),
+                vm::plane3d(bounds.min, vm::vec3d::neg_z()),
+            };
+
+            std::vector<PFace*> planeFaces;
+            const auto p = Polyhedron3d::fromPlanes(planes, planeFaces);
+            REQUIRE(p.has_value());
+            CHECK(*p == Polyhedron3d(bounds));
+            CHECK(p->bounds() == bounds);
+
+            REQUIRE(planeFaces.size() == planes.size());
+            for (size_t i = 0u; i < planes.size(); ++i) {
+                REQUIRE(planeFaces[i] != nullptr);
+                CHECK(planeFaces[i]->plane() == planes[i]);
+            }
+        }
+
+        TEST_CASE("PolyhedronTest.fromPlanesMatchesClip", "[PolyhedronTest]") {
+            // a cube with a corner cut off and a plane that only touches the cut
+            const std::vector<vm::plane3d> planes {
+                vm::plane3d(vm::vec3d(32.0, 32.0, 32.0), vm::vec3d::pos_x()),
+                vm::plane3d(vm::vec3d(0.0, 0.0, 0.0), vm::vec3d::neg_x()),
+                vm::plane3d(vm::vec3d(32.0, 32.0, 32.0), vm::vec3d::pos_y()),
+                vm::plane3d(vm::vec3d(0.0, 0.0, 0.0), vm::vec3d::neg_y()),
+                vm::plane3d(vm::vec3d(32.0, 32.0, 32.0), vm::vec3d::pos_z()),
+                vm::plane3d(vm::vec3d(0.0, 0.0, 0.0), vm::vec3d::neg_z()),
+                vm::plane3d(vm::vec3d(32.0, 32.0, 16.0), vm::normalize(vm::vec3d(1.0, 1.0, 1.0))),
+                vm::plane3d(vm::vec3d(32.0, 0.0, 0.0), vm::normalize(vm::vec3d(1.0, -1.0, -1.0))),
+            };
+
+            std::vector<PFace*> planeFaces;
+            const auto p = Polyhedron3d::fromPlanes(planes, planeFaces);
+            REQUIRE(p.has_value());
+
+            Polyhedron3d expected(vm::bbox3d(128.0));
+            for (const auto& plane : planes) {
+                expected.clip(plane);
+            }
+            expected.correctVertexPositions();
+
+            CHECK(*p == expected);
+            CHECK(p->vertexCount() == 10u);
+            CHECK(p->faceCount() == 7u);
+
+            REQUIRE(planeFaces.size() == planes.size());
+            CHECK(planeFaces[6] != nullptr);
+            CHECK(planeFaces[7] == nullptr);
+        }
+
+        TEST_CASE("PolyhedronTest.fromPlanesFails", "[PolyhedronTest]") {
+            std::vector<PFace*> planeFaces;
+
+            // open
+            CHECK_FALSE(Polyhedron3d::fromPlanes({
+                vm::plane3d(vm::vec3d(32.0, 32.0, 32.0), vm::vec3d::pos_x()),
+                vm::plane3d(vm::vec3d(0.0, 0.0, 0.0), vm::vec3d::neg_x()),
+                vm::plane3d(vm::vec3d(32.0, 32.0, 32.0), vm::vec3d::pos_y()),
+                vm::plane3d(vm::vec3d(0.0, 0.0, 0.0), vm::vec3d::neg_y()),
+                vm::plane3d(vm::vec3d(32.0, 32.0, 32.0), vm::vec3d::pos_z()),
+            }, planeFaces).has_value());
+
+            // empty
+            CHECK_FALSE(Polyhedron3d::fromPlanes({
+                vm::plane3d(vm::vec3d(32.0, 32.0, 32.0), vm::vec3d::pos_x()),
+                vm::plane3d(vm::vec3d(64.0, 0.0, 0.0), vm::vec3d::neg_x()),
+                vm::plane3d(vm::vec3d(32.0, 32.0, 32.0), vm::vec3d::pos_y()),
+                vm::plane3d(vm::vec3d(0.0, 0.0, 0.0), vm::vec3d::neg_y()),
+                vm::plane3d(vm::vec3d(32.0, 32.0, 32.0), vm::vec3d::pos_z()),
+                vm::plane3d(vm::vec3d(0.0, 0.0, 0.0), vm::vec3d::neg_z()),
+            }, planeFaces).has_value());
+
+            // non integer vertices
+            CHECK_FALSE(Polyhedron3d::fromPlanes({
+                vm::plane3d(vm::vec3d(32.5, 32.0, 32.0), vm::vec3d::pos_x()),
+                vm::plane3d(vm::vec3d(0.0, 0.0, 0.0), vm::vec3d::neg_x()),
+                vm::plane3d(vm::vec3d(32.0, 32.0, 32.0), vm::vec3d::pos_y()),
+                vm::plane3d(vm::vec3d(0.0, 0.0, 0.0), vm::vec3d::neg_y()),
+                vm::plane3d(vm::vec3d(32.0, 32.0, 32.0), vm::vec3d::pos_z()),
+                vm::plane3d(vm::vec3d(0.0, 0.0, 0.0), vm::vec3d::neg_z()),
+            }, planeFaces).has_value());
+
+            CHECK(planeFaces.empty());
+        }
+
         TEST_CASE("PolyhedronTest.subtractInnerCuboidFromCuboid", "[PolyhedronTest]") {
             const Polyhedron3d minuend(vm::bbox3d(32.0));
             const Polyhedron3d subtrahend(vm::bbox3d(16.0));
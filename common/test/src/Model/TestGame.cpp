@@ -81,6 +81,7 @@ namespace TrenchBroom {
 
         void TestGame::doSetAdditionalSearchPaths(const std::vector<IO::Path>& /* searchPaths */, Logger& /* logger */) {}
         Game::PathErrors TestGame::doCheckAdditionalSearchPaths(const std::vector<IO::Path>& /* searchPaths */) const { return PathErrors(); }
+        void TestGame::doInvalidateFileSystemCaches() {}
 
         const CompilationConfig& TestGame::doCompilationConfig() {
             static CompilationConfig config;
@@ -108,15 +109,18 @@ namespace TrenchBroom {
         }
 
         void TestGame::doWriteMap(WorldNode& world, const IO::Path& path) const {
-            const auto mapFormatName = formatName(world.mapFormat());
-
             std::ofstream file = openPathAsOutputStream(path);
             if (!file) {
                 throw FileSystemException("Cannot open file: " + path.asString());
             }
-            IO::writeGameComment(file, gameName(), mapFormatName);
+            doWriteMapToStream(world, file);
+        }
 
-            IO::NodeWriter writer(world, file);
+        void TestGame::doWriteMapToStream(WorldNode& world, std::ostream& stream) const {
+            const auto mapFormatName = formatName(world.mapFormat());
+            IO::writeGameComment(stream, gameName(), mapFormatName);
+
+            IO::NodeWriter writer(world, stream);
             writer.writeMap();
         }
 
@@ -54,6 +54,7 @@ namespace TrenchBroom {
             Game::SoftMapBounds doExtractSoftMapBounds(const Entity& entity) const override;
             void doSetAdditionalSearchPaths(const std::vector<IO::Path>& searchPaths, Logger& logger) override;
             PathErrors doCheckAdditionalSearchPaths(const std::vector<IO::Path>& searchPaths) const override;
+            void doInvalidateFileSystemCaches() override;
 
             const CompilationConfig& doCompilationConfig() override;
             size_t doMaxPropertyLength() const override;
@@ -63,6 +64,7 @@ namespace TrenchBroom {
             std::unique_ptr<WorldNode> doNewMap(MapFormat format, const vm::bbox3& worldBounds, Logger& logger) const override;
             std::unique_ptr<WorldNode> doLoadMap(MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, Logger& logger) const override;
             void doWriteMap(WorldNode& world, const IO::Path& path) const override;
+            void doWriteMapToStream(WorldNode& world, std::ostream& stream) const override;
             void doExportMap(WorldNode& world, Model::ExportFormat format, const IO::Path& path) const override;
 
             std::vector<Node*> doParseNodes(const std::string& str, MapFormat mapFormat, const vm::bbox3& worldBounds, Logger& logger) const override;
@@ -25,10 +25,14 @@
 #include "Model/EntityNode.h"
 #include "Model/Group.h"
 #include "Model/GroupNode.h"
+#include "Model/Hit.h"
+#include "Model/HitAdapter.h"
+#include "Model/HitQuery.h"
 #include "Model/Layer.h"
 #include "Model/LayerNode.h"
 #include "Model/MapFormat.h"
 #include "Model/PatchNode.h"
+#include "Model/PickResult.h"
 #include "Model/WorldNode.h"
 
 #include <kdl/result.h>
@@ -38,6 +42,7 @@
 #include <vecmath/mat.h>
 #include <vecmath/mat_ext.h>
 #include <vecmath/mat_io.h>
+#include <vecmath/ray.h>
 
 #include "TestUtils.h"
 #include "Catch2.h"
@@ -280,6 +285,48 @@ namespace TrenchBroom {
             CHECK(nodeTree.contains(patchNode));
         }
 
+        TEST_CASE("WorldNodeTest.pickClosest") {
+            constexpr auto worldBounds = vm::bbox3d{8192.0};
+            constexpr auto mapFormat = MapFormat::Quake3;
+
+            auto worldNode = WorldNode{Entity{}, mapFormat};
+            auto* nearBrushNode = new BrushNode{BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "texture").value()};
+            auto* farBrushNode = new BrushNode{BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "texture").value()};
+            transformNode(*farBrushNode, vm::translation_matrix(vm::vec3d(256, 0, 0)), worldBounds);
+
+            worldNode.defaultLayer()->addChild(nearBrushNode);
+            worldNode.defaultLayer()->addChild(farBrushNode);
+
+            const auto ray = vm::ray3{vm::vec3{-128, 0, 0}, vm::vec3::pos_x()};
+            const auto findHit = [](const PickResult& pickResult) -> const Hit& {
+                return pickResult.query().type(BrushNode::BrushHitType).first();
+            };
+
+            const auto pickClosestNode = [&]() -> Node* {
+                auto pickResult = PickResult{};
+                worldNode.pickClosest(ray, pickResult, findHit);
+                const auto& hit = findHit(pickResult);
+                return hit.isMatch() ? hitToNode(hit) : nullptr;
+            };
+
+            // the first query after a change uses the node tree, the second one uses the flat node tree
+            CHECK(pickClosestNode() == nearBrushNode);
+            CHECK(pickClosestNode() == nearBrushNode);
+
+            transformNode(*nearBrushNode, vm::translation_matrix(vm::vec3d(0, 256, 0)), worldBounds);
+            CHECK(pickClosestNode() == farBrushNode);
+            CHECK(pickClosestNode() == farBrushNode);
+
+            transformNode(*nearBrushNode, vm::translation_matrix(vm::vec3d(0, -256, 0)), worldBounds);
+            CHECK(pickClosestNode() == nearBrushNode);
+            CHECK(pickClosestNode() == nearBrushNode);
+
+            worldNode.defaultLayer()->removeChild(nearBrushNode);
+            delete nearBrushNode;
+            CHECK(pickClosestNode() == farBrushNode);
+            CHECK(pickClosestNode() == farBrushNode);
+        }
+
         TEST_CASE("WorldNodeTest.persistentIdOfDefaultLayer", "[WorldNodeTest]") {
             auto worldNode = WorldNode{Entity{}, MapFormat::Standard};
             CHECK(worldNode.defaultLayer()->persistentId() == std::nullopt);
@@ -0,0 +1,91 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/Entity.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/WorldNode.h"
+#include "Renderer/BrushCuller.h"
+#include "Renderer/PerspectiveCamera.h"
+
+#include <kdl/result.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
+#include <vecmath/vec.h>
+
+#include <vector>
+
+#include "TestUtils.h"
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace Renderer {
+        TEST_CASE("BrushCullerTest.cullForMultipleViews", "[BrushCullerTest]") {
+            constexpr auto worldBounds = vm::bbox3d{8192.0};
+            constexpr auto mapFormat = Model::MapFormat::Quake3;
+
+            auto worldNode = Model::WorldNode{Model::Entity{}, mapFormat};
+            auto* eastBrushNode = new Model::BrushNode{Model::BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "texture").value()};
+            auto* westBrushNode = new Model::BrushNode{Model::BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "texture").value()};
+            Model::transformNode(*eastBrushNode, vm::translation_matrix(vm::vec3d(512, 0, 0)), worldBounds);
+            Model::transformNode(*westBrushNode, vm::translation_matrix(vm::vec3d(-512, 0, 0)), worldBounds);
+            worldNode.defaultLayer()->addChild(eastBrushNode);
+            worldNode.defaultLayer()->addChild(westBrushNode);
+
+            // two views looking in opposite directions, as in a multi pane layout
+            const auto viewport = Camera::Viewport{0, 0, 800, 600};
+            auto eastCamera = PerspectiveCamera{90.0f, 1.0f, 8192.0f, viewport, vm::vec3f::zero(), vm::vec3f::pos_x(), vm::vec3f::pos_z()};
+            auto westCamera = PerspectiveCamera{90.0f, 1.0f, 8192.0f, viewport, vm::vec3f::zero(), vm::vec3f::neg_x(), vm::vec3f::pos_z()};
+
+            using BrushList = BrushCuller::BrushList;
+
+            auto culler = BrushCuller{};
+            const auto eastBrushes = culler.cull(worldNode, eastCamera);
+            const auto westBrushes = culler.cull(worldNode, westCamera);
+            CHECK(*eastBrushes == BrushList{eastBrushNode});
+            CHECK(*westBrushes == BrushList{westBrushNode});
+
+            // rendering the views alternately reuses the result for each camera
+            CHECK(culler.cull(worldNode, eastCamera) == eastBrushes);
+            CHECK(culler.cull(worldNode, westCamera) == westBrushes);
+            CHECK(culler.cull(worldNode, eastCamera) == eastBrushes);
+
+            // moving one camera only affects its own result
+            westCamera.setDirection(vm::vec3f::pos_x(), vm::vec3f::pos_z());
+            const auto movedWestBrushes = culler.cull(worldNode, westCamera);
+            CHECK(movedWestBrushes != westBrushes);
+            CHECK(*movedWestBrushes == BrushList{eastBrushNode});
+            CHECK(culler.cull(worldNode, eastCamera) == eastBrushes);
+
+            // changing the node tree invalidates the results for all cameras
+            Model::transformNode(*westBrushNode, vm::translation_matrix(vm::vec3d(1024, 0, 0)), worldBounds);
+            const auto updatedEastBrushes = culler.cull(worldNode, eastCamera);
+            CHECK(updatedEastBrushes != eastBrushes);
+            CHECK_THAT(*updatedEastBrushes, Catch::UnorderedEquals(BrushList{eastBrushNode, westBrushNode}));
+            CHECK(culler.cull(worldNode, westCamera) != movedWestBrushes);
+
+            culler.clear();
+            CHECK(culler.cull(worldNode, eastCamera) != updatedEastBrushes);
+        }
+    }
+}
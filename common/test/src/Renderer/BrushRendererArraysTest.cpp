@@ -0,0 +1,91 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/BrushRendererArrays.h"
+
+#include <stdexcept>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace Renderer {
+        using Range = DirtyRangeTracker::Range;
+
+        TEST_CASE("DirtyRangeTrackerTest.constructor", "[DirtyRangeTrackerTest]") {
+            DirtyRangeTracker t(100);
+            CHECK(t.capacity() == 100u);
+            CHECK(t.clean());
+            CHECK(t.dirtySize() == 0u);
+            CHECK(t.dirtyRanges() == (std::vector<Range>{}));
+        }
+
+        TEST_CASE("DirtyRangeTrackerTest.markDirty", "[DirtyRangeTrackerTest]") {
+            DirtyRangeTracker t(100);
+
+            t.markDirty(10, 5);
+            t.markDirty(30, 5);
+            CHECK_FALSE(t.clean());
+            CHECK(t.dirtySize() == 10u);
+            CHECK(t.dirtyRanges() == (std::vector<Range>{{10, 5}, {30, 5}}));
+
+            // adjacent ranges are merged
+            t.markDirty(15, 2);
+            CHECK(t.dirtySize() == 12u);
+            CHECK(t.dirtyRanges() == (std::vector<Range>{{10, 7}, {30, 5}}));
+
+            // overlapping ranges are merged
+            t.markDirty(5, 30);
+            CHECK(t.dirtySize() == 30u);
+            CHECK(t.dirtyRanges() == (std::vector<Range>{{5, 30}}));
+
+            // empty ranges are ignored
+            t.markDirty(50, 0);
+            CHECK(t.dirtyRanges() == (std::vector<Range>{{5, 30}}));
+
+            CHECK_THROWS_AS(t.markDirty(90, 11), std::invalid_argument);
+        }
+
+        TEST_CASE("DirtyRangeTrackerTest.dirtyRangesWithGap", "[DirtyRangeTrackerTest]") {
+            DirtyRangeTracker t(100);
+            t.markDirty(5, 30);
+            t.markDirty(40, 1);
+            t.markDirty(50, 1);
+
+            CHECK(t.dirtyRanges(4) == (std::vector<Range>{{5, 30}, {40, 1}, {50, 1}}));
+            CHECK(t.dirtyRanges(5) == (std::vector<Range>{{5, 36}, {50, 1}}));
+            CHECK(t.dirtyRanges(9) == (std::vector<Range>{{5, 46}}));
+
+            // merging ranges for uploading does not change the dirty size
+            CHECK(t.dirtySize() == 32u);
+        }
+
+        TEST_CASE("DirtyRangeTrackerTest.expand", "[DirtyRangeTrackerTest]") {
+            DirtyRangeTracker t(100);
+            t.markDirty(98, 2);
+
+            t.expand(200);
+            CHECK(t.capacity() == 200u);
+            CHECK(t.dirtySize() == 102u);
+            CHECK(t.dirtyRanges() == (std::vector<Range>{{98, 102}}));
+
+            CHECK_THROWS_AS(t.expand(200), std::invalid_argument);
+        }
+    }
+}
@@ -18,14 +18,23 @@
  */
 
 #include "Logger.h"
+#include "IO/IOUtils.h"
 #include "IO/Path.h"
 #include "IO/TestEnvironment.h"
 #include "Model/BrushNode.h"
+#include "Model/Group.h"
+#include "Model/GroupNode.h"
+#include "Model/Layer.h"
 #include "Model/LayerNode.h"
+#include "Model/WorldNode.h"
 #include "View/Autosaver.h"
 #include "View/MapDocumentTest.h"
 
 #include <chrono>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
 #include <thread>
 
 #include "TestUtils.h"
@@ -61,6 +70,7 @@ namespace TrenchBroom {
             addNode(*document, document->currentLayer(), createBrushNode("some_texture"));
 
             autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingBackup(logger);
 
             CHECK_FALSE(env.fileExists(IO::Path("autosave/test.1.map")));
             CHECK_FALSE(env.directoryExists(IO::Path("autosave")));
@@ -77,6 +87,7 @@ namespace TrenchBroom {
 
             Autosaver autosaver(document, 0s);
             autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingBackup(logger);
 
             CHECK_FALSE(env.fileExists(IO::Path("autosave/test.1.map")));
             CHECK_FALSE(env.directoryExists(IO::Path("autosave")));
@@ -101,6 +112,7 @@ namespace TrenchBroom {
             std::this_thread::sleep_for(100ms);
 
             autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingBackup(logger);
 
             CHECK(env.fileExists(IO::Path("autosave/test.1.map")));
             CHECK(env.directoryExists(IO::Path("autosave")));
@@ -125,6 +137,7 @@ namespace TrenchBroom {
             std::this_thread::sleep_for(100ms);
 
             autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingBackup(logger);
 
             CHECK(env.fileExists(IO::Path("autosave/test.1.map")));
             CHECK(env.directoryExists(IO::Path("autosave")));
@@ -134,12 +147,14 @@ namespace TrenchBroom {
             std::this_thread::sleep_for(100ms);
 
             autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingBackup(logger);
             CHECK_FALSE(env.fileExists(IO::Path("autosave/test.2.map")));
 
             // modify the map
             addNode(*document, document->currentLayer(), createBrushNode("some_texture"));
 
             autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingBackup(logger);
             CHECK(env.fileExists(IO::Path("autosave/test.2.map")));
         }
 
@@ -165,8 +180,43 @@ namespace TrenchBroom {
             addNode(*document, document->currentLayer(), createBrushNode("some_texture"));
 
             autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingBackup(logger);
 
             CHECK(env.fileExists(IO::Path("autosave/test.2.map")));
         }
+   
+        TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverWritesSnapshotOfDocument") {
+            using namespace std::literals::chrono_literals;
+
+            IO::TestEnvironment env("autosaver_test");
+            NullLogger logger;
+
+            document->saveDocumentAs(env.dir() + IO::Path("test.map"));
+            assert(env.fileExists(IO::Path("test.map")));
+
+            Autosaver autosaver(document, 0s);
+
+            // modify the map so that the backup contains layers and groups with persistent IDs
+            auto* layerNode = new Model::LayerNode(Model::Layer("layer"));
+            addNode(*document, document->world(), layerNode);
+
+            auto* groupNode = new Model::GroupNode(Model::Group("group"));
+            addNode(*document, layerNode, groupNode);
+            addNode(*document, groupNode, createBrushNode("some_texture"));
+            addNode(*document, document->currentLayer(), createBrushNode("other_texture"));
+
+            autosaver.triggerAutosave(logger);
+            autosaver.waitForPendingBackup(logger);
+
+            REQUIRE(env.fileExists(IO::Path("autosave/test.1.map")));
+
+            auto expected = std::stringstream{};
+            document->saveDocumentToStream(expected);
+
+            auto backupStream = IO::openPathAsInputStream(env.dir() + IO::Path("autosave/test.1.map"));
+            const auto backup = std::string{std::istreambuf_iterator<char>{backupStream}, std::istreambuf_iterator<char>{}};
+
+            CHECK(backup == expected.str());
+        }
     }
 }
@@ -106,6 +106,8 @@ namespace TrenchBroom {
         class TestCommand : public UndoableCommand {
         private:
             mutable std::vector<TestCommandCall> m_expectedCalls;
+            size_t m_memorySize = 0u;
+            size_t m_compactedMemorySize = 0u;
         public:
             static const CommandType Type;
 
@@ -146,7 +148,22 @@ namespace TrenchBroom {
                 return expectedCall.returnCanCollate;
             }
 
+            size_t doGetMemorySize() const override {
+                return m_memorySize;
+            }
+
+            void doCompact(MapDocumentCommandFacade*) override {
+                m_memorySize = m_compactedMemorySize;
+            }
         public:
+            /**
+             * Sets the memory size reported by this command before and after it is compacted.
+             */
+            void setMemorySize(const size_t memorySize, const size_t compactedMemorySize) {
+                m_memorySize = memorySize;
+                m_compactedMemorySize = compactedMemorySize;
+            }
+
             /**
              * Sets an expectation that doPerformDo() should be called.
              * When called, it will return the given `returnSuccess` value.
@@ -582,5 +599,93 @@ namespace TrenchBroom {
             REQUIRE(commandProcessor.undoCommandName() == commandName1);
             REQUIRE(commandProcessor.redoCommandName() == commandName2);
         }
+
+        TEST_CASE("CommandProcessorTest.undoMemoryBudget", "[CommandProcessorTest]") {
+            /*
+             * Execute three commands whose memory exceeds the undo memory budget. The oldest commands are dropped from
+             * the undo stack, but the most recent command is always kept.
+             */
+
+            CommandProcessor commandProcessor(nullptr, std::chrono::milliseconds(1000), 100u);
+
+            const auto commandName1 = "test command 1";
+            auto command1 = TestCommand::create(commandName1);
+            command1->setMemorySize(40u, 40u);
+
+            const auto commandName2 = "test command 2";
+            auto command2 = TestCommand::create(commandName2);
+            command2->setMemorySize(40u, 40u);
+
+            const auto commandName3 = "test command 3";
+            auto command3 = TestCommand::create(commandName3);
+            command3->setMemorySize(200u, 200u);
+
+            command1->expectDo(true);
+            command1->expectCollate(command2.get(), false);
+            command2->expectDo(true);
+            command2->expectCollate(command3.get(), false);
+            command3->expectDo(true);
+            command3->expectUndo(true);
+
+            commandProcessor.executeAndStore(std::move(command1));
+            commandProcessor.executeAndStore(std::move(command2));
+            REQUIRE(commandProcessor.undoCommandName() == commandName2);
+
+            commandProcessor.executeAndStore(std::move(command3));
+            REQUIRE(commandProcessor.undoCommandName() == commandName3);
+
+            CHECK(commandProcessor.undo()->success());
+            CHECK_FALSE(commandProcessor.canUndo());
+        }
+
+        TEST_CASE("CommandProcessorTest.compactCommands", "[CommandProcessorTest]") {
+            /*
+             * Execute three commands and undo them. Only the commands which are no longer the most recent command on
+             * the undo or redo stack are compacted, so that all commands fit into the undo memory budget.
+             */
+
+            CommandProcessor commandProcessor(nullptr, std::chrono::milliseconds(1000), 100u);
+
+            const auto commandName1 = "test command 1";
+            auto command1 = TestCommand::create(commandName1);
+            command1->setMemorySize(40u, 10u);
+            auto* command1Ptr = command1.get();
+
+            const auto commandName2 = "test command 2";
+            auto command2 = TestCommand::create(commandName2);
+            command2->setMemorySize(40u, 10u);
+            auto* command2Ptr = command2.get();
+
+            const auto commandName3 = "test command 3";
+            auto command3 = TestCommand::create(commandName3);
+            command3->setMemorySize(60u, 10u);
+            auto* command3Ptr = command3.get();
+
+            command1->expectDo(true);
+            command1->expectCollate(command2.get(), false);
+            command2->expectDo(true);
+            command2->expectCollate(command3.get(), false);
+            command3->expectDo(true);
+            command3->expectUndo(true);
+            command2->expectUndo(true);
+            command1->expectUndo(true);
+
+            commandProcessor.executeAndStore(std::move(command1));
+            CHECK(command1Ptr->memorySize() == 40u);
+
+            commandProcessor.executeAndStore(std::move(command2));
+            CHECK(command1Ptr->memorySize() == 10u);
+            CHECK(command2Ptr->memorySize() == 40u);
+
+            commandProcessor.executeAndStore(std::move(command3));
+            CHECK(command2Ptr->memorySize() == 10u);
+            CHECK(command3Ptr->memorySize() == 60u);
+
+            CHECK(commandProcessor.undo()->success());
+            CHECK(commandProcessor.undo()->success());
+            CHECK(command3Ptr->memorySize() == 10u);
+            CHECK(commandProcessor.undo()->success());
+            CHECK_FALSE(commandProcessor.canUndo());
+        }
     }
 }
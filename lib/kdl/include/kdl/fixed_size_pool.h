@@ -0,0 +1,205 @@
+/*
+ Copyright 2021 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace kdl {
+    /**
+     * Allocates memory blocks of a fixed size and alignment. Meant to be used to implement class specific operator new
+     * and operator delete for small objects which are created and destroyed in large numbers.
+     *
+     * Blocks are carved out of large chunks of memory. Every thread keeps its own list of free blocks, so allocating
+     * and freeing a block does not require any synchronization unless the calling thread's free list is empty or has
+     * grown too long. In that case, a batch of blocks is exchanged with a list of batches that is shared by all threads.
+     * This way, blocks that are freed by a different thread than the one that allocated them, e.g. when objects are
+     * created on worker threads and destroyed on the main thread, are eventually reused. The shared list is linked
+     * through the free blocks themselves, so freeing a block never allocates memory.
+     *
+     * Chunks are never returned to the system, so the pool retains the memory for the largest number of blocks that
+     * were in use at any point in time.
+     *
+     * All pools with the same size and alignment share their blocks.
+     *
+     * @tparam Size the size of the blocks
+     * @tparam Align the alignment of the blocks
+     */
+    template <std::size_t Size, std::size_t Align>
+    class fixed_size_pool {
+    private:
+        struct free_block {
+            free_block* next;
+            // only used by the first block of a batch in the shared list of batches
+            free_block* next_batch;
+            std::size_t count;
+        };
+
+        static constexpr std::size_t block_align = std::max(Align, alignof(free_block));
+        static constexpr std::size_t block_size = (std::max(Size, sizeof(free_block)) + block_align - 1u) / block_align * block_align;
+        static constexpr std::size_t blocks_per_batch = std::max(std::size_t(16), std::size_t(16384) / block_size);
+
+        struct shared_state {
+            std::mutex mutex;
+            free_block* batches = nullptr;
+            std::vector<void*> chunks;
+        };
+
+        /**
+         * Trivially destructible so that it can still be inspected after the thread's local state was released.
+         */
+        struct local_state {
+            free_block* first = nullptr;
+            std::size_t count = 0u;
+            bool released = false;
+        };
+
+        /**
+         * Hands the blocks of the thread's free list over to the shared list when the thread ends. Blocks that are
+         * allocated or freed by this thread afterwards, e.g. by the destructors of other thread local objects, are
+         * taken from and returned to the shared list directly.
+         */
+        struct local_state_releaser {
+            local_state& local;
+
+            ~local_state_releaser() {
+                if (local.count > 0u) {
+                    push_batch(local.first, local.count);
+                }
+                local = local_state{nullptr, 0u, true};
+            }
+        };
+    public:
+        /**
+         * Returns an uninitialized block of memory of at least `Size` bytes that is aligned to `Align`.
+         *
+         * @throws std::bad_alloc if a new chunk of memory is required, but cannot be allocated
+         */
+        static void* allocate() {
+            if (local_state* local = local_list()) {
+                if (local->first == nullptr) {
+                    refill(*local);
+                }
+                return pop_block(*local);
+            }
+
+            auto batch = local_state{};
+            refill(batch);
+            void* block = pop_block(batch);
+            if (batch.count > 0u) {
+                push_batch(batch.first, batch.count);
+            }
+            return block;
+        }
+
+        /**
+         * Returns the given block to the pool. The given pointer must have been returned by `allocate` and must not
+         * have been passed to this function since.
+         *
+         * @param ptr the block to free
+         */
+        static void deallocate(void* ptr) noexcept {
+            auto* block = new (ptr) free_block{nullptr, nullptr, 0u};
+
+            local_state* local = local_list();
+            if (local == nullptr) {
+                push_batch(block, 1u);
+                return;
+            }
+
+            block->next = local->first;
+            local->first = block;
+            ++local->count;
+
+            if (local->count >= 2u * blocks_per_batch) {
+                // hand a batch over to the other threads
+                free_block* first = local->first;
+                free_block* last = first;
+                for (std::size_t i = 1u; i < blocks_per_batch; ++i) {
+                    last = last->next;
+                }
+                local->first = last->next;
+                local->count -= blocks_per_batch;
+                last->next = nullptr;
+
+                push_batch(first, blocks_per_batch);
+            }
+        }
+    private:
+        static shared_state& shared() {
+            // never destroyed, so that blocks can still be freed during static destruction
+            static auto* state = new shared_state();
+            return *state;
+        }
+
+        /**
+         * Returns the calling thread's free list, or null if it was already released because the thread is ending.
+         */
+        static local_state* local_list() {
+            static thread_local local_state state;
+            if (state.released) {
+                return nullptr;
+            }
+
+            static thread_local local_state_releaser releaser{state};
+            return &releaser.local;
+        }
+
+        static void* pop_block(local_state& local) {
+            free_block* block = local.first;
+            local.first = block->next;
+            --local.count;
+            return block;
+        }
+
+        /**
+         * Adds the given list of blocks to the shared list of batches. The batch is linked through its first block, so
+         * this does not allocate.
+         */
+        static void push_batch(free_block* first, const std::size_t count) noexcept {
+            std::lock_guard<std::mutex> lock(shared().mutex);
+            first->next_batch = shared().batches;
+            first->count = count;
+            shared().batches = first;
+        }
+
+        static void refill(local_state& local) {
+            std::lock_guard<std::mutex> lock(shared().mutex);
+            if (free_block* first = shared().batches) {
+                shared().batches = first->next_batch;
+                local.first = first;
+                local.count = first->count;
+                return;
+            }
+
+            shared().chunks.reserve(shared().chunks.size() + 1u);
+            auto* chunk = static_cast<char*>(::operator new(block_size * blocks_per_batch, std::align_val_t(block_align)));
+            shared().chunks.push_back(chunk);
+
+            free_block* first = nullptr;
+            for (std::size_t i = blocks_per_batch; i > 0u; --i) {
+                first = new (chunk + (i - 1u) * block_size) free_block{first, nullptr, 0u};
+            }
+            local.first = first;
+            local.count = blocks_per_batch;
+        }
+    };
+}
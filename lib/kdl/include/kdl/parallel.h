@@ -18,9 +18,12 @@
 #ifndef KDL_PARALLEL_H
 #define KDL_PARALLEL_H
 
+#include <kdl/thread_pool.h>
+
+#include <algorithm>
 #include <atomic>
-#include <future> // for std::async
-#include <thread>
+#include <exception>
+#include <mutex>
 #include <utility> // for std::declval
 #include <vector>
 
@@ -28,52 +31,84 @@ namespace kdl {
     /**
      * Runs the given lambda `count` times, passing it indices `0` through `count - 1`.
      *
-     * Lambda is executed in parallel, using the number of threads returned by std::thread::hardware_concurrency().
+     * The index range is split into chunks of at least `min_chunk_size` indices, and the chunks are submitted to the
+     * given thread pool. The calling thread takes part in executing the chunks until all of them have finished, so
+     * it is safe to call this function from a task running on the same pool.
      *
-     * Because the threads are spawned with std::async(std::launch::async, ...) and no thread pool is used,
-     * there is a relatively large overhead and this should only be used on large/slow to process data sets.
+     * If the lambda throws an exception, the remaining chunks are still executed, and the first exception is
+     * rethrown on the calling thread once all chunks have finished.
      *
      * @tparam L type of lambda
+     * @param pool the thread pool to run the lambda on
      * @param count the maximum value (exclusive) to pass to lambda
      * @param lambda the lambda to run
+     * @param min_chunk_size the minimum number of indices to pass to lambda in one task
      */
     template<class L>
-    void parallel_for(const size_t count, L&& lambda) {
-        size_t numThreads = static_cast<size_t>(std::thread::hardware_concurrency());
-        if (numThreads == 0) {
-            numThreads = 1;
+    void parallel_for(thread_pool& pool, const size_t count, L&& lambda, const size_t min_chunk_size = 1u) {
+        // split into a few more chunks than there are threads so that threads which finish early can steal work
+        constexpr size_t chunks_per_thread = 4u;
+        const size_t max_chunk_count = (pool.thread_count() + 1u) * chunks_per_thread;
+        const size_t chunk_count = std::min(max_chunk_count, count / std::max(min_chunk_size, size_t(1u)));
+
+        if (chunk_count <= 1u) {
+            for (size_t i = 0; i < count; ++i) {
+                lambda(i);
+            }
+            return;
         }
 
-        std::atomic<size_t> nextIndex(0);
+        const size_t chunk_size = (count + chunk_count - 1u) / chunk_count;
 
-        std::vector<std::future<void>> threads;
-        threads.resize(numThreads);
+        std::atomic<size_t> remaining(chunk_count);
+        std::exception_ptr exception;
+        std::mutex exception_mutex;
 
-        for (size_t i = 0; i < numThreads; ++i) {
-            threads[i] = std::async(std::launch::async, [&]() {
-                while (true) {
-                    const size_t ourIndex = std::atomic_fetch_add(&nextIndex, static_cast<size_t>(1));
-                    if (ourIndex >= count) {
-                        break;
+        for (size_t c = 0; c < chunk_count; ++c) {
+            const size_t first = c * chunk_size;
+            const size_t last = std::min(first + chunk_size, count);
+            pool.submit([&, first, last]() {
+                try {
+                    for (size_t i = first; i < last; ++i) {
+                        lambda(i);
+                    }
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(exception_mutex);
+                    if (!exception) {
+                        exception = std::current_exception();
                     }
-                    lambda(ourIndex);
                 }
+                --remaining;
             });
         }
 
-        for (size_t i = 0; i < numThreads; ++i) {
-            threads[i].wait();
+        pool.wait_until_zero(remaining);
+
+        if (exception) {
+            std::rethrow_exception(exception);
         }
     }
 
+    /**
+     * Runs the given lambda `count` times, passing it indices `0` through `count - 1`.
+     *
+     * Lambda is executed in parallel on the process wide thread pool returned by `default_thread_pool()`. Since the
+     * pool's threads are reused, this is also worthwhile for data sets of moderate size.
+     *
+     * @tparam L type of lambda
+     * @param count the maximum value (exclusive) to pass to lambda
+     * @param lambda the lambda to run
+     */
+    template<class L>
+    void parallel_for(const size_t count, L&& lambda) {
+        parallel_for(default_thread_pool(), count, std::forward<L>(lambda));
+    }
+
     /**
      * Applies the given lambda to each element of the input (passing elements as rvalue references),
      * and returns a vector of the resulting values, in their original order.
      * 
-     * The lambda is executed in parallel, using the number of threads returned by std::thread::hardware_concurrency().
-     * 
-     * Because the threads are spawned with std::async(std::launch::async, ...) and no thread pool is used,
-     * there is a relatively large overhead and this should only be used on large/slow to process data sets.
+     * The lambda is executed in parallel on the process wide thread pool returned by `default_thread_pool()`.
      *
      * @tparam T the type of the vector elements
      * @tparam L the type of the lambda to apply
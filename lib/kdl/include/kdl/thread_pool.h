@@ -0,0 +1,253 @@
+/*
+ Copyright 2021 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace kdl {
+    /**
+     * A fixed number of worker threads which execute submitted tasks.
+     *
+     * Every worker owns a task queue. Tasks submitted from a worker thread are pushed onto that worker's queue, and
+     * tasks submitted from any other thread are distributed among the queues in a round robin fashion. A worker takes
+     * tasks from the back of its own queue, and if that is empty, it steals tasks from the front of the other queues.
+     *
+     * A thread that must wait for some tasks to finish should call `run_pending_task` in a loop instead of blocking.
+     * This way, the waiting thread contributes to the work, and tasks can submit and wait for nested tasks without
+     * deadlocking the pool.
+     */
+    class thread_pool {
+    private:
+        struct task_queue {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        struct worker_context {
+            const thread_pool* pool = nullptr;
+            size_t index = 0;
+        };
+
+        std::vector<std::unique_ptr<task_queue>> m_queues;
+        std::vector<std::thread> m_threads;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::atomic<size_t> m_queued_count;
+        std::atomic<size_t> m_next_queue;
+        bool m_stop;
+    public:
+        /**
+         * Creates a thread pool with the given number of worker threads. If the given number is 0, all submitted
+         * tasks are executed immediately on the submitting thread.
+         *
+         * @param thread_count the number of worker threads
+         */
+        explicit thread_pool(const size_t thread_count) :
+        m_queued_count(0u),
+        m_next_queue(0u),
+        m_stop(false) {
+            m_queues.reserve(thread_count);
+            for (size_t i = 0; i < thread_count; ++i) {
+                m_queues.push_back(std::make_unique<task_queue>());
+            }
+
+            m_threads.reserve(thread_count);
+            for (size_t i = 0; i < thread_count; ++i) {
+                m_threads.emplace_back([this, i]() { run_worker(i); });
+            }
+        }
+
+        /**
+         * Executes all remaining tasks and joins the worker threads.
+         */
+        ~thread_pool() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_condition.notify_all();
+
+            for (auto& thread : m_threads) {
+                thread.join();
+            }
+        }
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool(thread_pool&&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+        thread_pool& operator=(thread_pool&&) = delete;
+
+        /**
+         * Returns the number of worker threads in this pool.
+         */
+        size_t thread_count() const {
+            return m_threads.size();
+        }
+
+        /**
+         * Returns the number of worker threads to use for the default pool. Since threads waiting for tasks take part
+         * in executing them, this is one less than the number of hardware threads, but no more than
+         * `max_default_thread_count`.
+         */
+        static size_t default_thread_count() {
+            constexpr size_t max_default_thread_count = 32u;
+
+            const auto hardware_thread_count = static_cast<size_t>(std::thread::hardware_concurrency());
+            if (hardware_thread_count <= 1u) {
+                return 0u;
+            }
+            return std::min(hardware_thread_count - 1u, max_default_thread_count);
+        }
+
+        /**
+         * Submits the given task for execution by a worker thread. The task must not throw an exception.
+         *
+         * @param task the task to submit
+         */
+        void submit(std::function<void()> task) {
+            if (m_queues.empty()) {
+                task();
+                return;
+            }
+
+            const worker_context& context = current_worker();
+            const size_t index = context.pool == this
+                ? context.index
+                : m_next_queue.fetch_add(1u) % m_queues.size();
+
+            {
+                task_queue& queue = *m_queues[index];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                queue.tasks.push_back(std::move(task));
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                ++m_queued_count;
+            }
+            m_condition.notify_one();
+        }
+
+        /**
+         * Takes one pending task out of the queues and executes it on the calling thread.
+         *
+         * @return true if a task was executed and false if no task was pending
+         */
+        bool run_pending_task() {
+            std::function<void()> task;
+            if (!pop_task(task)) {
+                return false;
+            }
+
+            task();
+            return true;
+        }
+
+        /**
+         * Executes pending tasks on the calling thread until the given counter drops to 0.
+         *
+         * @param counter the counter to wait for
+         */
+        void wait_until_zero(const std::atomic<size_t>& counter) {
+            while (counter.load() > 0u) {
+                if (!run_pending_task()) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    private:
+        static worker_context& current_worker() {
+            static thread_local worker_context context;
+            return context;
+        }
+
+        void run_worker(const size_t index) {
+            current_worker() = worker_context{this, index};
+
+            while (true) {
+                if (run_pending_task()) {
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [&]() { return m_stop || m_queued_count.load() > 0u; });
+                if (m_stop && m_queued_count.load() == 0u) {
+                    return;
+                }
+            }
+        }
+
+        bool pop_task(std::function<void()>& task) {
+            const size_t queue_count = m_queues.size();
+            if (queue_count == 0u) {
+                return false;
+            }
+
+            const worker_context& context = current_worker();
+            const bool is_worker = context.pool == this;
+            const size_t first = is_worker ? context.index : m_next_queue.load() % queue_count;
+
+            if (is_worker && pop_task(*m_queues[first], task, false)) {
+                return true;
+            }
+
+            for (size_t i = is_worker ? 1u : 0u; i < queue_count; ++i) {
+                if (pop_task(*m_queues[(first + i) % queue_count], task, true)) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        bool pop_task(task_queue& queue, std::function<void()>& task, const bool steal) {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty()) {
+                return false;
+            }
+
+            if (steal) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            } else {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+            --m_queued_count;
+            return true;
+        }
+    };
+
+    /**
+     * Returns the process wide thread pool that is used by the functions in parallel.h. The pool is created on first
+     * use with `thread_pool::default_thread_count()` worker threads.
+     */
+    inline thread_pool& default_thread_pool() {
+        static thread_pool pool(thread_pool::default_thread_count());
+        return pool;
+    }
+}
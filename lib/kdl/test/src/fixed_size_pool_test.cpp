@@ -0,0 +1,129 @@
+/*
+ Copyright 2021 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kdl/fixed_size_pool.h"
+
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace kdl {
+    TEST_CASE("fixed_size_pool_test.allocate", "[fixed_size_pool_test]") {
+        using pool = fixed_size_pool<24u, 8u>;
+
+        std::vector<void*> blocks;
+        for (std::size_t i = 0; i < 1000u; ++i) {
+            void* block = pool::allocate();
+            CHECK(reinterpret_cast<std::uintptr_t>(block) % 8u == 0u);
+            std::memset(block, static_cast<int>(i % 256u), 24u);
+            blocks.push_back(block);
+        }
+
+        // all blocks are distinct and do not overlap
+        const auto distinct = std::set<void*>(std::begin(blocks), std::end(blocks));
+        CHECK(distinct.size() == blocks.size());
+        for (std::size_t i = 0; i < blocks.size(); ++i) {
+            const auto* bytes = static_cast<const unsigned char*>(blocks[i]);
+            for (std::size_t j = 0; j < 24u; ++j) {
+                CHECK(bytes[j] == static_cast<unsigned char>(i % 256u));
+            }
+        }
+
+        for (void* block : blocks) {
+            pool::deallocate(block);
+        }
+    }
+
+    TEST_CASE("fixed_size_pool_test.reuse", "[fixed_size_pool_test]") {
+        using pool = fixed_size_pool<40u, 8u>;
+
+        void* block = pool::allocate();
+        pool::deallocate(block);
+        CHECK(pool::allocate() == block);
+        pool::deallocate(block);
+    }
+
+    TEST_CASE("fixed_size_pool_test.alignment", "[fixed_size_pool_test]") {
+        using pool = fixed_size_pool<8u, 64u>;
+
+        std::vector<void*> blocks;
+        for (std::size_t i = 0; i < 100u; ++i) {
+            blocks.push_back(pool::allocate());
+            CHECK(reinterpret_cast<std::uintptr_t>(blocks.back()) % 64u == 0u);
+        }
+        for (void* block : blocks) {
+            pool::deallocate(block);
+        }
+    }
+
+    TEST_CASE("fixed_size_pool_test.deallocate_on_other_thread", "[fixed_size_pool_test]") {
+        using pool = fixed_size_pool<32u, 16u>;
+
+        std::vector<void*> blocks;
+        for (std::size_t i = 0; i < 10000u; ++i) {
+            blocks.push_back(pool::allocate());
+        }
+
+        // the other thread's free list is handed over to the shared list when the thread ends
+        std::thread([&]() {
+            for (void* block : blocks) {
+                pool::deallocate(block);
+            }
+        }).join();
+
+        // apart from the blocks left in this thread's free list, the freed blocks are reused
+        const auto freed = std::set<void*>(std::begin(blocks), std::end(blocks));
+        std::size_t reused = 0u;
+        for (std::size_t i = 0; i < blocks.size(); ++i) {
+            blocks[i] = pool::allocate();
+            reused += freed.count(blocks[i]);
+        }
+        CHECK(reused > 9000u);
+
+        for (void* block : blocks) {
+            pool::deallocate(block);
+        }
+    }
+
+    TEST_CASE("fixed_size_pool_test.deallocate_during_thread_exit", "[fixed_size_pool_test]") {
+        using pool = fixed_size_pool<48u, 8u>;
+
+        struct deallocate_on_exit {
+            void* block = nullptr;
+            ~deallocate_on_exit() {
+                pool::deallocate(block);
+            }
+        };
+
+        void* block = nullptr;
+        std::thread([&]() {
+            // constructed before the pool's thread local state, so it is destroyed after it
+            static thread_local deallocate_on_exit holder;
+            holder.block = pool::allocate();
+            block = holder.block;
+        }).join();
+
+        // the block freed after the other thread's free list was released went straight to the shared list
+        void* reused = pool::allocate();
+        CHECK(reused == block);
+        pool::deallocate(reused);
+    }
+}
@@ -19,6 +19,7 @@
 
 #include <array>
 #include <atomic>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -79,4 +80,44 @@ namespace kdl {
 
         CHECK(expected == kdl::vec_parallel_transform(input, [](int i){ return std::to_string(i); }));
     }
+
+    TEST_CASE("for nested", "[parallel_test]") {
+        constexpr size_t OuterSize = 100;
+        constexpr size_t InnerSize = 100;
+
+        std::atomic<size_t> sum(0);
+        kdl::parallel_for(OuterSize, [&](const size_t) {
+            kdl::parallel_for(InnerSize, [&](const size_t i) {
+                sum += i;
+            });
+        });
+
+        CHECK(sum == OuterSize * (InnerSize * (InnerSize - 1) / 2));
+    }
+
+    TEST_CASE("for with min chunk size", "[parallel_test]") {
+        kdl::thread_pool pool(3);
+
+        std::array<std::atomic<size_t>, 1000> counts;
+        for (auto& count : counts) {
+            count = 0;
+        }
+
+        kdl::parallel_for(pool, counts.size(), [&](const size_t i) { ++counts[i]; }, 64);
+
+        for (const auto& count : counts) {
+            CHECK(count == 1u);
+        }
+    }
+
+    TEST_CASE("for rethrows exception", "[parallel_test]") {
+        std::atomic<size_t> count(0);
+        CHECK_THROWS_AS(kdl::parallel_for(1000, [&](const size_t i) {
+            ++count;
+            if (i == 500) {
+                throw std::runtime_error("error");
+            }
+        }), std::runtime_error);
+        CHECK(count > 0u);
+    }
 }
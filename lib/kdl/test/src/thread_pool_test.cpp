@@ -0,0 +1,94 @@
+/*
+ Copyright 2021 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kdl/thread_pool.h"
+
+#include <atomic>
+#include <thread>
+
+#include <catch2/catch.hpp>
+
+namespace kdl {
+    TEST_CASE("thread_pool_test.thread_count", "[thread_pool_test]") {
+        CHECK(thread_pool(0).thread_count() == 0u);
+        CHECK(thread_pool(3).thread_count() == 3u);
+    }
+
+    TEST_CASE("thread_pool_test.submit_without_threads", "[thread_pool_test]") {
+        thread_pool pool(0);
+
+        bool ran = false;
+        pool.submit([&]() { ran = true; });
+        CHECK(ran);
+        CHECK_FALSE(pool.run_pending_task());
+    }
+
+    TEST_CASE("thread_pool_test.submit", "[thread_pool_test]") {
+        thread_pool pool(4);
+
+        constexpr size_t TaskCount = 1000;
+        std::atomic<size_t> remaining(TaskCount);
+        std::atomic<size_t> sum(0);
+
+        for (size_t i = 0; i < TaskCount; ++i) {
+            pool.submit([&, i]() {
+                sum += i;
+                --remaining;
+            });
+        }
+
+        pool.wait_until_zero(remaining);
+        CHECK(sum == TaskCount * (TaskCount - 1) / 2);
+    }
+
+    TEST_CASE("thread_pool_test.submit_nested", "[thread_pool_test]") {
+        thread_pool pool(2);
+
+        constexpr size_t OuterCount = 16;
+        constexpr size_t InnerCount = 16;
+        std::atomic<size_t> outerRemaining(OuterCount);
+        std::atomic<size_t> innerCount(0);
+
+        for (size_t i = 0; i < OuterCount; ++i) {
+            pool.submit([&]() {
+                std::atomic<size_t> innerRemaining(InnerCount);
+                for (size_t j = 0; j < InnerCount; ++j) {
+                    pool.submit([&]() {
+                        ++innerCount;
+                        --innerRemaining;
+                    });
+                }
+                pool.wait_until_zero(innerRemaining);
+                --outerRemaining;
+            });
+        }
+
+        pool.wait_until_zero(outerRemaining);
+        CHECK(innerCount == OuterCount * InnerCount);
+    }
+
+    TEST_CASE("thread_pool_test.destructor_runs_pending_tasks", "[thread_pool_test]") {
+        std::atomic<size_t> count(0);
+        {
+            thread_pool pool(2);
+            for (size_t i = 0; i < 100; ++i) {
+                pool.submit([&]() { ++count; });
+            }
+        }
+        CHECK(count == 100u);
+    }
+}